@@ -1108,6 +1108,11 @@ bool FGAIAircraft::handleAirportEndPoints(FGAIWaypoint* prev, time_t now)
             fp->incrementLeg();
         }
     }
+    // the arrival ground network is needed after landing: load it in the
+    // background while there is time
+    if (fp->getLeg() >= AILeg::CRUISE) {
+        arr->prefetchGroundNetwork();
+    }
     if (prev->contains("DepartureHold"s)) {
         //std::cerr << "Passing point DepartureHold" << std::endl;
         scheduleForATCTowerRunwayControl();
@@ -28,6 +28,7 @@
 #include <Airports/runways.hxx>
 #include <Airports/pavement.hxx>
 #include <Airports/xmlloader.hxx>
+#include <Airports/groundnetloader.hxx>
 #include <Airports/dynamics.hxx>
 #include <Airports/airportdynamicsmanager.hxx>
 #include <Navaids/procedure.hxx>
@@ -1052,6 +1053,12 @@ FGAirportDynamicsRef FGAirport::getDynamics() const
 
 FGGroundNetwork *FGAirport::groundNetwork() const
 {
+    if (_groundNetworkLoader) {
+        // blocks if the worker is busy with this airport
+        _groundNetwork = _groundNetworkLoader->take();
+        _groundNetworkLoader.reset();
+    }
+
     if (!_groundNetwork.get()) {
         _groundNetwork.reset(new FGGroundNetwork(const_cast<FGAirport*>(this)));
         XMLLoader::load(_groundNetwork.get());
@@ -1061,6 +1068,19 @@ FGGroundNetwork *FGAirport::groundNetwork() const
     return _groundNetwork.get();
 }
 
+bool FGAirport::prefetchGroundNetwork() const
+{
+    if (_groundNetwork) {
+        return true;
+    }
+
+    if (!_groundNetworkLoader) {
+        _groundNetworkLoader.reset(new flightgear::GroundNetLoader(const_cast<FGAirport*>(this)));
+    }
+
+    return _groundNetworkLoader->isReady();
+}
+
 flightgear::Transition* FGAirport::selectSIDByEnrouteTransition(FGPositioned* enroute) const
 {
     loadProcedures();
@@ -24,6 +24,10 @@
 
 class FGGroundNetwork;
 
+namespace flightgear {
+class GroundNetLoader;
+}
+
 
 /***************************************************************************************
  *
@@ -94,6 +98,13 @@ public:
 
     FGGroundNetwork* groundNetwork() const;
 
+    /**
+     * Start loading the ground network on a worker thread, unless it is
+     * already loaded or loading. Returns true once groundNetwork() will not
+     * block; callers can poll this before they need the network.
+     */
+    bool prefetchGroundNetwork() const;
+
     unsigned int numRunways() const;
     unsigned int numHelipads() const;
     FGRunwayRef getRunwayByIndex(unsigned int aIndex) const;
@@ -399,6 +410,7 @@ private:
     std::vector<ApproachRef> mApproaches;
 
     mutable std::unique_ptr<FGGroundNetwork> _groundNetwork;
+    mutable std::unique_ptr<flightgear::GroundNetLoader> _groundNetworkLoader;
 
     using RunwayRenameMap = std::map<std::string, std::string>;
     // map from new name (eg in Navigraph) to old name (in apt.dat)
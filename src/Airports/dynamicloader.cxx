@@ -236,6 +236,10 @@ void FGGroundNetXMLLoader::startArc(const XMLAttributes& atts)
 
 void FGGroundNetXMLLoader::startElement(const char* name, const XMLAttributes& atts)
 {
+    if (_cancel && *_cancel) {
+        return;
+    }
+
     if (!strcmp("Parking", name)) {
         startParking(atts);
     } else if (!strcmp("node", name)) {
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <set>
 
 #include <simgear/xml/easyxml.hxx>
@@ -20,6 +21,12 @@ public:
         return _hasErrors;
     }
 
+    /// once *cancel is set, the rest of the file is skipped
+    void setCancelFlag(const std::atomic<bool>* cancel)
+    {
+        _cancel = cancel;
+    }
+
 protected:
     virtual void startXML();
     virtual void endXML();
@@ -40,6 +47,8 @@ private:
     // we set this flag if the ground-network has any problems
     bool _hasErrors = false;
 
+    const std::atomic<bool>* _cancel = nullptr;
+
     std::string value;
 
     // map from local (groundnet.xml) ids to parking instances
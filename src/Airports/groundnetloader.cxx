@@ -0,0 +1,523 @@
+// groundnetloader.cxx - background loading and caching of ground networks
+//
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "config.h"
+
+#include "groundnetloader.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+#include <simgear/debug/logstream.hxx>
+#include <simgear/io/iostreams/sgstream.hxx>
+#include <simgear/misc/strutils.hxx>
+#include <simgear/threads/SGThread.hxx>
+
+#include <Main/fg_props.hxx>
+#include <Main/globals.hxx>
+#include <Main/sentryIntegration.hxx>
+
+#include "airport.hxx"
+#include "groundnetwork.hxx"
+#include "xmlloader.hxx"
+
+namespace flightgear
+{
+
+namespace {
+
+// bump when the layout below changes
+const uint32_t cacheFormat = 1;
+const char cacheMagic[4] = {'F', 'G', 'G', 'N'};
+
+// sanity limit on any count or string read back, against corrupt files
+const uint32_t maxCount = 1u << 22;
+
+template <typename T>
+void writeValue(std::ostream& out, const T& v)
+{
+    out.write(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+void writeString(std::ostream& out, const std::string& s)
+{
+    writeValue<uint32_t>(out, s.size());
+    out.write(s.data(), s.size());
+}
+
+void writeInts(std::ostream& out, const intVec& v)
+{
+    writeValue<uint32_t>(out, v.size());
+    for (int i : v) {
+        writeValue<int32_t>(out, i);
+    }
+}
+
+template <typename T>
+T readValue(std::istream& in)
+{
+    T v{};
+    in.read(reinterpret_cast<char*>(&v), sizeof(T));
+    return v;
+}
+
+uint32_t readCount(std::istream& in)
+{
+    const auto n = readValue<uint32_t>(in);
+    if (n > maxCount) {
+        in.setstate(std::ios::failbit);
+        return 0;
+    }
+    return n;
+}
+
+std::string readString(std::istream& in)
+{
+    std::string s(readCount(in), '\0');
+    in.read(&s[0], s.size());
+    return s;
+}
+
+intVec readInts(std::istream& in)
+{
+    intVec v(readCount(in));
+    for (auto& i : v) {
+        i = readValue<int32_t>(in);
+    }
+    return v;
+}
+
+SGPath cachePath(const SGPath& dir, const std::string& key)
+{
+    return dir / (key + ".bin");
+}
+
+} // namespace
+
+SGPath GroundNetCache::directory()
+{
+    if (!fgGetBool("/sim/airport/groundnet-cache", true)) {
+        return {};
+    }
+
+    return globals->get_fg_home() / "cache" / "groundnet";
+}
+
+std::string GroundNetCache::key(const SGPath& xml)
+{
+    sg_ifstream in(xml, std::ios::in | std::ios::binary);
+    if (!in) {
+        return {};
+    }
+
+    std::ostringstream content;
+    content << in.rdbuf();
+    return simgear::strutils::md5(content.str());
+}
+
+// Layout: the nodes of the network (m_nodes first, then push-back points
+// which are not part of it) as a table, with parkings and segments
+// referring to their position in it.
+void GroundNetCache::write(const FGGroundNetwork* net, const SGPath& dir,
+                           const std::string& key, bool hasErrors)
+{
+    std::vector<FGTaxiNode*> table;
+    std::map<const FGTaxiNode*, uint32_t> position;
+    auto addNode = [&](FGTaxiNode* node) {
+        if (node && position.find(node) == position.end()) {
+            position[node] = table.size();
+            table.push_back(node);
+        }
+    };
+
+    for (const auto& node : net->m_nodes) {
+        addNode(node.get());
+    }
+    const uint32_t numListed = table.size();
+    for (const auto& park : net->m_parkings) {
+        addNode(park->getPushBackPoint().get());
+    }
+
+    // write and rename, so a reader never sees a partial file
+    SGPath path = cachePath(dir, key);
+    path.create_dir(0755); // creates the parent directories
+    SGPath tmp = path;
+    tmp.concat(".tmp");
+    {
+        sg_ofstream out(tmp, std::ios::out | std::ios::binary | std::ios::trunc);
+        out.write(cacheMagic, sizeof(cacheMagic));
+        writeValue(out, cacheFormat);
+        writeString(out, key);
+        writeValue<uint8_t>(out, hasErrors);
+        writeValue<int32_t>(out, net->version);
+        for (const auto* freqs : {&net->freqAwos, &net->freqUnicom, &net->freqClearance,
+                                  &net->freqGround, &net->freqTower, &net->freqApproach}) {
+            writeInts(out, *freqs);
+        }
+
+        writeValue<uint32_t>(out, table.size());
+        writeValue<uint32_t>(out, numListed);
+        for (FGTaxiNode* node : table) {
+            const bool isParking = node->type() == FGPositioned::PARKING;
+            writeValue<uint8_t>(out, isParking);
+            writeValue<int32_t>(out, node->getIndex());
+            writeValue<double>(out, node->geod().getLongitudeRad());
+            writeValue<double>(out, node->geod().getLatitudeRad());
+            writeValue<uint8_t>(out, node->getIsOnRunway());
+            writeValue<int32_t>(out, node->getHoldPointType());
+            writeString(out, node->ident());
+            if (isParking) {
+                auto park = static_cast<FGParking*>(node);
+                writeValue<double>(out, park->getHeading());
+                writeValue<double>(out, park->getRadius());
+                writeString(out, park->getType());
+                writeString(out, park->getCodes());
+                FGTaxiNodeRef pushBack = park->getPushBackPoint();
+                writeValue<int32_t>(out, pushBack ? static_cast<int32_t>(position[pushBack.get()]) : -1);
+            }
+        }
+
+        writeValue<uint32_t>(out, net->m_parkings.size());
+        for (const auto& park : net->m_parkings) {
+            writeValue<uint32_t>(out, position[park.get()]);
+        }
+
+        writeValue<uint32_t>(out, net->segments.size());
+        for (const FGTaxiSegment* seg : net->segments) {
+            writeValue<uint32_t>(out, position[seg->getStart().get()]);
+            writeValue<uint32_t>(out, position[seg->getEnd().get()]);
+        }
+
+        if (!out) {
+            SG_LOG(SG_NAVAID, SG_WARN, "failed to write groundnet cache " << tmp);
+            return;
+        }
+    }
+
+    if (!tmp.rename(path)) {
+        SG_LOG(SG_NAVAID, SG_WARN, "failed to write groundnet cache " << path);
+        tmp.remove();
+    }
+}
+
+bool GroundNetCache::read(FGGroundNetwork* net, const SGPath& dir,
+                          const std::string& key, bool& hasErrors)
+{
+    const SGPath path = cachePath(dir, key);
+    if (!path.exists()) {
+        return false;
+    }
+
+    sg_ifstream in(path, std::ios::in | std::ios::binary);
+    char magic[sizeof(cacheMagic)] = {};
+    in.read(magic, sizeof(magic));
+    if (!in || memcmp(magic, cacheMagic, sizeof(magic)) ||
+        (readValue<uint32_t>(in) != cacheFormat) || (readString(in) != key)) {
+        SG_LOG(SG_NAVAID, SG_INFO, "ignoring stale groundnet cache " << path);
+        return false;
+    }
+
+    const bool errors = readValue<uint8_t>(in) != 0;
+    const int version = readValue<int32_t>(in);
+    intVec freqs[6];
+    for (auto& f : freqs) {
+        f = readInts(in);
+    }
+
+    const uint32_t numNodes = readCount(in);
+    const uint32_t numListed = readValue<uint32_t>(in);
+    if (numListed > numNodes) {
+        in.setstate(std::ios::failbit);
+    }
+
+    // push-back points may come later in the table, so they are bound last
+    FGTaxiNodeVector table;
+    std::vector<std::pair<FGParking*, int32_t>> pushBacks;
+    for (uint32_t i = 0; in && (i < numNodes); ++i) {
+        const bool isParking = readValue<uint8_t>(in) != 0;
+        const int index = readValue<int32_t>(in);
+        const double lon = readValue<double>(in);
+        const double lat = readValue<double>(in);
+        const bool onRunway = readValue<uint8_t>(in) != 0;
+        const int holdType = readValue<int32_t>(in);
+        const std::string ident = readString(in);
+        const SGGeod pos = SGGeod::fromRad(lon, lat);
+
+        if (isParking) {
+            const double heading = readValue<double>(in);
+            const double radius = readValue<double>(in);
+            const std::string type = readString(in);
+            const std::string codes = readString(in);
+            const int32_t pushBack = readValue<int32_t>(in);
+            FGParkingRef park(new FGParking(index, pos, heading, radius, ident, type, codes));
+            pushBacks.emplace_back(park.get(), pushBack);
+            table.push_back(park);
+        } else {
+            table.push_back(FGTaxiNodeRef(new FGTaxiNode(FGPositioned::TAXI_NODE, index, pos, onRunway, holdType, ident)));
+        }
+    }
+
+    for (const auto& p : pushBacks) {
+        if (p.second >= static_cast<int32_t>(table.size())) {
+            in.setstate(std::ios::failbit);
+        } else if (p.second >= 0) {
+            p.first->setPushBackPoint(table[p.second]);
+        }
+    }
+
+    FGParkingList parkings(readCount(in));
+    for (auto& park : parkings) {
+        const auto i = readValue<uint32_t>(in);
+        if (!in || (i >= table.size()) || (table[i]->type() != FGPositioned::PARKING)) {
+            in.setstate(std::ios::failbit);
+            break;
+        }
+        park = FGParkingRef(static_cast<FGParking*>(table[i].get()));
+    }
+
+    FGTaxiSegmentVector segments;
+    const uint32_t numSegments = readCount(in);
+    for (uint32_t s = 0; in && (s < numSegments); ++s) {
+        const auto from = readValue<uint32_t>(in);
+        const auto to = readValue<uint32_t>(in);
+        if (!in || (from >= table.size()) || (to >= table.size())) {
+            in.setstate(std::ios::failbit);
+            break;
+        }
+        segments.push_back(new FGTaxiSegment(table[from].get(), table[to].get()));
+    }
+
+    if (!in) {
+        SG_LOG(SG_NAVAID, SG_WARN, "ignoring corrupt groundnet cache " << path);
+        for (auto seg : segments) {
+            delete seg;
+        }
+        return false;
+    }
+
+    table.resize(numListed);
+    net->version = version;
+    net->freqAwos = freqs[0];
+    net->freqUnicom = freqs[1];
+    net->freqClearance = freqs[2];
+    net->freqGround = freqs[3];
+    net->freqTower = freqs[4];
+    net->freqApproach = freqs[5];
+    net->m_nodes = std::move(table);
+    net->m_parkings = std::move(parkings);
+    net->segments = std::move(segments);
+    hasErrors = errors;
+    return true;
+}
+
+struct GroundNetLoader::Job {
+    FGAirport* apt;
+    std::string ident;
+    SGPath path;
+    bool found = false;
+    SGPath cacheDir;
+    FGRunwayList runways;
+
+    std::atomic<bool> cancel{false};
+
+    // set by run()
+    std::unique_ptr<FGGroundNetwork> net;
+    bool hasErrors = false;
+
+    // guarded by the worker's mutex
+    bool done = false;
+
+    void run()
+    {
+        if (cancel) {
+            return;
+        }
+
+        std::unique_ptr<FGGroundNetwork> result(new FGGroundNetwork(apt));
+        if (found) {
+            SG_LOG(SG_NAVAID, SG_DEBUG, "reading groundnet data from " << path << " in the background");
+            XMLLoader::parseGroundNetwork(result.get(), path, cacheDir, hasErrors, &cancel);
+        }
+
+        if (cancel) {
+            return;
+        }
+
+        result->init(runways);
+        net = std::move(result);
+    }
+};
+
+class GroundNetLoader::Worker : public SGThread
+{
+public:
+    // main thread only
+    static std::shared_ptr<Worker> instance()
+    {
+        static std::weak_ptr<Worker> current;
+
+        auto worker = current.lock();
+        if (!worker) {
+            worker.reset(new Worker);
+            current = worker;
+        }
+        return worker;
+    }
+
+    ~Worker()
+    {
+        {
+            std::lock_guard<std::mutex> g(_mutex);
+            _stop = true;
+            _queue.clear();
+        }
+        _condition.notify_all();
+        join();
+    }
+
+    void add(const std::shared_ptr<Job>& job)
+    {
+        {
+            std::lock_guard<std::mutex> g(_mutex);
+            _queue.push_back(job);
+        }
+        _condition.notify_all();
+    }
+
+    /// take job off the queue; false if the worker has already started it
+    bool remove(const std::shared_ptr<Job>& job)
+    {
+        std::lock_guard<std::mutex> g(_mutex);
+        auto it = std::find(_queue.begin(), _queue.end(), job);
+        if (it == _queue.end()) {
+            return false;
+        }
+
+        _queue.erase(it);
+        return true;
+    }
+
+    bool isDone(const std::shared_ptr<Job>& job)
+    {
+        std::lock_guard<std::mutex> g(_mutex);
+        return job->done;
+    }
+
+    void wait(const std::shared_ptr<Job>& job)
+    {
+        std::unique_lock<std::mutex> g(_mutex);
+        _condition.wait(g, [&job]() { return job->done; });
+    }
+
+protected:
+    void run() override
+    {
+        for (;;) {
+            std::shared_ptr<Job> job;
+            {
+                std::unique_lock<std::mutex> g(_mutex);
+                _condition.wait(g, [this]() { return _stop || !_queue.empty(); });
+                if (_stop) {
+                    return;
+                }
+
+                job = _queue.front();
+                _queue.pop_front();
+            }
+
+            job->run();
+
+            {
+                std::lock_guard<std::mutex> g(_mutex);
+                job->done = true;
+            }
+            _condition.notify_all();
+        }
+    }
+
+private:
+    Worker()
+    {
+        start();
+    }
+
+    std::mutex _mutex;
+    // signalled when a job is queued or done
+    std::condition_variable _condition;
+    std::deque<std::shared_ptr<Job>> _queue;
+    bool _stop = false;
+};
+
+GroundNetLoader::GroundNetLoader(FGAirport* apt) : _worker(Worker::instance()),
+                                                    _job(std::make_shared<Job>())
+{
+    _job->apt = apt;
+    _job->ident = apt->ident();
+    _job->found = XMLLoader::findAirportData(_job->ident, "groundnet", _job->path);
+    _job->cacheDir = GroundNetCache::directory();
+    _job->runways = apt->getRunwaysWithoutReciprocals();
+    _worker->add(_job);
+}
+
+GroundNetLoader::GroundNetLoader(FGAirport* apt, const SGPath& xml) : _worker(Worker::instance()),
+                                                                      _job(std::make_shared<Job>())
+{
+    _job->apt = apt;
+    _job->ident = apt->ident();
+    _job->path = xml;
+    _job->found = xml.exists();
+    _job->cacheDir = GroundNetCache::directory();
+    _job->runways = apt->getRunwaysWithoutReciprocals();
+    _worker->add(_job);
+}
+
+GroundNetLoader::~GroundNetLoader()
+{
+    if (!_job) {
+        return;
+    }
+
+    _job->cancel = true;
+    if (!_worker->remove(_job)) {
+        _worker->wait(_job);
+    }
+}
+
+bool GroundNetLoader::isReady() const
+{
+    return !_job || _worker->isDone(_job);
+}
+
+std::unique_ptr<FGGroundNetwork> GroundNetLoader::take()
+{
+    if (!_job) {
+        return {};
+    }
+
+    // needed now: don't wait behind the airports queued before this one
+    if (_worker->remove(_job)) {
+        _job->run();
+    } else {
+        _worker->wait(_job);
+    }
+
+    std::shared_ptr<Job> job = std::move(_job);
+    _worker.reset();
+    if (job->hasErrors && fgGetBool("/sim/terrasync/enabled")) {
+        flightgear::updateSentryTag("ground-net", job->ident);
+        flightgear::sentryReportException("Ground-net load error", job->path.utf8Str());
+    }
+
+    return std::move(job->net);
+}
+
+} // namespace flightgear
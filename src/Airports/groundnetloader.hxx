@@ -0,0 +1,88 @@
+// groundnetloader.hxx - background loading and caching of ground networks
+//
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <simgear/misc/sg_path.hxx>
+
+#include "airports_fwd.hxx"
+
+class FGGroundNetwork;
+
+namespace flightgear
+{
+
+/**
+ * Parsed ground networks stored in a compact binary form, keyed on the MD5
+ * of the groundnet XML they were read from, so an edited or updated file is
+ * parsed again. Reading and writing touch neither the property tree nor the
+ * navdata cache.
+ */
+class GroundNetCache
+{
+public:
+    /// $FG_HOME/cache/groundnet, or an empty path if
+    /// /sim/airport/groundnet-cache is false. Main thread only.
+    static SGPath directory();
+
+    /// The key for the groundnet XML file at path, or an empty string if it
+    /// can't be read.
+    static std::string key(const SGPath& xml);
+
+    /**
+     * Fill net, which must be empty, from the cache. Returns false if there
+     * is no valid entry for key; net is then left untouched.
+     */
+    static bool read(FGGroundNetwork* net, const SGPath& dir,
+                     const std::string& key, bool& hasErrors);
+
+    static void write(const FGGroundNetwork* net, const SGPath& dir,
+                      const std::string& key, bool hasErrors);
+};
+
+/**
+ * Loads the ground network of one airport in the background: the XML parse
+ * (or cache read) and the runway intersection pass of
+ * FGGroundNetwork::init(). Everything that needs the navdata cache or the
+ * property tree (finding the file, the runways) is done by the constructor,
+ * on the main thread.
+ *
+ * All loaders share a single worker thread, which takes them in the order
+ * they were created, and exits once the last loader is gone.
+ */
+class GroundNetLoader
+{
+public:
+    explicit GroundNetLoader(FGAirport* apt);
+
+    /// load from xml instead of the airport's own groundnet file
+    GroundNetLoader(FGAirport* apt, const SGPath& xml);
+
+    /// cancels the load, waiting for the worker if it already started it
+    ~GroundNetLoader();
+
+    /// true once take() will return without blocking
+    bool isReady() const;
+
+    /**
+     * Hand over the initialised network. If the worker has not started on
+     * it yet, the load is done right here rather than after the ones queued
+     * before it; otherwise this waits for the worker. Returns nullptr on a
+     * second call.
+     */
+    std::unique_ptr<FGGroundNetwork> take();
+
+private:
+    struct Job;
+    class Worker;
+
+    std::shared_ptr<Worker> _worker;
+    std::shared_ptr<Job> _job;
+};
+
+} // namespace flightgear
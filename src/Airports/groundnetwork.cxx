@@ -185,6 +185,11 @@ FGGroundNetwork::~FGGroundNetwork()
  */
 
 void FGGroundNetwork::init()
+{
+    init(parent->getRunwaysWithoutReciprocals());
+}
+
+void FGGroundNetwork::init(const FGRunwayList& rwys)
 {
     if (networkInitialized) {
         SG_LOG(SG_GENERAL, SG_WARN, "duplicate ground-network init");
@@ -194,7 +199,6 @@ void FGGroundNetwork::init()
     hasNetwork = true;
     int index = 1;
 
-    auto rwys = parent->getRunwaysWithoutReciprocals();
     // establish pairing of segments
     for (auto segment : segments) {
         //TODO Add Scanning for possible hold points
@@ -18,6 +18,10 @@
 
 class FGAirportDynamicsXMLLoader;
 
+namespace flightgear {
+class GroundNetCache;
+}
+
 typedef std::vector<int> intVec;
 typedef std::vector<int>::iterator intVecIterator;
 
@@ -217,6 +221,7 @@ class FGGroundNetwork
 {
 private:
     friend class FGGroundNetXMLLoader;
+    friend class flightgear::GroundNetCache;
 
     bool hasNetwork;
     bool networkInitialized;
@@ -278,6 +283,12 @@ public:
     int getVersion() const { return version; }
 
     void init();
+    /**
+     * As init(), with the airport's runways (without reciprocals) looked up
+     * by the caller: this version does not touch the navdata cache, so it can
+     * run on a worker thread.
+     */
+    void init(const FGRunwayList& runways);
     bool exists()
     {
         return hasNetwork;
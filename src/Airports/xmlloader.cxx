@@ -16,6 +16,7 @@
 
 #include "xmlloader.hxx"
 #include "dynamicloader.hxx"
+#include "groundnetloader.hxx"
 #include "runwayprefloader.hxx"
 
 #include "dynamics.hxx"
@@ -40,19 +41,50 @@ void XMLLoader::load(FGGroundNetwork* net)
   SG_LOG(SG_NAVAID, SG_DEBUG, "reading groundnet data from " << path);
   SGTimeStamp t;
   t.stamp();
+  bool hasErrors = false;
+  parseGroundNetwork(net, path, flightgear::GroundNetCache::directory(), hasErrors);
+  if (hasErrors && fgGetBool("/sim/terrasync/enabled")) {
+      flightgear::updateSentryTag("ground-net", net->airport()->ident());
+      flightgear::sentryReportException("Ground-net load error", path.utf8Str());
+  }
+
+  SG_LOG(SG_NAVAID, SG_DEBUG, "parsing groundnet XML took " << t.elapsedMSec());
+}
+
+bool XMLLoader::parseGroundNetwork(FGGroundNetwork* net, const SGPath& path,
+                                   const SGPath& cacheDir, bool& hasErrors,
+                                   const std::atomic<bool>* cancel)
+{
+  using flightgear::GroundNetCache;
+
+  hasErrors = false;
+  string key;
+  if (!cacheDir.isNull()) {
+      key = GroundNetCache::key(path);
+      if (!key.empty() && GroundNetCache::read(net, cacheDir, key, hasErrors)) {
+          SG_LOG(SG_NAVAID, SG_DEBUG, "read groundnet data for " << path << " from the cache");
+          return true;
+      }
+  }
+
   try {
       FGGroundNetXMLLoader visitor(net);
+      visitor.setCancelFlag(cancel);
       readXML(path, visitor);
-
-      if (visitor.hasErrors() && fgGetBool("/sim/terrasync/enabled")) {
-          flightgear::updateSentryTag("ground-net", net->airport()->ident());
-          flightgear::sentryReportException("Ground-net load error", path.utf8Str());
-      }
+      hasErrors = visitor.hasErrors();
   } catch (sg_exception& e) {
     SG_LOG(SG_NAVAID, SG_DEV_WARN, "parsing groundnet XML failed:" << e.getFormattedMessage());
+    return false;
   }
 
-  SG_LOG(SG_NAVAID, SG_DEBUG, "parsing groundnet XML took " << t.elapsedMSec());
+  if (cancel && *cancel) {
+      return false;
+  }
+
+  if (!key.empty()) {
+      GroundNetCache::write(net, cacheDir, key, hasErrors);
+  }
+  return true;
 }
 
 void XMLLoader::loadFromStream(FGGroundNetwork* net, std::istream& inData)
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "airports_fwd.hxx"
 
 class XMLVisitor; // ffrom easyxml.hxx
@@ -20,6 +22,19 @@ public:
   static void loadFromStream(FGGroundNetwork* net, std::istream& inData);
   static void loadFromPath(FGGroundNetwork* net, const SGPath& path);
 
+  /**
+   * Fill the ground network from the groundnet XML at path, or from the
+   * binary cache in cacheDir if it holds the same version of the file (an
+   * empty cacheDir disables the cache). Touches neither the property tree
+   * nor the navdata cache, so this can run on a worker thread; setting
+   * *cancel stops the parse. Returns false if the file could not be parsed or
+   * the parse was cancelled. hasErrors is set if the data has problems worth
+   * reporting.
+   */
+  static bool parseGroundNetwork(FGGroundNetwork* net, const SGPath& path,
+                                 const SGPath& cacheDir, bool& hasErrors,
+                                 const std::atomic<bool>* cancel = nullptr);
+
   /**
    * Search the scenery for a file name of the form:
    *   I/C/A/ICAO.filename.xml
@@ -5,8 +5,11 @@
  * SPDX-License-Identifier: GPL-2.0-or-later
  */
 
+#include <algorithm>
+#include <cstdint>
 #include <cstring>
 
+#include <osg/Image>
 #include <osgDB/ReadFile>
 
 #include <simgear/misc/sg_path.hxx>
@@ -45,17 +48,84 @@
 #define HOUR	(0.5/24.0)
 #define MONTH	(1.0/12.0)
 
-FGClimate::FGClimate()
+// The Köppen-Geiger map, decoded once per process: FGClimate is created again
+// on every reset, and reading the image takes far longer than the rest of it.
+class FGClimateMap
+{
+public:
+    struct Cell {
+        uint8_t code;		// Köppen-Geiger classification
+        uint8_t elevation;	// the green and blue channels
+        uint8_t precipitation;
+    };
+
+    static std::shared_ptr<const FGClimateMap> instance();
+
+    int width() const { return _width; }
+    int height() const { return _height; }
+
+    const Cell& cell(int s, int t) const {
+        s = std::min(std::max(s, 0), _width-1);
+        t = std::min(std::max(t, 0), _height-1);
+        return _cells[t*_width + s];
+    }
+
+    // a channel as osg::Image::getColor() returns it
+    static float channel(uint8_t value) { return value*(1.0f/255.0f); }
+
+private:
+    explicit FGClimateMap(const osg::Image& image);
+
+    int _width;
+    int _height;
+    std::vector<Cell> _cells;
+};
+
+std::shared_ptr<const FGClimateMap> FGClimateMap::instance()
 {
+    static SGPath path;
+    static std::shared_ptr<const FGClimateMap> map;
+
     SGPath img_path = globals->get_fg_root() / "Geodata" / "koppen-geiger.png";
+    if (img_path != path)
+    {
+        path = img_path;
+        osg::ref_ptr<osg::Image> image = osgDB::readImageFile(img_path.utf8Str());
+        map.reset(image ? new FGClimateMap(*image) : nullptr);
+    }
+    return map;
+}
+
+FGClimateMap::FGClimateMap(const osg::Image& image) :
+    _width(image.s()),
+    _height(image.t()),
+    _cells(static_cast<size_t>(_width)*_height)
+{
+    for (int t = 0; t < _height; ++t) {
+        for (int s = 0; s < _width; ++s)
+        {
+            osg::Vec4f color = image.getColor(s, t);
+            Cell& c = _cells[t*_width + s];
 
-    image = osgDB::readImageFile(img_path.utf8Str());
-    if (image)
+            int code = static_cast<int>(floorf(255.0f*color[0]/4.0f));
+            c.code = static_cast<uint8_t>(std::min(std::max(code, 0), 255));
+            c.elevation = static_cast<uint8_t>(lroundf(255.0f*color[1]));
+            c.precipitation = static_cast<uint8_t>(lroundf(255.0f*color[2]));
+        }
+    }
+}
+
+FGClimate::FGClimate()
+{
+    _map = FGClimateMap::instance();
+    if (_map)
     {
-        _image_width = static_cast<double>( image->s() );
-        _image_height = static_cast<double>( image->t() );
+        _image_width = static_cast<double>( _map->width() );
+        _image_height = static_cast<double>( _map->height() );
         _epsilon = 36.0/_image_width;
     }
+
+    build_seasonal();
 }
 
 void FGClimate::init()
@@ -172,8 +242,7 @@ void FGClimate::update(double dt)
         update_wind();
 
         _code = 0; // Ocean
-        osg::Vec4f color;
-        if (image)
+        if (_map)
         {
             // from lat/lon to screen coordinates
             double x = 180.0 + longitude_deg;
@@ -185,12 +254,12 @@ void FGClimate::update(double dt)
 
             int s = static_cast<int>(rxs);
             int t = static_cast<int>(ryt);
-            color = image->getColor(s, t);
+            const FGClimateMap::Cell& cell = _map->cell(s, t);
 
             // convert from color shades to koppen-classicfication
-            _elevation_m = _gl.elevation_m = 5600.0*color[1];
-            _gl.precipitation_annual = 150.0 + 9000.0*color[2];
-            _code = static_cast<int>(floorf(255.0f*color[0]/4.0f));
+            _elevation_m = _gl.elevation_m = 5600.0*FGClimateMap::channel(cell.elevation);
+            _gl.precipitation_annual = 150.0 + 9000.0*FGClimateMap::channel(cell.precipitation);
+            _code = cell.code;
             if (_code >= MAX_CLIMATE_CLASSES)
             {
                 SG_LOG(SG_ENVIRONMENT, SG_WARN, "Climate Koppen code exceeds the maximum");
@@ -367,26 +436,280 @@ void FGClimate::update_wind()
     if (_wind_direction < 0.0) _wind_direction += 360.0;
 }
 
+// The temperatures and monthly precipitation of a climate class at the time
+// of the year given by _seasons_year (and _season_summer, which follows from
+// it). These depend on nothing else, and are tabulated by build_seasonal().
+FGClimate::Seasonal FGClimate::seasonal_model(int code)
+{
+    double summer = _season_summer;
+    double winter = -summer;
+
+    Seasonal s;
+    switch(code)
+    {
+    case 0: // ocean, at the equator
+        s.temp_night = triangular(season(summer, MONTH), 17.5, 22.5);
+        s.temp_day = triangular(season(summer, MONTH), 27.5, 32.5);
+        s.temp_water = triangular(season(summer, 2.0*MONTH), 22.0, 27.5);
+        break;
+    case 1: // Af: equatorial, fully humid
+        s.temp_night = triangular(summer, 20.0, 22.5);
+        s.temp_day = triangular(summer, 29.5, 32.5);
+        s.temp_water = triangular(season(summer, MONTH), 25.0, 27.5);
+        s.precipitation = sinusoidal(season(winter), 150.0, 280.0);
+        break;
+    case 2: // Am: equatorial, monsoonal
+        s.temp_night = triangular(season(summer, MONTH), 17.5, 22.5);
+        s.temp_day = triangular(season(summer, MONTH), 27.5, 32.5);
+        s.temp_water = triangular(season(summer, MONTH), 22.0, 27.5);
+        s.precipitation = linear(season(summer, MONTH), 45.0, 340.0);
+        break;
+    case 3: // As: equatorial, summer dry
+        s.temp_night = long_high(season(summer, .15*MONTH), 15.0, 22.5);
+        s.temp_day = triangular(season(summer, MONTH), 27.5, 35.0);
+        s.temp_water = triangular(season(summer, 2.0*MONTH), 21.5, 26.5);
+        s.precipitation = sinusoidal(season(summer, 2.0*MONTH), 35.0, 150.0);
+        break;
+    case 4: // Aw: equatorial, winter dry
+        s.temp_night = long_high(season(summer, 1.5*MONTH), 15.0, 22.5);
+        s.temp_day = triangular(season(summer, 2.0*MONTH), 27.5, 35.0);
+        s.temp_water = triangular(season(summer, 2.0*MONTH), 21.5, 28.5);
+        s.precipitation = sinusoidal(season(summer, 2.0*MONTH), 10.0, 230.0);
+        break;
+    case 5: // BSh: arid, steppe, hot arid
+        s.temp_night = long_high(season(summer, MONTH), 10.0, 22.0);
+        s.temp_day = triangular(season(summer, 2.0*MONTH), 27.5, 35.0);
+        s.temp_water = triangular(season(summer, 2.5*MONTH), 18.5, 28.5);
+        s.precipitation = long_low(season(summer, 2.0*MONTH), 8.0, 117.0);
+        break;
+    case 6: // BSk: arid, steppe, cold arid
+        s.temp_night = sinusoidal(season(summer, MONTH), -14.0, 12.0);
+        s.temp_day = sinusoidal(season(summer, MONTH), 0.0, 30.0);
+        s.temp_water = sinusoidal(season(summer, 2.0*MONTH), 5.0, 25.5);
+        s.precipitation = sinusoidal(season(summer, MONTH), 15.0, 34.0);
+        break;
+    case 7: // BWh: arid, desert, hot arid
+        s.temp_night = sinusoidal(season(summer, 1.5*MONTH), 7.5, 22.0);
+        s.temp_day = even(season(summer, 1.5*MONTH), 22.5, 37.5);
+        s.temp_water = even(season(summer, 2.5*MONTH), 15.5, 33.5);
+        s.precipitation = monsoonal(season(summer, 2.0*MONTH), 3.0, 18.0);
+        break;
+    case 8: // BWk: arid, desert, cold arid
+        s.temp_night = sinusoidal(season(summer, MONTH), -15.0, 15.0);
+        s.temp_day = sinusoidal(season(summer, MONTH), -2.0, 30.0);
+        s.temp_water = sinusoidal(season(summer, 2.0*MONTH), 4.0, 26.5);
+        s.precipitation = linear(season(summer, MONTH), 4.0, 14.0);
+        break;
+    case 9: // Cfa: warm temperature, fully humid hot summer
+        s.temp_night = sinusoidal(season(summer, 1.5*MONTH), -3.0, 20.0);
+        s.temp_day = sinusoidal(season(summer, 1.5*MONTH), 10.0, 33.0);
+        s.temp_water = sinusoidal(season(summer, 2.5*MONTH), 8.0, 28.5);
+        s.precipitation = sinusoidal(summer, 60.0, 140.0);
+        break;
+    case 10: // Cfb: warm temperature, fully humid, warm summer
+        s.temp_night = sinusoidal(season(summer, 1.5*MONTH), -3.0, 10.0);
+        s.temp_day = sinusoidal(season(summer, 1.5*MONTH), 5.0, 25.0);
+        s.temp_water = sinusoidal(season(summer, 2.5*MONTH), 3.0, 20.5);
+        s.precipitation = sinusoidal(season(winter, 3.5*MONTH), 65.0, 90.0);
+        break;
+    case 11: // Cfc: warm temperature, fully humid, cool summer
+        s.temp_night = long_low(season(summer, 1.5*MONTH), -3.0, 8.0);
+        s.temp_day = long_low(season(summer, 1.5*MONTH), 2.0, 14.0);
+        s.temp_water = long_low(season(summer, 2.5*MONTH), 3.0, 11.5);
+        s.precipitation = linear(season(winter), 90.0, 200.0);
+        break;
+    case 12: // Csa: warm temperature, summer dry, hot summer
+        s.temp_night = sinusoidal(season(summer, MONTH), 2.0, 16.0);
+        s.temp_day = sinusoidal(season(summer, MONTH), 12.0, 33.0);
+        s.temp_water = sinusoidal(season(summer, 2.0*MONTH), 10.0, 27.5);
+        s.precipitation = linear(season(winter), 25.0, 70.0);
+        break;
+    case 13: // Csb: warm temperature, summer dry, warm summer
+        s.temp_night = linear(season(summer, 1.5*MONTH), -4.0, 10.0);
+        s.temp_day = linear(season(summer, 1.5*MONTH), 6.0, 27.0);
+        s.temp_water = linear(season(summer, 2.5*MONTH), 4.0, 21.5);
+        s.precipitation = linear(season(winter), 25.0, 120.0);
+        break;
+    case 14: // Csc: warm temperature, summer dry, cool summer
+        s.temp_night = sinusoidal(season(summer, 0.5*MONTH), -4.0, 5.0);
+        s.temp_day = sinusoidal(season(summer, 0.5*MONTH), 5.0, 16.0);
+        s.temp_water = sinusoidal(season(summer, 1.5*MONTH), 3.0, 14.5);
+        s.precipitation = sinusoidal(season(winter, -MONTH), 60.0, 95.0);
+        break;
+    case 15: // Cwa: warm temperature, winter dry, hot summer
+        s.temp_night = even(season(summer, MONTH), 4.0, 20.0);
+        s.temp_day = long_low(season(summer, MONTH), 15.0, 30.0);
+        s.temp_water = long_low(season(summer, 2.0*MONTH), 7.0, 24.5);
+        s.precipitation = long_low(season(summer, MONTH), 10.0, 320.0);
+        break;
+    case 16: // Cwb: warm temperature, winter dry, warm summer
+        s.temp_night = even(season(summer, MONTH), 1.0, 13.0);
+        s.temp_day = long_low(season(summer, MONTH), 15.0, 27.0);
+        s.temp_water = even(season(summer, 2.0*MONTH), 5.0, 22.5);
+        s.precipitation = long_low(season(summer, MONTH), 10.0, 250.0);
+        break;
+    case 17: // Cwc: warm temperature, winter dry, cool summer
+        s.temp_night = long_low(season(summer, MONTH), -9.0, 6.0);
+        s.temp_day = long_high(season(summer, MONTH), 6.0, 17.0);
+        s.temp_water = long_high(season(summer, 2.0*MONTH), 8.0, 15.5);
+        s.precipitation = long_low(season(summer, MONTH), 5.0, 200.0);
+        break;
+    case 18: // Dfa: snow, fully humid, hot summer
+        s.temp_night = sinusoidal(season(summer, MONTH), -15.0, 13.0);
+        s.temp_day = sinusoidal(season(summer, MONTH), -5.0, 30.0);
+        s.temp_water = sinusoidal(season(summer, 2.0*MONTH), 0.0, 26.5);
+        s.precipitation = linear(season(summer, MONTH), 30.0, 70.0);
+        break;
+    case 19: // Dfb: snow, fully humid, warm summer, warm summer
+        s.temp_night = sinusoidal(season(summer, MONTH), -17.5, 10.0);
+        s.temp_day = sinusoidal(season(summer, MONTH), -7.5, 25.0);
+        s.temp_water = sinusoidal(season(summer, 2.0*MONTH), -2.0, 22.5);
+        s.precipitation = linear(season(summer, MONTH), 30.0, 70.0);
+        break;
+    case 20: // Dfc: snow, fully humid, cool summer, cool summer
+        s.temp_night = sinusoidal(season(summer, MONTH), -30.0, 4.0);
+        s.temp_day = sinusoidal(season(summer, MONTH), -20.0, 15.0);
+        s.temp_water = sinusoidal(season(summer, 2.0*MONTH), -10.0, 12.5);
+        s.precipitation = linear(season(summer, 1.5*MONTH), 22.0, 68.0);
+        break;
+    case 21: // Dfd: snow, fully humid, extremely continental
+        s.temp_night = sinusoidal(season(summer, MONTH), -45.0, 4.0);
+        s.temp_day = sinusoidal(season(summer, MONTH), -35.0, 10.0);
+        s.temp_water = sinusoidal(season(summer, 2.0*MONTH), -15.0, 8.5);
+        s.precipitation = long_low(season(summer, 1.5*MONTH), 7.5, 45.0);
+        break;
+    case 22: // Dsa: snow, summer dry, hot summer
+        s.temp_night = sinusoidal(season(summer, 1.5*MONTH), -10.0, 10.0);
+        s.temp_day = sinusoidal(season(summer, 1.5*MONTH), 0.0, 30.0);
+        s.temp_water = sinusoidal(season(summer, 3.5*MONTH), 4.0, 24.5);
+        s.precipitation = long_high(season(winter, 2.0*MONTH), 5.0, 65.0);
+        break;
+    case 23: // Dsb: snow, summer dry, warm summer
+        s.temp_night = sinusoidal(season(summer, 1.5*MONTH), -15.0, 6.0);
+        s.temp_day = sinusoidal(season(summer, 1.5*MONTH), -4.0, 25.0);
+        s.temp_water = sinusoidal(season(summer, 2.5*MONTH), 0.0, 19.5);
+        s.precipitation = long_high(season(winter, 2.0*MONTH), 12.0, 65.0);
+        break;
+    case 24: // Dsc: snow, summer dry, cool summer
+        s.temp_night = sinusoidal(season(summer, MONTH), -27.5, 2.0);
+        s.temp_day = sinusoidal(season(summer, MONTH), -4.0, 15.0);
+        s.temp_water = sinusoidal(season(summer, 2.0*MONTH), 0.0, 12.5);
+        s.precipitation = long_low(season(summer, MONTH), 32.5, 45.0);
+        break;
+    case 25: // Dsd: snow, summer dry, extremely continental
+        s.temp_night = sinusoidal(season(summer, MONTH), -11.5, -6.5);
+        s.temp_day = sinusoidal(season(summer, MONTH), 14.0, 27.0);
+        s.temp_water = sinusoidal(season(summer, 2.0*MONTH), 8.0, 20.5);
+        s.precipitation = long_low(season(summer, MONTH), 5.0, 90.0);
+        break;
+    case 26: // Dwa: snow, winter dry, hot summer
+        s.temp_night = sinusoidal(season(summer, MONTH), -18.0, 16.5);
+        s.temp_day = sinusoidal(season(summer, MONTH), -5.0, 25.0);
+        s.temp_water = sinusoidal(season(summer, 2.0*MONTH), 0.0, 23.5);
+        s.precipitation = long_low(season(summer, 1.5*MONTH), 5.0, 180.0);
+        break;
+    case 27: // Dwb: snow, winter dry, warm summer
+        s.temp_night = sinusoidal(season(summer, MONTH), -28.0, 10.0);
+        s.temp_day = sinusoidal(season(summer, MONTH), -12.5, 22.5);
+        s.temp_water = sinusoidal(season(summer, 2.0*MONTH), -5.0, 18.5);
+        s.precipitation = long_low(season(summer, 1.5*MONTH), 10.0, 140.0);
+        break;
+    case 28: // Dwc: snow, winter dry, cool summer
+        s.temp_night = sinusoidal(season(summer, MONTH), -33.0, 5.0);
+        s.temp_day = sinusoidal(season(summer, MONTH), -20.0, 20.0);
+        s.temp_water = sinusoidal(season(summer, 2.0*MONTH), -10.0, 16.5);
+        s.precipitation = long_low(season(summer, 1.5*MONTH), 10.0, 110.0);
+        break;
+    case 29: // Dwd: snow, winter dry, extremely continental
+        s.temp_night = sinusoidal(season(summer, MONTH), -57.5, 0.0);
+        s.temp_day = sinusoidal(season(summer, MONTH), -43.0, 15.0);
+        s.temp_water = sinusoidal(season(summer, 2.0*MONTH), -28.0, 11.5);
+        s.precipitation = sinusoidal(season(summer, 1.5*MONTH), 8.0, 63.0);
+        break;
+    case 30: // EF: polar frost
+        s.temp_night = long_low(season(summer, MONTH), -35.0, -6.0);
+        s.temp_day = long_low(season(summer, MONTH), -32.5, 0.0);
+        s.temp_water = long_low(season(summer, 2.0*MONTH), -27.5, -3.5);
+        s.precipitation = linear(season(summer, 2.5*MONTH), 50.0, 80.0);
+        break;
+    case 31: // ET: polar tundra
+        s.temp_night = sinusoidal(season(summer, MONTH), -30.0, 0.0);
+        s.temp_day = sinusoidal(season(summer, 1.5*MONTH), -22.5, 8.0);
+        s.temp_water = sinusoidal(season(summer, 2.0*MONTH), -15.0, 5.0);
+        s.precipitation = sinusoidal(season(summer, 2.0*MONTH), 15.0, 45.0);
+        break;
+    case MAX_CLIMATE_CLASSES: // ocean, at the poles
+        s.temp_night = sinusoidal(season(summer, MONTH), -30.0, 0.0);
+        s.temp_day = sinusoidal(season(summer, 1.5*MONTH), -22.5, 4.0);
+        s.temp_water = long_low(season(summer, 2.0*MONTH), -27.5, -3.5);
+        break;
+    default:
+        break;
+    }
+
+    return s;
+}
+
+void FGClimate::build_seasonal()
+{
+    double seasons_year = _seasons_year;
+    double season_summer = _season_summer;
+
+    _seasonal.resize((MAX_CLIMATE_CLASSES+1)*(SEASON_STEPS+1));
+    for (int i = 0; i <= SEASON_STEPS; ++i)
+    {
+        // the inverse of update_season_factor()
+        _seasons_year = static_cast<double>(i)/SEASON_STEPS;
+        _season_summer = (_seasons_year > 0.5) ? 2.0*(1.0 - _seasons_year)
+                                                : 2.0*_seasons_year;
+        for (int code = 0; code <= MAX_CLIMATE_CLASSES; ++code) {
+            _seasonal[code*(SEASON_STEPS+1) + i] = seasonal_model(code);
+        }
+    }
+
+    _seasons_year = seasons_year;
+    _season_summer = season_summer;
+}
+
+// linear interpolation in the table at _seasons_year
+FGClimate::Seasonal FGClimate::seasonal(int code)
+{
+    double x = std::min(std::max(_seasons_year, 0.0), 1.0)*SEASON_STEPS;
+    int i = std::min(static_cast<int>(x), SEASON_STEPS-1);
+    double f = x - i;
+
+    const Seasonal& a = _seasonal[code*(SEASON_STEPS+1) + i];
+    const Seasonal& b = _seasonal[code*(SEASON_STEPS+1) + i + 1];
+
+    Seasonal s;
+    s.temp_night = linear(f, a.temp_night, b.temp_night);
+    s.temp_day = linear(f, a.temp_day, b.temp_day);
+    s.temp_water = linear(f, a.temp_water, b.temp_water);
+    s.precipitation = linear(f, a.precipitation, b.precipitation);
+    return s;
+}
+
 
 void FGClimate::set_ocean()
 {
     double day = _day_noon;
-    double summer = _season_summer;
 
     // temperature based on latitude, season and time of day
     // the equator
-    double temp_equator_night = triangular(season(summer, MONTH), 17.5, 22.5);
-    double temp_equator_day = triangular(season(summer, MONTH), 27.5, 32.5);
+    Seasonal equator = seasonal(0);
+    double temp_equator_night = equator.temp_night;
+    double temp_equator_day = equator.temp_day;
     double temp_equator_mean = linear(_day_light, temp_equator_night, temp_equator_day);
     double temp_equator = linear(daytime(day, 3.0*HOUR), temp_equator_night, temp_equator_day);
-    double temp_sw_Am = triangular(season(summer, 2.0*MONTH), 22.0, 27.5);
+    double temp_sw_Am = equator.temp_water;
 
     // the poles
-    double temp_pole_night = sinusoidal(season(summer, MONTH), -30.0, 0.0);
-    double temp_pole_day = sinusoidal(season(summer, 1.5*MONTH), -22.5, 4.0);
+    Seasonal pole = seasonal(MAX_CLIMATE_CLASSES);
+    double temp_pole_night = pole.temp_night;
+    double temp_pole_day = pole.temp_day;
     double temp_pole_mean = linear(_day_light, temp_pole_night, temp_pole_day);
     double temp_pole = linear(daytime(day, 3.0*HOUR), temp_pole_night, temp_pole_day);
-    double temp_sw_ET = long_low(season(summer, 2.0*MONTH), -27.5, -3.5);
+    double temp_sw_ET = pole.temp_water;
 
     // interpolate based on the viewers latitude
     double latitude_deg = _positionLatitudeNode->getDoubleValue();
@@ -424,41 +747,26 @@ void FGClimate::set_tropical()
     double fact_lat = std::max(abs(latitude_deg), 15.0)/15.0;
     double wind_speed = 3.0*fact_lat*fact_lat;
 
-    double temp_water = _gl.temperature_water;
-    double temp_night = _sl.temperature;
-    double temp_day = _sl.temperature;
-    double precipitation = _gl.precipitation;
+    Seasonal seasons = seasonal(_code);
+    double temp_water = seasons.temp_water;
+    double temp_night = seasons.temp_night;
+    double temp_day = seasons.temp_day;
+    double precipitation = seasons.precipitation;
     double relative_humidity = _gl.relative_humidity;
     switch(_code)
     {
     case 1: // Af: equatorial, fully humid
-        temp_night = triangular(summer, 20.0, 22.5);
-        temp_day = triangular(summer, 29.5, 32.5);
-        temp_water = triangular(season(summer, MONTH), 25.0, 27.5);
-        precipitation = sinusoidal(season(winter), 150.0, 280.0);
         relative_humidity = triangular(humidity, 75.0, 85.0);
         break;
     case 2: // Am: equatorial, monsoonal
-        temp_night = triangular(season(summer, MONTH), 17.5, 22.5);
-        temp_day = triangular(season(summer, MONTH), 27.5, 32.5);
-        temp_water = triangular(season(summer, MONTH), 22.0, 27.5);
-        precipitation = linear(season(summer, MONTH), 45.0, 340.0);
         relative_humidity = triangular(humidity, 75.0, 85.0);
         wind_speed *= 2.0*_gl.precipitation/340.0;
         break;
     case 3: // As: equatorial, summer dry
-        temp_night = long_high(season(summer, .15*MONTH), 15.0, 22.5);
-        temp_day = triangular(season(summer, MONTH), 27.5, 35.0);
-        temp_water = triangular(season(summer, 2.0*MONTH), 21.5, 26.5);
-        precipitation = sinusoidal(season(summer, 2.0*MONTH), 35.0, 150.0);
         relative_humidity = triangular(humidity, 60.0, 80.0);
         wind_speed *= 2.0*_gl.precipitation/150.0;
         break;
     case 4: // Aw: equatorial, winter dry
-        temp_night = long_high(season(summer, 1.5*MONTH), 15.0, 22.5);
-        temp_day = triangular(season(summer, 2.0*MONTH), 27.5, 35.0);
-        temp_water = triangular(season(summer, 2.0*MONTH), 21.5, 28.5);
-        precipitation = sinusoidal(season(summer, 2.0*MONTH), 10.0, 230.0);
         relative_humidity = triangular(humidity, 60.0, 80.0);
         wind_speed *= 2.0*_gl.precipitation/230.0;
         break;
@@ -490,39 +798,24 @@ void FGClimate::set_dry()
     double hmax = sinusoidal(season(winter), 0.86, 1.0);
     double humidity = linear(daytime(day, -9.0*HOUR), hmin, hmax);
 
-    double temp_water = _gl.temperature_water;
-    double temp_night = _sl.temperature;
-    double temp_day = _sl.temperature;
-    double precipitation = _gl.precipitation;
+    Seasonal seasons = seasonal(_code);
+    double temp_water = seasons.temp_water;
+    double temp_night = seasons.temp_night;
+    double temp_day = seasons.temp_day;
+    double precipitation = seasons.precipitation;
     double relative_humidity = _gl.relative_humidity;
     switch(_code)
     {
     case 5: // BSh: arid, steppe, hot arid
-        temp_night = long_high(season(summer, MONTH), 10.0, 22.0);
-        temp_day = triangular(season(summer, 2.0*MONTH), 27.5, 35.0);
-        temp_water = triangular(season(summer, 2.5*MONTH), 18.5, 28.5);
-        precipitation = long_low(season(summer, 2.0*MONTH), 8.0, 117.0);
         relative_humidity = triangular(humidity, 20.0, 30.0);
         break;
     case 6: // BSk: arid, steppe, cold arid
-        temp_night = sinusoidal(season(summer, MONTH), -14.0, 12.0);
-        temp_day = sinusoidal(season(summer, MONTH), 0.0, 30.0);
-        temp_water = sinusoidal(season(summer, 2.0*MONTH), 5.0, 25.5);
-        precipitation = sinusoidal(season(summer, MONTH), 15.0, 34.0);
         relative_humidity = sinusoidal(humidity, 48.0, 67.0);
         break;
     case 7: // BWh: arid, desert, hot arid
-        temp_night = sinusoidal(season(summer, 1.5*MONTH), 7.5, 22.0);
-        temp_day = even(season(summer, 1.5*MONTH), 22.5, 37.5);
-        temp_water = even(season(summer, 2.5*MONTH), 15.5, 33.5);
-        precipitation = monsoonal(season(summer, 2.0*MONTH), 3.0, 18.0);
         relative_humidity = monsoonal(humidity, 25.0, 55.0);
         break;
     case 8: // BWk: arid, desert, cold arid
-        temp_night = sinusoidal(season(summer, MONTH), -15.0, 15.0);
-        temp_day = sinusoidal(season(summer, MONTH), -2.0, 30.0);
-        temp_water = sinusoidal(season(summer, 2.0*MONTH), 4.0, 26.5);
-        precipitation = linear(season(summer, MONTH), 4.0, 14.0);
         relative_humidity = linear(humidity, 45.0, 61.0);
         break;
     default:
@@ -550,74 +843,39 @@ void FGClimate::set_temperate()
     double hmax = sinusoidal(season(winter), 0.86, 1.0);
     double humidity = linear(daytime(day, -9.0*HOUR), hmin, hmax);
 
-    double temp_water = _gl.temperature_water;
-    double temp_night = _sl.temperature;
-    double temp_day = _sl.temperature;
-    double precipitation = _gl.precipitation;
+    Seasonal seasons = seasonal(_code);
+    double temp_water = seasons.temp_water;
+    double temp_night = seasons.temp_night;
+    double temp_day = seasons.temp_day;
+    double precipitation = seasons.precipitation;
     double relative_humidity = _gl.relative_humidity;
     switch(_code)
     {
     case 9: // Cfa: warm temperature, fully humid hot summer
-        temp_night = sinusoidal(season(summer, 1.5*MONTH), -3.0, 20.0);
-        temp_day = sinusoidal(season(summer, 1.5*MONTH), 10.0, 33.0);
-        temp_water = sinusoidal(season(summer, 2.5*MONTH), 8.0, 28.5);
-        precipitation = sinusoidal(summer, 60.0, 140.0);
         relative_humidity = sinusoidal(humidity, 65.0, 80.0);
         break;
     case 10: // Cfb: warm temperature, fully humid, warm summer
-        temp_night = sinusoidal(season(summer, 1.5*MONTH), -3.0, 10.0);
-        temp_day = sinusoidal(season(summer, 1.5*MONTH), 5.0, 25.0);
-        temp_water = sinusoidal(season(summer, 2.5*MONTH), 3.0, 20.5);
-        precipitation = sinusoidal(season(winter, 3.5*MONTH), 65.0, 90.0);
         relative_humidity = sinusoidal(humidity, 68.0, 87.0);
         break;
     case 11: // Cfc: warm temperature, fully humid, cool summer
-        temp_night = long_low(season(summer, 1.5*MONTH), -3.0, 8.0);
-        temp_day = long_low(season(summer, 1.5*MONTH), 2.0, 14.0);
-        temp_water = long_low(season(summer, 2.5*MONTH), 3.0, 11.5);
-        precipitation = linear(season(winter), 90.0, 200.0);
         relative_humidity = long_low(humidity, 70.0, 85.0);
         break;
     case 12: // Csa: warm temperature, summer dry, hot summer
-        temp_night = sinusoidal(season(summer, MONTH), 2.0, 16.0);
-        temp_day = sinusoidal(season(summer, MONTH), 12.0, 33.0);
-        temp_water = sinusoidal(season(summer, 2.0*MONTH), 10.0, 27.5);
-        precipitation = linear(season(winter), 25.0, 70.0);
         relative_humidity = sinusoidal(humidity, 58.0, 72.0);
         break;
     case 13: // Csb: warm temperature, summer dry, warm summer
-        temp_night = linear(season(summer, 1.5*MONTH), -4.0, 10.0);
-        temp_day = linear(season(summer, 1.5*MONTH), 6.0, 27.0);
-        temp_water = linear(season(summer, 2.5*MONTH), 4.0, 21.5);
-        precipitation = linear(season(winter), 25.0, 120.0);
         relative_humidity = linear(humidity, 50.0, 72.0);
         break;
     case 14: // Csc: warm temperature, summer dry, cool summer
-        temp_night = sinusoidal(season(summer, 0.5*MONTH), -4.0, 5.0);
-        temp_day = sinusoidal(season(summer, 0.5*MONTH), 5.0, 16.0);
-        temp_water = sinusoidal(season(summer, 1.5*MONTH), 3.0, 14.5);
-        precipitation = sinusoidal(season(winter, -MONTH), 60.0, 95.0);
         relative_humidity = sinusoidal(humidity, 55.0, 75.0);
         break;
     case 15: // Cwa: warm temperature, winter dry, hot summer
-        temp_night = even(season(summer, MONTH), 4.0, 20.0);
-        temp_day = long_low(season(summer, MONTH), 15.0, 30.0);
-        temp_water = long_low(season(summer, 2.0*MONTH), 7.0, 24.5);
-        precipitation = long_low(season(summer, MONTH), 10.0, 320.0);
         relative_humidity = sinusoidal(humidity, 60.0, 79.0);
         break;
     case 16: // Cwb: warm temperature, winter dry, warm summer
-        temp_night = even(season(summer, MONTH), 1.0, 13.0);
-        temp_day = long_low(season(summer, MONTH), 15.0, 27.0);
-        temp_water = even(season(summer, 2.0*MONTH), 5.0, 22.5);
-        precipitation = long_low(season(summer, MONTH), 10.0, 250.0);
         relative_humidity = sinusoidal(humidity, 58.0, 72.0);
         break;
     case 17: // Cwc: warm temperature, winter dry, cool summer
-        temp_night = long_low(season(summer, MONTH), -9.0, 6.0);
-        temp_day = long_high(season(summer, MONTH), 6.0, 17.0);
-        temp_water = long_high(season(summer, 2.0*MONTH), 8.0, 15.5);
-        precipitation = long_low(season(summer, MONTH), 5.0, 200.0);
         relative_humidity = long_high(humidity, 50.0, 58.0);
         break;
     default:
@@ -647,96 +905,49 @@ void FGClimate::set_continetal()
     double hmax = sinusoidal(season(winter), 0.86, 1.0);
     double humidity = linear(daytime(day, -9.0*HOUR), hmin, hmax);
 
-    double temp_water = _gl.temperature_water;
-    double temp_day = _sl.temperature;
-    double temp_night = _sl.temperature;
-    double precipitation = _gl.precipitation;
+    Seasonal seasons = seasonal(_code);
+    double temp_water = seasons.temp_water;
+    double temp_day = seasons.temp_day;
+    double temp_night = seasons.temp_night;
+    double precipitation = seasons.precipitation;
     double relative_humidity = _gl.relative_humidity;
     switch(_code)
     {
     case 18: // Dfa: snow, fully humid, hot summer
-        temp_night = sinusoidal(season(summer, MONTH), -15.0, 13.0);
-        temp_day = sinusoidal(season(summer, MONTH), -5.0, 30.0);
-        temp_water = sinusoidal(season(summer, 2.0*MONTH), 0.0, 26.5);
-        precipitation = linear(season(summer, MONTH), 30.0, 70.0);
         relative_humidity = sinusoidal(humidity, 68.0, 72.0);
         break;
     case 19: // Dfb: snow, fully humid, warm summer, warm summer
-        temp_night = sinusoidal(season(summer, MONTH), -17.5, 10.0);
-        temp_day = sinusoidal(season(summer, MONTH), -7.5, 25.0);
-        temp_water = sinusoidal(season(summer, 2.0*MONTH), -2.0, 22.5);
-        precipitation = linear(season(summer, MONTH), 30.0, 70.0);
         relative_humidity = sinusoidal(humidity, 69.0, 81.0);
         break;
     case 20: // Dfc: snow, fully humid, cool summer, cool summer
-        temp_night = sinusoidal(season(summer, MONTH), -30.0, 4.0);
-        temp_day = sinusoidal(season(summer, MONTH), -20.0, 15.0);
-        temp_water = sinusoidal(season(summer, 2.0*MONTH), -10.0, 12.5);
-        precipitation = linear(season(summer, 1.5*MONTH), 22.0, 68.0);
         relative_humidity = sinusoidal(humidity, 70.0, 88.0);
         _wind_speed = 3.0;
         break;
     case 21: // Dfd: snow, fully humid, extremely continental
-        temp_night = sinusoidal(season(summer, MONTH), -45.0, 4.0);
-        temp_day = sinusoidal(season(summer, MONTH), -35.0, 10.0);
-        temp_water = sinusoidal(season(summer, 2.0*MONTH), -15.0, 8.5);
-        precipitation = long_low(season(summer, 1.5*MONTH), 7.5, 45.0);
         relative_humidity = sinusoidal(humidity, 80.0, 90.0);
         break;
     case 22: // Dsa: snow, summer dry, hot summer
-        temp_night = sinusoidal(season(summer, 1.5*MONTH), -10.0, 10.0);
-        temp_day = sinusoidal(season(summer, 1.5*MONTH), 0.0, 30.0);
-        temp_water = sinusoidal(season(summer, 3.5*MONTH), 4.0, 24.5);
-        precipitation = long_high(season(winter, 2.0*MONTH), 5.0, 65.0);
         relative_humidity = sinusoidal(humidity, 48.0, 58.08);
         break;
     case 23: // Dsb: snow, summer dry, warm summer
-        temp_night = sinusoidal(season(summer, 1.5*MONTH), -15.0, 6.0);
-        temp_day = sinusoidal(season(summer, 1.5*MONTH), -4.0, 25.0);
-        temp_water = sinusoidal(season(summer, 2.5*MONTH), 0.0, 19.5);
-        precipitation = long_high(season(winter, 2.0*MONTH), 12.0, 65.0);
         relative_humidity = sinusoidal(humidity, 50.0, 68.0);
         break;
     case 24: // Dsc: snow, summer dry, cool summer
-        temp_night = sinusoidal(season(summer, MONTH), -27.5, 2.0);
-        temp_day = sinusoidal(season(summer, MONTH), -4.0, 15.0);
-        temp_water = sinusoidal(season(summer, 2.0*MONTH), 0.0, 12.5);
-        precipitation = long_low(season(summer, MONTH), 32.5, 45.0);
         relative_humidity = sinusoidal(humidity, 50.0, 60.0);
         break;
     case 25: // Dsd: snow, summer dry, extremely continental
-        temp_night = sinusoidal(season(summer, MONTH), -11.5, -6.5);
-        temp_day = sinusoidal(season(summer, MONTH), 14.0, 27.0);
-        temp_water = sinusoidal(season(summer, 2.0*MONTH), 8.0, 20.5);
-        precipitation = long_low(season(summer, MONTH), 5.0, 90.0);
         relative_humidity = sinusoidal(humidity, 48.0, 62.0);
         break;
     case 26: // Dwa: snow, winter dry, hot summer
-        temp_night = sinusoidal(season(summer, MONTH), -18.0, 16.5);
-        temp_day = sinusoidal(season(summer, MONTH), -5.0, 25.0);
-        temp_water = sinusoidal(season(summer, 2.0*MONTH), 0.0, 23.5);
-        precipitation = long_low(season(summer, 1.5*MONTH), 5.0, 180.0);
         relative_humidity = sinusoidal(humidity, 60.0, 68.0);
         break;
     case 27: // Dwb: snow, winter dry, warm summer
-        temp_night = sinusoidal(season(summer, MONTH), -28.0, 10.0);
-        temp_day = sinusoidal(season(summer, MONTH), -12.5, 22.5);
-        temp_water = sinusoidal(season(summer, 2.0*MONTH), -5.0, 18.5);
-        precipitation = long_low(season(summer, 1.5*MONTH), 10.0, 140.0);
         relative_humidity = sinusoidal(humidity, 60.0, 72.0);
         break;
     case 28: // Dwc: snow, winter dry, cool summer
-        temp_night = sinusoidal(season(summer, MONTH), -33.0, 5.0);
-        temp_day = sinusoidal(season(summer, MONTH), -20.0, 20.0);
-        temp_water = sinusoidal(season(summer, 2.0*MONTH), -10.0, 16.5);
-        precipitation = long_low(season(summer, 1.5*MONTH), 10.0, 110.0);
         relative_humidity = sinusoidal(humidity, 60.0, 78.0);
         break;
     case 29: // Dwd: snow, winter dry, extremely continental
-        temp_night = sinusoidal(season(summer, MONTH), -57.5, 0.0);
-        temp_day = sinusoidal(season(summer, MONTH), -43.0, 15.0);
-        temp_water = sinusoidal(season(summer, 2.0*MONTH), -28.0, 11.5);
-        precipitation = sinusoidal(season(summer, 1.5*MONTH), 8.0, 63.0);
         relative_humidity = 80.0;
         break;
     default:
@@ -765,26 +976,19 @@ void FGClimate::set_polar()
     double humidity = linear(daytime(day, -9.0*HOUR), hmin, hmax);
 
     // polar climate also occurs high in the mountains
-    double temp_water = _gl.temperature_water;
-    double temp_day = _sl.temperature;
-    double temp_night = _sl.temperature;
-    double precipitation = _gl.precipitation;
+    Seasonal seasons = seasonal(_code);
+    double temp_water = seasons.temp_water;
+    double temp_day = seasons.temp_day;
+    double temp_night = seasons.temp_night;
+    double precipitation = seasons.precipitation;
     double relative_humidity = _gl.relative_humidity;
     switch(_code)
     {
     case 30: // EF: polar frost
-        temp_night = long_low(season(summer, MONTH), -35.0, -6.0);
-        temp_day = long_low(season(summer, MONTH), -32.5, 0.0);
-        temp_water = long_low(season(summer, 2.0*MONTH), -27.5, -3.5);
-        precipitation = linear(season(summer, 2.5*MONTH), 50.0, 80.0);
         relative_humidity = long_low(humidity, 65.0, 75.0);
         _wind_speed = 5.5;
         break;
     case 31: // ET: polar tundra
-        temp_night = sinusoidal(season(summer, MONTH), -30.0, 0.0);
-        temp_day = sinusoidal(season(summer, 1.5*MONTH), -22.5, 8.0);
-        temp_water = sinusoidal(season(summer, 2.0*MONTH), -15.0, 5.0);
-        precipitation = sinusoidal(season(summer, 2.0*MONTH), 15.0, 45.0);
         relative_humidity = sinusoidal(humidity, 60.0, 88.0);
         _wind_speed = 4.0;
         break;
@@ -7,8 +7,8 @@
 
 #pragma once
 
-#include <osg/ref_ptr>
-#include <osg/Image>
+#include <memory>
+#include <vector>
 
 #include <simgear/props/tiedpropertylist.hxx>
 #include <simgear/math/SGGeod.hxx>
@@ -21,6 +21,7 @@
  */
 
 class FGLight;
+class FGClimateMap;
 
 #define MAX_CLIMATE_CLASSES	32
 
@@ -108,6 +109,21 @@ private:
     double long_high(double val, double min, double max);
     double monsoonal(double val, double min, double max);
 
+    // temperatures and monthly precipitation of a climate class
+    struct Seasonal {
+        double temp_night = 0.0;
+        double temp_day = 0.0;
+        double temp_water = 0.0;
+        double precipitation = 0.0;
+    };
+
+    // table steps over the year, eight per month
+    static const int SEASON_STEPS = 96;
+
+    Seasonal seasonal_model(int code);
+    void build_seasonal();
+    Seasonal seasonal(int code);
+
     void set_ocean();
     void set_dry();
     void set_tropical();
@@ -131,10 +147,14 @@ private:
     SGPropertyNode_ptr _positionLatitudeNode;
     SGPropertyNode_ptr _positionLongitudeNode;
 
-    osg::ref_ptr<osg::Image> image;
+    std::shared_ptr<const FGClimateMap> _map;
     double _image_width = 0;
     double _image_height = 0;
 
+    // Seasonal values of every class (and of the ocean at the poles, after
+    // the last class) at SEASON_STEPS+1 times of the year
+    std::vector<Seasonal> _seasonal;
+
     double _epsilon = 1.0;
     double _prev_lat = -99999.0;
     double _prev_lon = -99999.0;
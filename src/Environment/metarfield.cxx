@@ -0,0 +1,120 @@
+// metarfield.cxx -- weather interpolated between METAR stations
+//
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <config.h>
+
+#include "metarfield.hxx"
+
+#include <algorithm>
+#include <cmath>
+
+#include <simgear/constants.h>
+
+namespace Environment {
+
+namespace {
+
+// closer than this, a station counts as being this far away, so that its
+// weight stays finite over the station itself
+const double MIN_DISTANCE_M = 1000.0;
+
+// the smallest changes passed on to the environment
+const double WIND_THRESHOLD_FPS = 1.0 * SG_NM_TO_METER * SG_METER_TO_FEET / 3600.0; // 1 kt
+const double TEMPERATURE_THRESHOLD_DEGC = 0.5;
+const double PRESSURE_THRESHOLD_INHG = 0.01;
+const double VISIBILITY_THRESHOLD_RATIO = 1.1;
+
+bool ratioExceeds(double a, double b, double ratio)
+{
+    if (a <= 0.0 || b <= 0.0) {
+        return a != b;
+    }
+    return (a > b * ratio) || (b > a * ratio);
+}
+
+} // namespace
+
+void MetarField::clear()
+{
+    _stations.clear();
+    _haveLast = false;
+}
+
+bool MetarField::interpolate(const SGVec3d& cart, MetarValues& values) const
+{
+    double weightSum = 0.0;
+    MetarValues sum;
+    sum.temperatureSeaLevelDegc = sum.dewpointSeaLevelDegc = 0.0;
+    sum.pressureSeaLevelInhg = 0.0;
+    sum.minVisibilityM = sum.maxVisibilityM = 0.0;
+
+    for (const auto& s : _stations) {
+        if (!s.metar->isValid()) {
+            continue;
+        }
+
+        const double d = std::max(dist(cart, s.cart), MIN_DISTANCE_M);
+        if (d >= _taperRadiusM) {
+            continue;
+        }
+
+        const double t = (_taperRadiusM - d) / (_taperRadiusM * d);
+        const double w = t * t;
+        const MetarValues v = s.metar->getValues();
+        sum.windFromNorthFps += w * v.windFromNorthFps;
+        sum.windFromEastFps += w * v.windFromEastFps;
+        sum.temperatureSeaLevelDegc += w * v.temperatureSeaLevelDegc;
+        sum.dewpointSeaLevelDegc += w * v.dewpointSeaLevelDegc;
+        sum.pressureSeaLevelInhg += w * v.pressureSeaLevelInhg;
+        // visibilities span orders of magnitude, blend them geometrically
+        sum.minVisibilityM += w * std::log(std::max(v.minVisibilityM, 1.0));
+        sum.maxVisibilityM += w * std::log(std::max(v.maxVisibilityM, 1.0));
+        weightSum += w;
+    }
+
+    if (weightSum <= 0.0) {
+        return false;
+    }
+
+    values.windFromNorthFps = sum.windFromNorthFps / weightSum;
+    values.windFromEastFps = sum.windFromEastFps / weightSum;
+    values.temperatureSeaLevelDegc = sum.temperatureSeaLevelDegc / weightSum;
+    values.dewpointSeaLevelDegc = sum.dewpointSeaLevelDegc / weightSum;
+    values.pressureSeaLevelInhg = sum.pressureSeaLevelInhg / weightSum;
+    values.minVisibilityM = std::exp(sum.minVisibilityM / weightSum);
+    values.maxVisibilityM = std::exp(sum.maxVisibilityM / weightSum);
+    return true;
+}
+
+bool MetarField::update(const SGVec3d& cart, MetarValues& values)
+{
+    MetarValues v;
+    if (!interpolate(cart, v)) {
+        return false;
+    }
+
+    if (_haveLast && !differs(_last, v)) {
+        return false;
+    }
+
+    _last = v;
+    _haveLast = true;
+    values = v;
+    return true;
+}
+
+bool MetarField::differs(const MetarValues& a, const MetarValues& b)
+{
+    const double dn = a.windFromNorthFps - b.windFromNorthFps;
+    const double de = a.windFromEastFps - b.windFromEastFps;
+    return (dn * dn + de * de > WIND_THRESHOLD_FPS * WIND_THRESHOLD_FPS) ||
+           (std::fabs(a.temperatureSeaLevelDegc - b.temperatureSeaLevelDegc) > TEMPERATURE_THRESHOLD_DEGC) ||
+           (std::fabs(a.dewpointSeaLevelDegc - b.dewpointSeaLevelDegc) > TEMPERATURE_THRESHOLD_DEGC) ||
+           (std::fabs(a.pressureSeaLevelInhg - b.pressureSeaLevelInhg) > PRESSURE_THRESHOLD_INHG) ||
+           ratioExceeds(a.minVisibilityM, b.minVisibilityM, VISIBILITY_THRESHOLD_RATIO) ||
+           ratioExceeds(a.maxVisibilityM, b.maxVisibilityM, VISIBILITY_THRESHOLD_RATIO);
+}
+
+} // namespace Environment
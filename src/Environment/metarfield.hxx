@@ -0,0 +1,67 @@
+// metarfield.hxx -- weather interpolated between METAR stations
+//
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <vector>
+
+#include <simgear/math/SGMath.hxx>
+
+#include "metarproperties.hxx"
+
+namespace Environment {
+
+/**
+ * @brief The continuous values of the METARs of a few stations around the
+ * aircraft, blended by inverse distance weighting, so that the weather
+ * changes gradually between stations instead of in a step when the
+ * nearest station changes. Evaluating it costs the same at every update,
+ * whatever the number of stations in the world.
+ *
+ * The weights fall to zero at the taper radius (modified Shepard), which
+ * the caller sets to the distance of the next station not in the set, so
+ * that a station entering or leaving the set does so with no weight.
+ */
+class MetarField {
+public:
+    struct Station {
+        SGSharedPtr<MetarProperties> metar;
+        SGVec3d cart;
+    };
+
+    /// stations beyond taperRadiusM of a point get no weight there
+    void setStations(const std::vector<Station>& stations, double taperRadiusM)
+    {
+        _stations = stations;
+        _taperRadiusM = taperRadiusM;
+    }
+    void clear();
+    bool empty() const { return _stations.empty(); }
+
+    /**
+     * @brief Blend the stations with a valid METAR at cart. Returns false
+     * if there is none.
+     */
+    bool interpolate(const SGVec3d& cart, MetarValues& values) const;
+
+    /**
+     * @brief Interpolate at cart, and return true with the result if it
+     * differs noticeably from the values last returned, so that the
+     * environment (and the cloud layers built from it) is not recomputed
+     * for changes nobody would notice.
+     */
+    bool update(const SGVec3d& cart, MetarValues& values);
+
+    /// true if b differs noticeably from a
+    static bool differs(const MetarValues& a, const MetarValues& b);
+
+private:
+    std::vector<Station> _stations;
+    double _taperRadiusM = 0.0;
+    bool _haveLast = false;
+    MetarValues _last;
+};
+
+} // namespace Environment
@@ -15,7 +15,7 @@
 #include "fgmetar.hxx"
 #include "environment.hxx"
 #include "atmosphere.hxx"
-#include "metarairportfilter.hxx"
+#include "metarstationindex.hxx"
 #include <simgear/scene/sky/cloud.hxx>
 #include <simgear/structure/exception.hxx>
 #include <simgear/misc/strutils.hxx>
@@ -123,6 +123,7 @@ MetarProperties::MetarProperties( SGPropertyNode_ptr rootNode ) :
   _hour(0),
   _minute(0),
   _cavok(false),
+  _hasValues(false),
   _magneticVariation(new MagneticVariation())
 {
   // Hack to avoid static initialization order problems on OSX
@@ -270,7 +271,7 @@ void MetarProperties::setMetar( SGSharedPtr<FGMetar> m )
             SGGeod pos = SGGeod::fromDeg(
                 fgGetDouble( "/position/longitude-deg", 0.0 ),
                 fgGetDouble( "/position/latitude-deg", 0.0 ) );
-            a = FGAirport::findClosest(pos, 10000.0, MetarAirportFilter::instance() );
+            a = MetarStationIndex::instance()->findClosest(pos, 10000.0);
         }
 
         // 3. otherwise use ground elevation
@@ -432,6 +433,8 @@ void MetarProperties::setMetar( SGSharedPtr<FGMetar> m )
     _hour = m->getHour();
     _minute = m->getMinute();
     _cavok = m->getCAVOK();
+    if( _hasValues )
+        applyValues();
     _tiedProperties.fireValueChanged();
     _metarValidNode->setBoolValue(true);
     _description = m->getDescription(-1);
@@ -490,5 +493,62 @@ void MetarProperties::set_wind_speed( double value )
     calc_wind_ne( (double)_base_wind_dir, _wind_speed, _wind_from_north_fps, _wind_from_east_fps );
 }
 
+MetarValues MetarProperties::getValues() const
+{
+    MetarValues v;
+    v.windFromNorthFps = _wind_from_north_fps;
+    v.windFromEastFps = _wind_from_east_fps;
+    v.temperatureSeaLevelDegc = _sea_level_temperature;
+    v.dewpointSeaLevelDegc = _sea_level_dewpoint;
+    v.pressureSeaLevelInhg = _sea_level_pressure;
+    v.minVisibilityM = _min_visibility;
+    v.maxVisibilityM = _max_visibility;
+    return v;
+}
+
+void MetarProperties::setValues( const MetarValues & values )
+{
+    _values = values;
+    _hasValues = true;
+    if( _metar ) {
+        applyValues();
+        _tiedProperties.fireValueChanged();
+    }
+}
+
+void MetarProperties::clearValues()
+{
+    _hasValues = false;
+}
+
+// the inverse of the reduction to sea level in setMetar()
+void MetarProperties::applyValues()
+{
+    _wind_from_north_fps = _values.windFromNorthFps;
+    _wind_from_east_fps = _values.windFromEastFps;
+    calc_wind_hs( _wind_from_north_fps, _wind_from_east_fps, _base_wind_dir, _wind_speed );
+
+    _sea_level_temperature = _values.temperatureSeaLevelDegc;
+    _sea_level_dewpoint = _values.dewpointSeaLevelDegc;
+    _sea_level_pressure = _values.pressureSeaLevelInhg;
+    _min_visibility = _values.minVisibilityM;
+    _max_visibility = _values.maxVisibilityM;
+
+    FGEnvironment dummy;
+    dummy.set_is_isa( globals->get_subsystem<FGEnvironmentMgr>()->getEnvironment().get_is_isa() );
+    dummy.set_elevation_ft( _station_elevation );
+    dummy.set_temperature_sea_level_degc( _sea_level_temperature );
+    dummy.set_dewpoint_sea_level_degc( _sea_level_dewpoint );
+    _temperature = dummy.get_temperature_degc();
+    _dewpoint = dummy.get_dewpoint_degc();
+    _humidity = dummy.get_relative_humidity();
+
+    double elevation_m = _station_elevation * SG_FEET_TO_METER;
+    double fieldPressure = P_layer(elevation_m, 0, _sea_level_pressure * atmodel::inHg,
+                                   _temperature + atmodel::freezing + atmodel::ISA::lam0 * elevation_m,
+                                   atmodel::ISA::lam0);
+    FGAtmo atmo;
+    _pressure = atmo.QNH( elevation_m, fieldPressure ) / atmodel::inHg;
+}
 
 } // namespace Environment
@@ -18,6 +18,21 @@ namespace Environment {
 
 class MagneticVariation;
 
+/**
+ * @brief The values of a METAR which vary continuously in space, with the
+ * temperatures and pressure reduced to sea level so that those of
+ * different stations can be blended.
+ */
+struct MetarValues {
+    double windFromNorthFps = 0.0;
+    double windFromEastFps = 0.0;
+    double temperatureSeaLevelDegc = 15.0;
+    double dewpointSeaLevelDegc = 5.0;
+    double pressureSeaLevelInhg = 29.92;
+    double minVisibilityM = 16000.0;
+    double maxVisibilityM = 16000.0;
+};
+
 class MetarProperties : public SGReferenced
 {
 public:
@@ -31,7 +46,19 @@ public:
     virtual void setMetar(SGSharedPtr<FGMetar> m);
     virtual void invalidate();
 
+    MetarValues getValues() const;
+
+    /**
+     * @brief Replace the continuous values of the METAR, keeping its
+     * station, clouds and weather. The values also replace those of METARs
+     * received later, until clearValues() is called.
+     */
+    void setValues(const MetarValues& values);
+    void clearValues();
+
 private:
+    void applyValues();
+
     const char * get_metar() const;
     void set_metar( const char * metar );
 
@@ -86,6 +113,8 @@ private:
     int _minute;
     bool _cavok;
     std::string _description;
+    bool _hasValues;
+    MetarValues _values;
 protected:
     simgear::TiedPropertyList _tiedProperties;
     MagneticVariation * _magneticVariation;
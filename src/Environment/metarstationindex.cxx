@@ -0,0 +1,223 @@
+// metarstationindex.cxx -- in-memory index of the airports with a METAR
+//
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <config.h>
+
+#include "metarstationindex.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <simgear/constants.h>
+#include <simgear/debug/logstream.hxx>
+#include <simgear/timing/timestamp.hxx>
+
+using flightgear::NavDataCache;
+
+namespace Environment {
+
+struct MetarStationIndex::Best {
+    double d1 = std::numeric_limits<double>::infinity(); // squared distances
+    double d2 = std::numeric_limits<double>::infinity();
+    size_t index = 0;
+
+    void offer(double dSqr, size_t i)
+    {
+        if (dSqr < d1) {
+            d2 = d1;
+            d1 = dSqr;
+            index = i;
+        } else if (dSqr < d2) {
+            d2 = dSqr;
+        }
+    }
+};
+
+// the count closest stations seen so far, as a max-heap on the squared
+// distance, bounded by the search range
+struct MetarStationIndex::Nearest {
+    size_t count;
+    double limit; // squared range
+    std::vector<std::pair<double, size_t>> heap;
+
+    // squared distance a station must beat to be kept
+    double bound() const
+    {
+        return heap.size() < count ? limit : heap.front().first;
+    }
+
+    void offer(double dSqr, size_t i)
+    {
+        if (dSqr >= bound()) {
+            return;
+        }
+
+        if (heap.size() == count) {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.pop_back();
+        }
+        heap.emplace_back(dSqr, i);
+        std::push_heap(heap.begin(), heap.end());
+    }
+};
+
+MetarStationIndex* MetarStationIndex::instance()
+{
+    static MetarStationIndex index;
+    return &index;
+}
+
+void MetarStationIndex::update()
+{
+    NavDataCache* cache = NavDataCache::instance();
+    if (cache == _cache) {
+        return;
+    }
+
+    _cache = cache;
+    _stations.clear();
+    if (!cache) {
+        return;
+    }
+
+    SGTimeStamp st;
+    st.stamp();
+    _stations = cache->metarStations();
+    build(0, _stations.size(), 0);
+    SG_LOG(SG_ENVIRONMENT, SG_DEBUG, "indexed " << _stations.size() << " METAR stations in "
+                                                << st.elapsedMSec() << "msec");
+}
+
+void MetarStationIndex::build(size_t lo, size_t hi, int axis)
+{
+    if (hi - lo < 2) {
+        return;
+    }
+
+    const size_t mid = lo + (hi - lo) / 2;
+    std::nth_element(_stations.begin() + lo, _stations.begin() + mid, _stations.begin() + hi,
+                     [axis](const flightgear::MetarStation& a, const flightgear::MetarStation& b) {
+                         return a.second[axis] < b.second[axis];
+                     });
+    build(lo, mid, (axis + 1) % 3);
+    build(mid + 1, hi, (axis + 1) % 3);
+}
+
+void MetarStationIndex::search(size_t lo, size_t hi, int axis, const SGVec3d& cart, Best& best) const
+{
+    if (lo >= hi) {
+        return;
+    }
+
+    const size_t mid = lo + (hi - lo) / 2;
+    const SGVec3d& p = _stations[mid].second;
+    best.offer(distSqr(cart, p), mid);
+
+    // the near side first, the far side only if it can hold one of the two
+    // closest stations
+    const double delta = cart[axis] - p[axis];
+    const int next = (axis + 1) % 3;
+    if (delta < 0.0) {
+        search(lo, mid, next, cart, best);
+        if (delta * delta < best.d2) {
+            search(mid + 1, hi, next, cart, best);
+        }
+    } else {
+        search(mid + 1, hi, next, cart, best);
+        if (delta * delta < best.d2) {
+            search(lo, mid, next, cart, best);
+        }
+    }
+}
+
+void MetarStationIndex::search(size_t lo, size_t hi, int axis, const SGVec3d& cart, Nearest& nearest) const
+{
+    if (lo >= hi) {
+        return;
+    }
+
+    const size_t mid = lo + (hi - lo) / 2;
+    nearest.offer(distSqr(cart, _stations[mid].second), mid);
+
+    const double delta = cart[axis] - _stations[mid].second[axis];
+    const int next = (axis + 1) % 3;
+    if (delta < 0.0) {
+        search(lo, mid, next, cart, nearest);
+        if (delta * delta < nearest.bound()) {
+            search(mid + 1, hi, next, cart, nearest);
+        }
+    } else {
+        search(mid + 1, hi, next, cart, nearest);
+        if (delta * delta < nearest.bound()) {
+            search(lo, mid, next, cart, nearest);
+        }
+    }
+}
+
+PositionedID MetarStationIndex::findClosest(const SGVec3d& cart, double maxRangeM,
+                                            SGVec3d& stationCart,
+                                            double& nearestM, double& secondM)
+{
+    update();
+
+    Best best;
+    search(0, _stations.size(), 0, cart, best);
+    nearestM = sqrt(best.d1);
+    secondM = sqrt(best.d2);
+    if (_stations.empty() || (nearestM > maxRangeM)) {
+        return 0;
+    }
+
+    stationCart = _stations[best.index].second;
+    return _stations[best.index].first;
+}
+
+FGAirportRef MetarStationIndex::findClosest(const SGGeod& pos, double maxRangeNm)
+{
+    SGVec3d stationCart;
+    double nearestM, secondM;
+    const PositionedID id = findClosest(SGVec3d::fromGeod(pos), maxRangeNm * SG_NM_TO_METER,
+                                        stationCart, nearestM, secondM);
+    return id ? FGPositioned::loadById<FGAirport>(id) : FGAirportRef();
+}
+
+flightgear::MetarStationVec MetarStationIndex::findNearest(const SGVec3d& cart, size_t count,
+                                                          double maxRangeM)
+{
+    update();
+
+    flightgear::MetarStationVec result;
+    if (count == 0) {
+        return result;
+    }
+
+    Nearest nearest{count, maxRangeM * maxRangeM, {}};
+    search(0, _stations.size(), 0, cart, nearest);
+    std::sort_heap(nearest.heap.begin(), nearest.heap.end());
+    for (const auto& n : nearest.heap) {
+        result.push_back(_stations[n.second]);
+    }
+    return result;
+}
+
+FGAirportRef NearestMetarStation::find(const SGGeod& pos, double maxRangeNm)
+{
+    const SGVec3d cart = SGVec3d::fromGeod(pos);
+    const double maxRangeM = maxRangeNm * SG_NM_TO_METER;
+    if (_station && (dist(cart, _lastCart) < _reuseRadiusM) &&
+        (dist(cart, _stationCart) <= maxRangeM)) {
+        return FGPositioned::loadById<FGAirport>(_station);
+    }
+
+    double nearestM, secondM;
+    _station = MetarStationIndex::instance()->findClosest(cart, maxRangeM, _stationCart,
+                                                          nearestM, secondM);
+    _lastCart = cart;
+    _reuseRadiusM = 0.5 * (secondM - nearestM);
+    return _station ? FGPositioned::loadById<FGAirport>(_station) : FGAirportRef();
+}
+
+} // namespace Environment
@@ -0,0 +1,82 @@
+// metarstationindex.hxx -- in-memory index of the airports with a METAR
+//
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <vector>
+
+#include <simgear/math/SGMath.hxx>
+
+#include <Airports/airport.hxx>
+#include <Navaids/NavDataCache.hxx>
+
+namespace Environment {
+
+/**
+ * @brief The airports (including heliports and seaports) which provide a
+ * METAR, in a k-d tree over their cartesian positions. Answers the same
+ * question as FGAirport::findClosest() with a MetarAirportFilter, without
+ * walking the positioned octree or loading airports which are then
+ * rejected. Built from the NavDataCache on first use.
+ */
+class MetarStationIndex {
+public:
+    static MetarStationIndex* instance();
+
+    /**
+     * The closest station to cart within maxRangeM (straight line
+     * distance), with its position, and the distances to it and to the
+     * second closest station, which is infinite if there is none. Returns 0
+     * if no station is in range.
+     */
+    PositionedID findClosest(const SGVec3d& cart, double maxRangeM, SGVec3d& stationCart,
+                             double& nearestM, double& secondM);
+
+    FGAirportRef findClosest(const SGGeod& pos, double maxRangeNm);
+
+    /**
+     * The count closest stations to cart within maxRangeM (straight line
+     * distance), closest first. Fewer are returned if there are not enough
+     * stations in range.
+     */
+    flightgear::MetarStationVec findNearest(const SGVec3d& cart, size_t count, double maxRangeM);
+
+private:
+    MetarStationIndex() = default;
+
+    void update();
+    void build(size_t lo, size_t hi, int axis);
+
+    struct Best;
+    void search(size_t lo, size_t hi, int axis, const SGVec3d& cart, Best& best) const;
+
+    struct Nearest;
+    void search(size_t lo, size_t hi, int axis, const SGVec3d& cart, Nearest& nearest) const;
+
+    // the cache the index was built from
+    flightgear::NavDataCache* _cache = nullptr;
+    // stations in k-d tree order: the median of [lo, hi) is the split of
+    // that range, along x, y, z in turn
+    flightgear::MetarStationVec _stations;
+};
+
+/**
+ * @brief Tracks the closest METAR station to a moving position. The last
+ * answer is kept while the position stays within half the gap between the
+ * distances to the closest and second closest station, as no other station
+ * can have come closer.
+ */
+class NearestMetarStation {
+public:
+    FGAirportRef find(const SGGeod& pos, double maxRangeNm);
+
+private:
+    PositionedID _station = 0;
+    SGVec3d _stationCart;
+    SGVec3d _lastCart;
+    double _reuseRadiusM = 0.0;
+};
+
+} // namespace Environment
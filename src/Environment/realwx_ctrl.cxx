@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <cctype>
 
+#include <simgear/constants.h>
 #include <simgear/structure/exception.hxx>
 #include <simgear/misc/strutils.hxx>
 #include <simgear/props/tiedpropertylist.hxx>
@@ -21,8 +22,9 @@
 #include <simgear/structure/event_mgr.hxx>
 #include <simgear/structure/commands.hxx>
 
+#include "metarfield.hxx"
 #include "metarproperties.hxx"
-#include "metarairportfilter.hxx"
+#include "metarstationindex.hxx"
 #include "fgmetar.hxx"
 #include <Network/HTTPClient.hxx>
 #include <Main/fg_props.hxx>
@@ -171,6 +173,7 @@ public:
 
 protected:
     void checkNearbyMetar();
+    void updateField(const SGGeod& pos);
 
     long getMetarMaxAgeMin() const { return _max_age_n == NULL ? 0 : _max_age_n->getLongValue(); }
 
@@ -183,6 +186,8 @@ protected:
     simgear::TiedPropertyList _tiedProperties;
     MetarPropertiesList _metarProperties;
     MetarRequester* _requester;
+    NearestMetarStation _nearestStation;
+    MetarField _field;
 };
 
 static bool commandRequestMetar(const SGPropertyNode * arg, SGPropertyNode * root)
@@ -227,6 +232,10 @@ static bool commandClearMetar(const SGPropertyNode * arg, SGPropertyNode * root)
 Properties
  ~/enabled: bool              Enables/Disables the realwx controller
  ~/metar[1..n]: string        Target property path for metar data
+ ~/field/stations: int        Number of stations the weather is interpolated
+                              between, fewer than 2 to use the nearest only
+ ~/field/range-nm: double     Range of the stations interpolated between
+ ~/field/station[n]           Metar data of the interpolated stations
  */
 
 BasicRealWxController::BasicRealWxController( SGPropertyNode_ptr rootNode, MetarRequester * metarRequester ) :
@@ -303,8 +312,18 @@ void BasicRealWxController::update( double dt )
             p->update(dt);
         }
 
+        MetarValues values;
+        if (!_field.empty() &&
+            _field.update(SGVec3d::fromGeod(globals->get_aircraft_position()), values)) {
+            _metarProperties[0]->setValues(values);
+        }
+
         _wasEnabled = true;
     } else {
+        if (!_field.empty()) {
+            _field.clear();
+            _metarProperties[0]->clearValues();
+        }
         _wasEnabled = false;
     }
 }
@@ -365,7 +384,7 @@ void BasicRealWxController::checkNearbyMetar()
       // check nearest airport
       SG_LOG(SG_ENVIRONMENT, SG_DEBUG, "NoaaMetarRealWxController::update(): (re) checking nearby airport with METAR" );
 
-      FGAirport * nearestAirport = FGAirport::findClosest(pos, 10000.0, MetarAirportFilter::instance() );
+      FGAirportRef nearestAirport = _nearestStation.find(pos, 10000.0);
       if( nearestAirport == NULL ) {
           SG_LOG(SG_ENVIRONMENT,SG_WARN,"RealWxController::update can't find airport with METAR within 10000NM"  );
           return;
@@ -381,12 +400,113 @@ void BasicRealWxController::checkNearbyMetar()
           _metarProperties[0]->setStationId( nearestAirport->ident() );
           _metarProperties[0]->resetTimeToLive();
       }
+
+      updateField(pos);
     }
     catch( sg_exception & ) {
       return;
     }
 }
 
+void BasicRealWxController::updateField(const SGGeod& pos)
+{
+    SGPropertyNode_ptr fieldNode = _rootNode->getNode("field", true);
+    const int count = _enabled ? fieldNode->getIntValue("stations", 3) : 0;
+    const SGVec3d cart = SGVec3d::fromGeod(pos);
+    const double rangeM = fieldNode->getDoubleValue("range-nm", 150.0) * SG_NM_TO_METER;
+    flightgear::MetarStationVec nearest;
+    if (count > 1) {
+        // one more than used: the weights taper to zero at its distance
+        nearest = MetarStationIndex::instance()->findNearest(cart, count + 1, rangeM);
+    }
+
+    double taperRadiusM = rangeM;
+    if (nearest.size() > static_cast<size_t>(count)) {
+        taperRadiusM = dist(cart, nearest.back().second);
+        nearest.pop_back();
+    }
+
+    if (nearest.size() < 2) {
+        if (!_field.empty()) {
+            _field.clear();
+            _metarProperties[0]->clearValues();
+        }
+        nearest.clear();
+    }
+
+    const size_t n = nearest.size();
+    std::vector<std::string> idents;
+    for (const auto& station : nearest) {
+        idents.push_back(FGPositioned::loadById<FGAirport>(station.first)->ident());
+    }
+
+    auto slotPath = [&fieldNode](size_t slot) {
+        return fieldNode->getChild("station", slot, true)->getPath();
+    };
+
+    // a station keeps its slot, and its METAR, while it is among the nearest
+    std::vector<int> slotOfStation(n, -1);
+    std::vector<bool> slotTaken(n, false);
+    for (size_t slot = 0; slot < n; ++slot) {
+        MetarPropertiesList::iterator it = findMetarAtPath(slotPath(slot));
+        if (it == _metarProperties.end()) {
+            continue;
+        }
+
+        const size_t k = std::find(idents.begin(), idents.end(), (*it)->getStationId()) - idents.begin();
+        if ((k < n) && (slotOfStation[k] < 0)) {
+            slotOfStation[k] = static_cast<int>(slot);
+            slotTaken[slot] = true;
+        }
+    }
+
+    // new stations take the free slots; the METAR of the previous station
+    // must not be blended at the new one's position until its own arrives
+    size_t freeSlot = 0;
+    for (size_t k = 0; k < n; ++k) {
+        if (slotOfStation[k] >= 0) {
+            continue;
+        }
+
+        while (slotTaken[freeSlot]) {
+            ++freeSlot;
+        }
+        slotTaken[freeSlot] = true;
+        slotOfStation[k] = static_cast<int>(freeSlot);
+
+        const std::string path = slotPath(freeSlot);
+        MetarPropertiesList::iterator it = findMetarAtPath(path);
+        if (it == _metarProperties.end()) {
+            addMetarAtPath(path, idents[k]);
+        } else {
+            (*it)->setStationId(idents[k]);
+            (*it)->invalidate();
+            (*it)->resetTimeToLive();
+        }
+    }
+
+    std::vector<MetarField::Station> stations;
+    for (size_t k = 0; k < n; ++k) {
+        stations.push_back({*findMetarAtPath(slotPath(slotOfStation[k])), nearest[k].second});
+    }
+
+    for (int i = fieldNode->nChildren() - 1; i >= 0; --i) {
+        SGPropertyNode* child = fieldNode->getChild(i);
+        if (child->getNameString() != "station" || child->getIndex() < static_cast<int>(n)) {
+            continue;
+        }
+
+        MetarPropertiesList::iterator it = findMetarAtPath(child->getPath());
+        if (it != _metarProperties.end()) {
+            _metarProperties.erase(it);
+        }
+        fieldNode->removeChild(i);
+    }
+
+    if (!stations.empty()) {
+        _field.setStations(stations, taperRadiusM);
+    }
+}
 
 /* -------------------------------------------------------------------------------- */
 
@@ -23,15 +23,9 @@
 using std::string;
 
 #include "ridge_lift.hxx"
+#include "ridgeliftmodel.hxx"
 
-static const double BOUNDARY1_m = 40.0;
-
-const double FGRidgeLift::dist_probe_m[] = { // in meters
-    0.0,
-    250.0,
-    750.0,
-    2000.0,
-    -100.0};
+using Environment::RidgeLiftModel;
 
 //constructor
 FGRidgeLift::FGRidgeLift () :
@@ -122,7 +116,7 @@ void FGRidgeLift::update(double dt) {
 
 		// compute the remaining probes
 		for (unsigned i = 1; i < sizeof(probe_elev_m)/sizeof(probe_elev_m[0]); i++) {
-			SGGeoc probe = myGeocPos.advanceRadM( ground_wind_from_rad, dist_probe_m[i] );
+			SGGeoc probe = myGeocPos.advanceRadM( ground_wind_from_rad, RidgeLiftModel::probe_distance_m[i] );
 			// convert to geodetic position for ground level computation
 			SGGeod probeGeod = SGGeod::fromGeoc( probe );
 			probe_lat_deg[i] = probeGeod.getLatitudeDeg();
@@ -133,31 +127,7 @@ void FGRidgeLift::update(double dt) {
 			}
 		}
 
-		// slopes
-		double adj_slope[sizeof(slope)];
-		slope[0] = (probe_elev_m[0] - probe_elev_m[1]) / dist_probe_m[1];
-		slope[1] = (probe_elev_m[1] - probe_elev_m[2]) / dist_probe_m[2];
-		slope[2] = (probe_elev_m[2] - probe_elev_m[3]) / dist_probe_m[3];
-        slope[3] = (probe_elev_m[4] - probe_elev_m[0]) / -dist_probe_m[4];
-
-        for (unsigned i = 0; i < sizeof(slope) / sizeof(slope[0]); i++)
-            adj_slope[i] = sin(atan(5.0 * pow((fabs(slope[i])), 1.7))) * SG_SIGN<double>(slope[i]);
-
-        //adjustment
-        adj_slope[0] *= 0.2;
-        adj_slope[1] *= 0.2;
-        if (adj_slope[2] < 0.0) {
-            adj_slope[2] *= 0.5;
-        } else {
-            adj_slope[2] = 0.0;
-        }
-
-        if ((adj_slope[0] >= 0.0) && (adj_slope[3] < 0.0)) {
-            adj_slope[3] = 0.0;
-        } else {
-            adj_slope[3] *= 0.2;
-        }
-        lift_factor = adj_slope[0] + adj_slope[1] + adj_slope[2] + adj_slope[3];
+        lift_factor = RidgeLiftModel::liftFactor(probe_elev_m, slope);
 
         // restart the timer
         timer = 1.0;
@@ -166,24 +136,8 @@ void FGRidgeLift::update(double dt) {
     //user altitude above ground
     double user_altitude_agl_m = _user_altitude_agl_ft_node->getDoubleValue() * SG_FEET_TO_METER;
 
-    //boundaries
-    double boundary2_m = 130.0; // in the lift
-    if (lift_factor < 0.0) {    // in the sink
-        double highest_probe_temp = std::max(probe_elev_m[1], probe_elev_m[2]);
-        double highest_probe_downwind_m = std::max(highest_probe_temp, probe_elev_m[3]);
-        boundary2_m = highest_probe_downwind_m - probe_elev_m[0];
-    }
-
-    double agl_factor;
-    if (user_altitude_agl_m < BOUNDARY1_m) {
-        agl_factor = 0.5 + 0.5 * user_altitude_agl_m / BOUNDARY1_m;
-    } else if (user_altitude_agl_m < boundary2_m) {
-        agl_factor = 1.0;
-    } else {
-        agl_factor = exp(-(2 + probe_elev_m[0] / 2000) *
-                         (user_altitude_agl_m - boundary2_m) / std::max(probe_elev_m[0], 200.0));
-    }
-
+    double boundary2_m = RidgeLiftModel::boundary(probe_elev_m, lift_factor);
+    double agl_factor = RidgeLiftModel::aglFactor(user_altitude_agl_m, probe_elev_m[0], boundary2_m);
     double ground_wind_speed_mps = _surface_wind_speed_node->getDoubleValue() * SG_NM_TO_METER / 3600;
     double lift_mps = lift_factor * ground_wind_speed_mps * agl_factor;
 
@@ -39,8 +39,6 @@ public:
     inline double get_slope( int index ) const { return slope[index]; };
 
 private:
-    static const double dist_probe_m[5];
-
     double strength;
     double timer;
 
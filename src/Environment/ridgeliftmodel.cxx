@@ -0,0 +1,81 @@
+// ridgeliftmodel.cxx -- ridge lift formulas
+//
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <config.h>
+
+#include "ridgeliftmodel.hxx"
+
+#include <algorithm>
+#include <cmath>
+
+#include <simgear/sg_inlines.h>
+
+namespace Environment {
+
+namespace {
+
+const double BOUNDARY1_m = 40.0;
+
+} // namespace
+
+const double RidgeLiftModel::probe_distance_m[] = { // in meters
+    0.0,
+    250.0,
+    750.0,
+    2000.0,
+    -100.0};
+
+double RidgeLiftModel::liftFactor(const double elevation_m[5], double slope[4])
+{
+    const double* dist = probe_distance_m;
+    double adj_slope[4];
+    slope[0] = (elevation_m[0] - elevation_m[1]) / dist[1];
+    slope[1] = (elevation_m[1] - elevation_m[2]) / dist[2];
+    slope[2] = (elevation_m[2] - elevation_m[3]) / dist[3];
+    slope[3] = (elevation_m[4] - elevation_m[0]) / -dist[4];
+
+    for (int i = 0; i < 4; i++)
+        adj_slope[i] = sin(atan(5.0 * pow((fabs(slope[i])), 1.7))) * SG_SIGN<double>(slope[i]);
+
+    //adjustment
+    adj_slope[0] *= 0.2;
+    adj_slope[1] *= 0.2;
+    if (adj_slope[2] < 0.0) {
+        adj_slope[2] *= 0.5;
+    } else {
+        adj_slope[2] = 0.0;
+    }
+
+    if ((adj_slope[0] >= 0.0) && (adj_slope[3] < 0.0)) {
+        adj_slope[3] = 0.0;
+    } else {
+        adj_slope[3] *= 0.2;
+    }
+    return adj_slope[0] + adj_slope[1] + adj_slope[2] + adj_slope[3];
+}
+
+double RidgeLiftModel::boundary(const double elevation_m[5], double lift_factor)
+{
+    if (lift_factor >= 0.0) { // in the lift
+        return 130.0;
+    }
+
+    // in the sink
+    double highest_probe_temp = std::max(elevation_m[1], elevation_m[2]);
+    double highest_probe_downwind_m = std::max(highest_probe_temp, elevation_m[3]);
+    return highest_probe_downwind_m - elevation_m[0];
+}
+
+double RidgeLiftModel::aglFactor(double agl_m, double ground_m, double boundary_m)
+{
+    if (agl_m < BOUNDARY1_m) {
+        return 0.5 + 0.5 * agl_m / BOUNDARY1_m;
+    } else if (agl_m < boundary_m) {
+        return 1.0;
+    }
+    return exp(-(2 + ground_m / 2000) * (agl_m - boundary_m) / std::max(ground_m, 200.0));
+}
+
+} // namespace Environment
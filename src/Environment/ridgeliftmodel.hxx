@@ -0,0 +1,30 @@
+// ridgeliftmodel.hxx -- ridge lift formulas
+//
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+namespace Environment {
+
+/**
+ * @brief The formulas that turn the terrain elevations at the ridge lift
+ * probes into lift, kept apart from FGRidgeLift so that they can be
+ * tested without scenery.
+ */
+class RidgeLiftModel {
+public:
+    /// distances of the probes upwind of a point, the last one is downwind
+    static const double probe_distance_m[5];
+
+    /// the lift factor from the probe elevations, setting the slopes
+    static double liftFactor(const double elevation_m[5], double slope[4]);
+
+    /// the top of the full lift, or of the sink, above the first probe
+    static double boundary(const double elevation_m[5], double lift_factor);
+
+    /// the fraction of the lift felt at agl_m
+    static double aglFactor(double agl_m, double ground_m, double boundary_m);
+};
+
+} // namespace Environment
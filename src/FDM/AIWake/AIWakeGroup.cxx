@@ -76,8 +76,8 @@ void AIWakeGroup::AddAI(FGAIAircraft* ai)
 SGVec3d AIWakeGroup::getInducedVelocityAt(const SGVec3d& pt) const
 {
     SGVec3d vi(0.,0.,0.);
-    for (auto item : _aiWakeData) {
-        AIWakeData& data = item.second;
+    for (const auto& item : _aiWakeData) {
+        const AIWakeData& data = item.second;
         if (!data.visited) continue;
 
         SGVec3d at = data.Te2b.transform(pt - data.position);
@@ -86,6 +86,26 @@ SGVec3d AIWakeGroup::getInducedVelocityAt(const SGVec3d& pt) const
     return vi;
 }
 
+void AIWakeGroup::getInducedVelocities(const std::vector<SGVec3d>& pts,
+                                       std::vector<SGVec3d>& out) const
+{
+    const size_t n = pts.size();
+    std::vector<SGVec3d> at(n);
+
+    out.assign(n, SGVec3d::zeros());
+
+    for (const auto& item : _aiWakeData) {
+        const AIWakeData& data = item.second;
+        if (!data.visited) continue;
+
+        for (size_t i=0; i<n; ++i)
+            at[i] = data.Te2b.transform(pts[i] - data.position);
+
+        for (size_t i=0; i<n; ++i)
+            out[i] += data.Te2b.backTransform(data.mesh->getInducedVelocityAt(at[i]));
+    }
+}
+
 void AIWakeGroup::gc(void)
 {
     for (auto it=_aiWakeData.begin(); it != _aiWakeData.end(); ++it) {
@@ -43,6 +43,12 @@ public:
     AIWakeGroup(void);
     void AddAI(FGAIAircraft* ai);
     SGVec3d getInducedVelocityAt(const SGVec3d& pt) const;
+    /**
+     * Velocities induced at many points, returned in out. Cheaper than calling
+     * getInducedVelocityAt for each point as each wake is visited once.
+     */
+    void getInducedVelocities(const std::vector<SGVec3d>& pts,
+                              std::vector<SGVec3d>& out) const;
     // Garbage collection
     void gc(void);
 };
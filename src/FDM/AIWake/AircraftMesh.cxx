@@ -63,9 +63,10 @@ SGVec3d AircraftMesh::GetForce(const AIWakeGroup& wg, const SGVec3d& vel,
     std::vector<double> rhs;
     rhs.resize(nelm, 0.0);
 
+    wg.getInducedVelocities(collPt, wakeVel);
+
     for (int i=0; i<nelm; ++i)
-        rhs[i] = dot(elements[i]->getNormal(),
-                     Te2b.transform(wg.getInducedVelocityAt(collPt[i])));
+        rhs[i] = dot(elements[i]->getNormal(), Te2b.transform(wakeVel[i]));
 
     for (int i=1; i<=nelm; ++i) {
         Gamma[i][1] = 0.0;
@@ -76,9 +77,11 @@ SGVec3d AircraftMesh::GetForce(const AIWakeGroup& wg, const SGVec3d& vel,
     SGVec3d f(0.,0.,0.);
     moment = SGVec3d::zeros();
 
+    wg.getInducedVelocities(midPt, wakeVel);
+
     for (int i=0; i<nelm; ++i) {
         SGVec3d mp = elements[i]->getBoundVortexMidPoint();
-        SGVec3d v = Te2b.transform(wg.getInducedVelocityAt(midPt[i]));
+        SGVec3d v = Te2b.transform(wakeVel[i]);
         v += getInducedVelocityAt(mp);
 
         // The minus sign before vel to transform the aircraft velocity from the
@@ -40,6 +40,7 @@ private:
     friend class FGTestApi::PrivateAccessor::FDM::Accessor;
 
     std::vector<SGVec3d> collPt, midPt;
+    std::vector<SGVec3d> wakeVel; // scratch buffer for GetForce
     SGQuatd Te2b;
     SGVec3d moment;
 };
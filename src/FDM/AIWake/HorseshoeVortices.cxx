@@ -0,0 +1,80 @@
+// HorseshoeVortices.cxx -- Structure-of-arrays evaluation of the velocity
+// induced by a set of horseshoe vortices.
+//
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cmath>
+
+#include <simgear/structure/SGSharedPtr.hxx>
+
+#include "AeroElement.hxx"
+#include "HorseshoeVortices.hxx"
+
+void HorseshoeVortices::add(const AeroElement& element)
+{
+    const SGVec3d& p1 = element.getBoundVortexStart();
+    const SGVec3d& p2 = element.getBoundVortexEnd();
+    _x1.push_back(p1[0]);
+    _y1.push_back(p1[1]);
+    _z1.push_back(p1[2]);
+    _x2.push_back(p2[0]);
+    _y2.push_back(p2[1]);
+    _z2.push_back(p2[2]);
+}
+
+// The singularity tests of AeroElement are kept, but as selects rather than
+// early returns so the loop has no branches.
+SGVec3d HorseshoeVortices::getInducedVelocity(const SGVec3d& p,
+                                              const double* gamma) const
+{
+    const double px = p[0], py = p[1], pz = p[2];
+    const double k = 1.0 / (4.0*M_PI);
+    const size_t n = _x1.size();
+    const double *x1 = _x1.data(), *y1 = _y1.data(), *z1 = _z1.data();
+    const double *x2 = _x2.data(), *y2 = _y2.data(), *z2 = _z2.data();
+    double vx = 0.0, vy = 0.0, vz = 0.0;
+
+    for (size_t j=0; j < n; ++j) {
+        const double r1x = px - x1[j], r1y = py - y1[j], r1z = pz - z1[j];
+        const double r2x = px - x2[j], r2y = py - y2[j], r2z = pz - z2[j];
+        const double r1SqrNorm = r1x*r1x + r1y*r1y + r1z*r1z;
+        const double r2SqrNorm = r2x*r2x + r2y*r2y + r2z*r2z;
+        const double r1Norm = sqrt(r1SqrNorm);
+        const double r2Norm = sqrt(r2SqrNorm);
+
+        // Bound vortex from p1 to p2
+        const double cx = r1y*r2z - r1z*r2y;
+        const double cy = r1z*r2x - r1x*r2z;
+        const double cz = r1x*r2y - r1y*r2x;
+        const double cSqrNorm = cx*cx + cy*cy + cz*cz;
+        const double r0x = x2[j] - x1[j], r0y = y2[j] - y1[j], r0z = z2[j] - z1[j];
+        const double proj = (r0x*r1x + r0y*r1y + r0z*r1z) / r1Norm
+                          - (r0x*r2x + r0y*r2y + r0z*r2z) / r2Norm;
+        const bool bound = (cSqrNorm >= 1E-6) && (r1SqrNorm >= 1E-6)
+                           && (r2SqrNorm >= 1E-6);
+        const double kb = bound ? k*proj/cSqrNorm : 0.0;
+
+        // Semi-infinite trailing vortices along w=(-1,0,0), for which
+        // cross(r, w) = (0, -r.z, r.y)
+        const double d1 = r1SqrNorm + r1x*r1Norm;
+        const double d2 = r2SqrNorm + r2x*r2Norm;
+        const double k1 = (fabs(d1) >= 1E-6) ? k/d1 : 0.0;
+        const double k2 = (fabs(d2) >= 1E-6) ? k/d2 : 0.0;
+
+        const double g = gamma[j];
+        vx += g*kb*cx;
+        vy += g*(kb*cy - r1z*k1 + r2z*k2);
+        vz += g*(kb*cz + r1y*k1 - r2y*k2);
+    }
+
+    return SGVec3d(vx, vy, vz);
+}
+
+void HorseshoeVortices::addInducedVelocities(const std::vector<SGVec3d>& points,
+                                             const double* gamma,
+                                             std::vector<SGVec3d>& v) const
+{
+    for (size_t i=0; i < points.size(); ++i)
+        v[i] += getInducedVelocity(points[i], gamma);
+}
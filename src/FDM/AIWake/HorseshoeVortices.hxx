@@ -0,0 +1,42 @@
+// HorseshoeVortices.hxx -- Structure-of-arrays evaluation of the velocity
+// induced by a set of horseshoe vortices.
+//
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <vector>
+
+#include <simgear/math/SGVec3.hxx>
+
+class AeroElement;
+
+/**
+ * The horseshoe vortices of a mesh, stored as separate coordinate arrays so
+ * the induced velocity at a point is evaluated against all of them in one
+ * branch-free loop the compiler can vectorise. Each vortex is the bound
+ * segment of an AeroElement plus its two trailing legs along -x; the result
+ * matches summing AeroElement::getInducedVelocity.
+ */
+class HorseshoeVortices
+{
+public:
+    void add(const AeroElement& element);
+    size_t size() const { return _x1.size(); }
+
+    /**
+     * Velocity induced at p by all vortices, vortex j having circulation
+     * gamma[j].
+     */
+    SGVec3d getInducedVelocity(const SGVec3d& p, const double* gamma) const;
+
+    /// as above for many points; results are added to v
+    void addInducedVelocities(const std::vector<SGVec3d>& points,
+                              const double* gamma,
+                              std::vector<SGVec3d>& v) const;
+
+private:
+    std::vector<double> _x1, _y1, _z1;
+    std::vector<double> _x2, _y2, _z2;
+};
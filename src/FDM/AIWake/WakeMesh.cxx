@@ -22,6 +22,8 @@
 
 #include <vector>
 #include <cmath>
+#include <map>
+#include <mutex>
 
 #include <simgear/structure/SGSharedPtr.hxx>
 #include <simgear/math/SGVec3.hxx>
@@ -33,8 +35,9 @@ extern "C" {
     #include "FDM/ls_matrix.h"
 }
 
-WakeMesh::WakeMesh(double _span, double _chord, const std::string& aircraft_name)
-    : nelm(10), span(_span), chord(_chord)
+WakeMeshGeometry::WakeMeshGeometry(int _nelm, double span, double chord,
+                                   const std::string& aircraft_name)
+    : nelm(_nelm)
 {
     double y1 = -0.5*span;
     double ds = span / nelm;
@@ -45,11 +48,11 @@ WakeMesh::WakeMesh(double _span, double _chord, const std::string& aircraft_name
                                            SGVec3d(0., y1, 0.),
                                            SGVec3d(0., y2, 0.),
                                            SGVec3d(-chord, y2, 0.)));
+        vortices.add(*elements.back());
         y1 = y2;
     }
 
     influenceMtx = nr_matrix(1, nelm, 1, nelm);
-    Gamma = nr_matrix(1, nelm, 1, 1);
 
     for (int i=0; i < nelm; ++i) {
         SGVec3d normal = elements[i]->getNormal();
@@ -73,13 +76,46 @@ WakeMesh::WakeMesh(double _span, double _chord, const std::string& aircraft_name
         // 2. Report the issue in the log.
         SG_LOG(SG_FLIGHT, SG_WARN,
                 "Failed to build wake mesh. " << aircraft_name << " ( span:"
-                << _span << ", chord:" << _chord << ") wake will be ignored.");
+                << span << ", chord:" << chord << ") wake will be ignored.");
     }
 }
 
-WakeMesh::~WakeMesh()
+WakeMeshGeometry::~WakeMeshGeometry()
 {
     nr_free_matrix(influenceMtx, 1, nelm, 1, nelm);
+}
+
+// Geometries are kept for the whole session: there are only as many as
+// there are distinct aircraft dimensions, and each is a few kilobytes.
+static SGSharedPtr<WakeMeshGeometry> getSharedGeometry(int nelm, double span,
+                                                       double chord,
+                                                       const std::string& aircraft_name)
+{
+    static std::mutex lock;
+    static std::map<std::pair<double, double>, SGSharedPtr<WakeMeshGeometry>> cache;
+
+    std::lock_guard<std::mutex> g(lock);
+    SGSharedPtr<WakeMeshGeometry>& geometry = cache[std::make_pair(span, chord)];
+    if (!geometry)
+        geometry = new WakeMeshGeometry(nelm, span, chord, aircraft_name);
+
+    return geometry;
+}
+
+WakeMesh::WakeMesh(double _span, double _chord, const std::string& aircraft_name)
+    : nelm(10), span(_span), chord(_chord)
+{
+    geometry = getSharedGeometry(nelm, span, chord, aircraft_name);
+    elements = geometry->elements;
+    influenceMtx = geometry->influenceMtx;
+    Gamma = nr_matrix(1, nelm, 1, 1);
+
+    for (int i=1; i<=nelm; ++i)
+        Gamma[i][1] = 0.0;
+}
+
+WakeMesh::~WakeMesh()
+{
     nr_free_matrix(Gamma, 1, nelm, 1, 1);
 }
 
@@ -112,10 +148,5 @@ double WakeMesh::computeAoA(double vel, double rho, double weight)
 
 SGVec3d WakeMesh::getInducedVelocityAt(const SGVec3d& at) const
 {
-    SGVec3d v(0., 0., 0.);
-
-    for (int i=0; i<nelm; ++i)
-        v += Gamma[i+1][1] * elements[i]->getInducedVelocity(at);
-
-    return v;
+    return geometry->vortices.getInducedVelocity(at, gammaVector());
 }
@@ -11,6 +11,7 @@
 #include <simgear/math/SGVec3.hxx>
 
 #include "AeroElement.hxx"
+#include "HorseshoeVortices.hxx"
 
 namespace FGTestApi {
 namespace PrivateAccessor {
@@ -21,6 +22,24 @@ class Accessor;
 } // namespace FGTestApi
 
 
+/**
+ * The part of a wake mesh that only depends on its span and chord: the
+ * elements, their vortices and the inverted influence matrix. It is shared
+ * by all meshes of the same dimensions, so a crowd of identical AI aircraft
+ * pays for one matrix inversion.
+ */
+struct WakeMeshGeometry : public SGReferenced
+{
+    WakeMeshGeometry(int nelm, double span, double chord,
+                     const std::string& aircraft_name);
+    ~WakeMeshGeometry();
+
+    int nelm;
+    std::vector<AeroElement_ptr> elements;
+    HorseshoeVortices vortices;
+    double **influenceMtx;
+};
+
 class WakeMesh : public SGReferenced
 {
 public:
@@ -32,6 +51,10 @@ public:
 protected:
     friend class FGTestApi::PrivateAccessor::FDM::Accessor;
 
+    // circulation of each element, stored contiguously from Gamma[1][1]
+    const double* gammaVector(void) const { return &Gamma[1][1]; }
+
+    SGSharedPtr<WakeMeshGeometry> geometry;
     int nelm;
     double span, chord;
     std::vector<AeroElement_ptr> elements;
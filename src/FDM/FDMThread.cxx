@@ -0,0 +1,231 @@
+/*
+ * FDMThread.cxx
+ * run an FDM implementation on a dedicated fixed-rate thread
+ *
+ * SPDX-FileCopyrightText: 2026 FlightGear Developers
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <config.h>
+
+#include "FDMThread.hxx"
+
+#include <chrono>
+
+#include <simgear/debug/logstream.hxx>
+#include <simgear/math/SGMath.hxx>
+
+namespace {
+
+// exponential smoothing factor for the averaged statistics
+const double statsSmoothing = 0.05;
+
+// once this many ticks behind, stop trying to catch up and resynchronise
+const int maxCatchUpTicks = 4;
+
+} // namespace
+
+FDMThread::FDMThread(FGInterface* impl, double dt, std::recursive_timed_mutex& lock,
+                     SGPropertyNode* clockFreeze) :
+    _impl(impl),
+    _dt(dt),
+    _lock(lock),
+    _clockFreeze(clockFreeze)
+{
+}
+
+FDMThread::~FDMThread()
+{
+    stop();
+}
+
+void FDMThread::stop()
+{
+    {
+        std::lock_guard<std::mutex> g(_stopMutex);
+        if (_stop) {
+            return;
+        }
+        _stop = true;
+    }
+
+    _stopCondition.notify_all();
+    join();
+}
+
+void FDMThread::setInputs(const Inputs& inputs)
+{
+    _inputs = inputs;
+}
+
+bool FDMThread::waitForTick(const SGTimeStamp& deadline)
+{
+    std::unique_lock<std::mutex> g(_stopMutex);
+    const SGTimeStamp remaining = deadline - SGTimeStamp::now();
+    if (remaining.toUSecs() > 0) {
+        _stopCondition.wait_for(g, std::chrono::microseconds(remaining.toUSecs()),
+                                [this] { return _stop; });
+    }
+
+    return !_stop;
+}
+
+void FDMThread::run()
+{
+    const SGTimeStamp period = SGTimeStamp::fromSec(_dt);
+    SGTimeStamp deadline = SGTimeStamp::now();
+
+    for (;;) {
+        deadline += period;
+        if (!waitForTick(deadline)) {
+            return;
+        }
+
+        // the main thread holds the lock while subsystems update; keep
+        // checking for stop so shutdown can't deadlock against us
+        std::unique_lock<std::recursive_timed_mutex> lock(_lock, std::defer_lock);
+        while (!lock.try_lock_for(std::chrono::microseconds(period.toUSecs()))) {
+            std::lock_guard<std::mutex> g(_stopMutex);
+            if (_stop) {
+                return;
+            }
+        }
+
+        const SGTimeStamp start = SGTimeStamp::now();
+        iterate();
+        const SGTimeStamp end = SGTimeStamp::now();
+
+        const double jitterMs = (start - deadline).toSecs() * 1000.0;
+        const double iterationMs = (end - start).toSecs() * 1000.0;
+        ++_ticks;
+        _jitterMs += (jitterMs - _jitterMs) * statsSmoothing;
+        _maxJitterMs = std::max(_maxJitterMs, jitterMs);
+        _iterationMs += (iterationMs - _iterationMs) * statsSmoothing;
+        _maxIterationMs = std::max(_maxIterationMs, iterationMs);
+
+        const double lateSec = (end - deadline).toSecs();
+        if (lateSec > _dt) {
+            ++_overruns;
+            const auto behind = static_cast<int>(lateSec / _dt);
+            if (behind > maxCatchUpTicks) {
+                // drop the backlog instead of bursting to catch up
+                _skippedTicks += behind;
+                deadline = end;
+            }
+        }
+    }
+}
+
+void FDMThread::iterate()
+{
+    if (_failed || (_inputs.iterations <= 0) || _clockFreeze->getBoolValue()) {
+        return;
+    }
+
+    restoreIntegrationState();
+
+    _impl->set_Velocities_Local_Airmass(_inputs.windNorthFps,
+                                        _inputs.windEastFps,
+                                        _inputs.windDownFps);
+    if (_inputs.controlAtmosphere) {
+        _impl->set_Static_temperature(_inputs.staticTemperatureR);
+        _impl->set_Static_pressure(_inputs.staticPressurePsf);
+        _impl->set_Density(_inputs.densitySlugFt3);
+    }
+
+    try {
+        for (int i = 0; i < _inputs.iterations; ++i) {
+            _impl->update(_dt);
+        }
+    } catch (std::exception& e) {
+        SG_LOG(SG_FLIGHT, SG_ALERT, "FDM thread: update failed, stopping iterations: " << e.what());
+        _failed = true;
+        return;
+    }
+
+    _latest ^= 1;
+    _snapshots[_latest].state = _impl->getState();
+    _snapshots[_latest].time.stamp();
+    _snapshotCount = std::min(_snapshotCount + 1, 2U);
+}
+
+void FDMThread::restoreIntegrationState()
+{
+    if (!_displayApplied) {
+        return;
+    }
+
+    _displayApplied = false;
+    FGInterface::FlightState state = _impl->getState();
+    const FGInterface::FlightState& latest = _snapshots[_latest].state;
+
+    // only undo the display blend; a value the main thread set explicitly
+    // since (a reposition, for example) is kept
+    if (state.cartesian_position_v == _display.cartesian_position_v) {
+        state.cartesian_position_v = latest.cartesian_position_v;
+        state.geodetic_position_v = latest.geodetic_position_v;
+        state.geocentric_position_v = latest.geocentric_position_v;
+    }
+
+    if (state.euler_angles_v == _display.euler_angles_v) {
+        state.euler_angles_v = latest.euler_angles_v;
+    }
+
+    _impl->setState(state);
+}
+
+void FDMThread::applyDisplayState()
+{
+    restoreIntegrationState();
+    if (_snapshotCount < 2) {
+        return;
+    }
+
+    const Snapshot& previous = _snapshots[_latest ^ 1];
+    const Snapshot& current = _snapshots[_latest];
+    const double spanSec = (current.time - previous.time).toSecs();
+    if (spanSec <= 0.0) {
+        return;
+    }
+
+    FGInterface::FlightState state = _impl->getState();
+    if (!(state.cartesian_position_v == current.state.cartesian_position_v) ||
+        !(state.euler_angles_v == current.state.euler_angles_v)) {
+        return; // moved by the main thread, show that as-is
+    }
+
+    // display one iteration behind, so we always blend between two
+    // computed states rather than extrapolating
+    const double displayAgeSec = (SGTimeStamp::now() - previous.time).toSecs() - _dt;
+    const double t = SGMiscd::clip(displayAgeSec / spanSec, 0.0, 1.0);
+
+    const SGVec3d& p0 = previous.state.cartesian_position_v;
+    state.cartesian_position_v = p0 + t * (current.state.cartesian_position_v - p0);
+    state.geodetic_position_v = SGGeod::fromCart(state.cartesian_position_v);
+    state.geocentric_position_v = SGGeoc::fromCart(state.cartesian_position_v);
+
+    for (int i = 0; i < 3; ++i) {
+        const double a0 = previous.state.euler_angles_v[i];
+        const double delta = SGMiscd::normalizeAngle(current.state.euler_angles_v[i] - a0);
+        state.euler_angles_v[i] = a0 + t * delta;
+    }
+    state.euler_angles_v[0] = SGMiscd::normalizeAngle(state.euler_angles_v[0]);
+    state.euler_angles_v[2] = SGMiscd::normalizePeriodic(0.0, SGMiscd::twopi(), state.euler_angles_v[2]);
+
+    _impl->setState(state);
+    _display = state;
+    _displayApplied = true;
+}
+
+void FDMThread::updateStats(SGPropertyNode* stats)
+{
+    stats->setDoubleValue("rate-hz", 1.0 / _dt);
+    stats->setIntValue("ticks", static_cast<int>(_ticks));
+    stats->setIntValue("overruns", static_cast<int>(_overruns));
+    stats->setIntValue("skipped-ticks", static_cast<int>(_skippedTicks));
+    stats->setDoubleValue("jitter-ms", _jitterMs);
+    stats->setDoubleValue("max-jitter-ms", _maxJitterMs);
+    stats->setDoubleValue("iteration-ms", _iterationMs);
+    stats->setDoubleValue("max-iteration-ms", _maxIterationMs);
+    stats->setBoolValue("failed", _failed);
+}
@@ -0,0 +1,117 @@
+/*
+ * FDMThread.hxx
+ * run an FDM implementation on a dedicated fixed-rate thread
+ *
+ * SPDX-FileCopyrightText: 2026 FlightGear Developers
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+
+#include <simgear/props/props.hxx>
+#include <simgear/threads/SGThread.hxx>
+#include <simgear/timing/timestamp.hxx>
+
+#include "flight.hxx"
+
+/**
+ * Iterates an FGInterface at a fixed real-time rate, independent of the
+ * frame rate. Every access to the FDM, from this thread or the main thread,
+ * happens with the shared lock held; the main loop holds it while the
+ * subsystems update and during the event and update traversals, so the FDM
+ * runs concurrently with culling and drawing but never with code that reads
+ * or writes its properties, or changes the scene graph.
+ *
+ * The FDM never walks the scene itself: the main thread collects the ground
+ * cache far enough ahead of the aircraft, and the FDM only queries it.
+ *
+ * Environment inputs are handed over as a snapshot which is applied before
+ * each iteration. Outputs are the two most recent flight states, which the
+ * main thread blends to the frame time so displayed motion stays smooth
+ * even though iterations and frames are not aligned.
+ */
+class FDMThread : public SGThread
+{
+public:
+    struct Inputs {
+        double windNorthFps = 0.0;
+        double windEastFps = 0.0;
+        double windDownFps = 0.0;
+        bool controlAtmosphere = false;
+        double staticTemperatureR = 0.0;
+        double staticPressurePsf = 0.0;
+        double densitySlugFt3 = 0.0;
+
+        /// FDM iterations per tick (the sim speed-up); 0 while replaying
+        int iterations = 0;
+    };
+
+    FDMThread(FGInterface* impl, double dt, std::recursive_timed_mutex& lock,
+              SGPropertyNode* clockFreeze);
+    ~FDMThread();
+
+    /// ask the thread to exit and wait for it; safe with the lock held
+    void stop();
+
+    /// main thread, with the lock held: inputs for the following ticks
+    void setInputs(const Inputs& inputs);
+
+    /**
+     * Main thread, with the lock held: write a position and orientation
+     * interpolated between the last two iterations into the FDM, for display.
+     * The FDM's own state is restored before it next iterates.
+     */
+    void applyDisplayState();
+
+    /// main thread, with the lock held: publish timing statistics
+    void updateStats(SGPropertyNode* stats);
+
+    /// set if the FDM threw; the thread stops iterating
+    bool failed() const { return _failed; }
+
+protected:
+    void run() override;
+
+private:
+    bool waitForTick(const SGTimeStamp& deadline);
+    void iterate();
+    void restoreIntegrationState();
+
+    struct Snapshot {
+        FGInterface::FlightState state;
+        SGTimeStamp time;
+    };
+
+    FGInterface* _impl;
+    const double _dt;
+    std::recursive_timed_mutex& _lock;
+    // the FDM group is not updated at all while paused, so we check here
+    SGPropertyNode_ptr _clockFreeze;
+
+    std::mutex _stopMutex;
+    std::condition_variable _stopCondition;
+    bool _stop = false;
+
+    // everything below is guarded by _lock
+    Inputs _inputs;
+    bool _failed = false;
+
+    Snapshot _snapshots[2];
+    unsigned int _latest = 0;
+    unsigned int _snapshotCount = 0;
+
+    FGInterface::FlightState _display;
+    bool _displayApplied = false;
+
+    // statistics
+    unsigned long _ticks = 0;
+    unsigned long _overruns = 0;
+    unsigned long _skippedTicks = 0;
+    double _jitterMs = 0.0;
+    double _maxJitterMs = 0.0;
+    double _iterationMs = 0.0;
+    double _maxIterationMs = 0.0;
+};
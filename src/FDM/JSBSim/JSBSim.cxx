@@ -212,6 +212,9 @@ FGJSBsim::FGJSBsim( double dt )
 
     if (result) {
       SG_LOG( SG_FLIGHT, SG_INFO, "  loaded aero.");
+      // all the properties the aero functions read exist by now
+      if (fgGetBool("/sim/jsbsim/compile-functions", true))
+        Aerodynamics->CompileFunctions();
     } else {
       SG_LOG( SG_FLIGHT, SG_INFO,
               "  aero does not exist (you may have mis-typed the name).");
@@ -1300,6 +1303,7 @@ void FGJSBsim::do_trim(void)
     fgtrim = new FGTrim(fdmex,tFull);
   }
 
+  fgtrim->SetUseCache(fgGetBool("/sim/jsbsim/trim-cache", true));
   if ( !fgtrim->DoTrim() ) {
     fgtrim->Report();
     fgtrim->TrimStats();
@@ -42,6 +42,9 @@ INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 #include <iomanip>
+#include <map>
+#include <mutex>
+#include <tuple>
 #include "FGTrim.h"
 #include "models/FGInertial.h"
 #include "models/FGAccelerations.h"
@@ -56,6 +59,54 @@ using namespace std;
 
 namespace JSBSim {
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Converged trims, see FGTrim::SetUseCache(). The conditions are bucketed so
+// that a trim seeds the following ones in nearby conditions.
+
+namespace {
+
+struct TrimCacheKey {
+  string model;
+  TrimMode mode;
+  long weight;    // 2% steps
+  long altitude;  // 1000 ft steps
+  long speed;     // 10 kts steps
+
+  bool operator<(const TrimCacheKey& k) const {
+    return tie(model, mode, weight, altitude, speed)
+      < tie(k.model, k.mode, k.weight, k.altitude, k.speed);
+  }
+};
+
+struct TrimCacheEntry {
+  State state;
+  Control control;
+  double value;
+};
+
+mutex trimCacheMutex;
+map<TrimCacheKey, vector<TrimCacheEntry>> trimCache;
+
+TrimCacheKey makeTrimCacheKey(FGFDMExec* fdmex, const FGInitialCondition& ic,
+                              TrimMode mode)
+{
+  double weight = max(fdmex->GetMassBalance()->GetWeight(), 1.0);
+
+  return { fdmex->GetModelName(), mode, lround(log(weight)/log(1.02)),
+           lround(ic.GetAltitudeASLFtIC()/1000.0),
+           lround(ic.GetVcalibratedKtsIC()/10.0) };
+}
+
+} // namespace
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGTrim::ClearCache(void)
+{
+  lock_guard<mutex> lock(trimCacheMutex);
+  trimCache.clear();
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 FGTrim::FGTrim(FGFDMExec *FDMExec,TrimMode tt)
@@ -73,6 +124,7 @@ FGTrim::FGTrim(FGFDMExec *FDMExec,TrimMode tt)
   fgic = *fdmex->GetIC();
   total_its=0;
   gamma_fallback=false;
+  use_cache=false;
   mode=tt;
   xlo=xhi=alo=ahi=0.0;
   targetNlf=fgic.GetTargetNlfIC();
@@ -204,6 +256,15 @@ bool FGTrim::DoTrim(void) {
   fgic.SetQRadpsIC(0.0);
   fgic.SetRRadpsIC(0.0);
 
+  // The key is made before the trim changes the initial conditions.
+  TrimCacheKey cacheKey = makeTrimCacheKey(fdmex, fgic, mode);
+  vector<TrimCacheEntry> seed;
+  if (use_cache) {
+    lock_guard<mutex> lock(trimCacheMutex);
+    auto entry = trimCache.find(cacheKey);
+    if (entry != trimCache.end()) seed = entry->second;
+  }
+
   if (mode == tGround) {
     fdmex->Initialize(&fgic);
     fdmex->Run();
@@ -221,16 +282,33 @@ bool FGTrim::DoTrim(void) {
   for(unsigned int current_axis=0;current_axis<TrimAxes.size();current_axis++) {
     //cout << current_axis << "  " << TrimAxes[current_axis]->GetStateName()
     //<< "  " << TrimAxes[current_axis]->GetControlName()<< endl;
-    xlo=TrimAxes[current_axis].GetControlMin();
-    xhi=TrimAxes[current_axis].GetControlMax();
-    TrimAxes[current_axis].SetControl((xlo+xhi)/2);
-    TrimAxes[current_axis].Run();
+    FGTrimAxis& axis = TrimAxes[current_axis];
+    xlo=axis.GetControlMin();
+    xhi=axis.GetControlMax();
+    double control = (xlo+xhi)/2;
+    bool seeded = false;
+
+    // A remembered solution is close: search a small interval around it
+    // (findInterval) rather than the whole control range (checkLimits).
+    for (const auto& s: seed) {
+      if (s.state == axis.GetStateType() && s.control == axis.GetControlType()
+          && s.value >= xlo && s.value <= xhi) {
+        control = s.value;
+        seeded = true;
+      }
+    }
+
+    axis.SetControl(control);
+    axis.Run();
     //TrimAxes[current_axis].AxisReport();
     sub_iterations[current_axis]=0;
     successful[current_axis]=0;
-    solution[current_axis]=false;
+    solution[current_axis]=seeded;
   }
 
+  if (!seed.empty() && debug_lvl > 0)
+    cout << "  Trim seeded from an earlier trim" << endl;
+
   if(mode == tPullup ) {
     cout << "Setting pitch rate and nlf... " << endl;
     setupPullup();
@@ -312,6 +390,16 @@ bool FGTrim::DoTrim(void) {
     total_its=N;
     if (debug_lvl > 0)
         cout << endl << "  Trim successful" << endl;
+
+    if (use_cache) {
+      vector<TrimCacheEntry> entry;
+      for (auto& axis: TrimAxes)
+        entry.push_back({axis.GetStateType(), axis.GetControlType(),
+                         axis.GetControl()});
+
+      lock_guard<mutex> lock(trimCacheMutex);
+      trimCache[cacheKey] = entry;
+    }
   } else { // The trim has failed
     total_its=N;
 
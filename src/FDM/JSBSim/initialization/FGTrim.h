@@ -141,6 +141,7 @@ private:
   int debug_axis;
 
   double psidot;
+  bool use_cache;
 
   FGFDMExec* fdmex;
   FGInitialCondition fgic;
@@ -288,6 +289,17 @@ public:
   inline void SetTargetNlf(double nlf) { targetNlf=nlf; }
   inline double GetTargetNlf(void) { return targetNlf; }
 
+  /** Start from the controls of an earlier converged trim of the same model
+      in similar conditions (weight, altitude and calibrated airspeed within a
+      few percent, 1000 ft and 10 kts), and remember this trim if it
+      converges. The cache is shared by all the trims of the process.
+      @param cache true to use the cache (the default is false)
+  */
+  inline void SetUseCache(bool cache) { use_cache = cache; }
+
+  /// Forget all the trims remembered by SetUseCache().
+  static void ClearCache(void);
+
 };
 }
 
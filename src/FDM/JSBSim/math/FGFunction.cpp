@@ -78,9 +78,11 @@ class aFunc: public FGFunction
 public:
   aFunc(const func_t& _f, FGFDMExec* fdmex, Element* el,
         const string& prefix, FGPropertyValue* v, unsigned int Nmax=Nmin,
-        FGFunction::OddEven odd_even=FGFunction::OddEven::Either)
+        FGFunction::OddEven odd_even=FGFunction::OddEven::Either,
+        FGFunction::Kind _kind=FGFunction::Kind::Other)
     : FGFunction(fdmex->GetPropertyManager()), f(_f)
   {
+    kind = _kind;
     Load(el, v, fdmex, prefix);
     CheckMinArguments(el, Nmin);
     CheckMaxArguments(el, Nmax);
@@ -184,10 +186,12 @@ FGFunction* make_MathFn(double(*math_fn)(double), FGFDMExec* fdmex, Element* el,
 
 template<typename func_t>
 FGParameter_ptr VarArgsFn(const func_t& _f, FGFDMExec* fdmex, Element* el,
-                          const string& prefix, FGPropertyValue* v)
+                          const string& prefix, FGPropertyValue* v,
+                          FGFunction::Kind kind=FGFunction::Kind::Other)
 {
   try {
-    return new aFunc<func_t, 2>(_f, fdmex, el, prefix, v, MaxArgs);
+    return new aFunc<func_t, 2>(_f, fdmex, el, prefix, v, MaxArgs,
+                                FGFunction::OddEven::Either, kind);
   }
   catch(WrongNumberOfArguments& e) {
     if ((e.GetElement() == el) && (e.NumberOfArguments() == 1)) {
@@ -316,7 +320,7 @@ void FGFunction::Load(Element* el, FGPropertyValue* var, FGFDMExec* fdmex,
   auto sum = [](const decltype(Parameters)& Parameters)->double {
                double temp = 0.0;
 
-               for (auto p: Parameters)
+               for (const auto& p: Parameters)
                  temp += p->GetValue();
 
                return temp;
@@ -373,14 +377,16 @@ void FGFunction::Load(Element* el, FGPropertyValue* var, FGFDMExec* fdmex,
       auto f = [](const decltype(Parameters)& Parameters)->double {
                  double temp = 1.0;
 
-                 for (auto p: Parameters)
+                 for (const auto& p: Parameters)
                    temp *= p->GetValue();
 
                  return temp;
                };
-      Parameters.push_back(VarArgsFn<decltype(f)>(f, fdmex, element, Prefix, var));
+      Parameters.push_back(VarArgsFn<decltype(f)>(f, fdmex, element, Prefix, var,
+                                                  Kind::Product));
     } else if (operation == "sum") {
-      Parameters.push_back(VarArgsFn<decltype(sum)>(sum, fdmex, element, Prefix, var));
+      Parameters.push_back(VarArgsFn<decltype(sum)>(sum, fdmex, element, Prefix,
+                                                    var, Kind::Sum));
     } else if (operation == "avg") {
       auto avg = [&](const decltype(Parameters)& p)->double {
                    return sum(p) / p.size();
@@ -395,12 +401,13 @@ void FGFunction::Load(Element* el, FGPropertyValue* var, FGFDMExec* fdmex,
 
                  return temp;
                };
-      Parameters.push_back(VarArgsFn<decltype(f)>(f, fdmex, element, Prefix, var));
+      Parameters.push_back(VarArgsFn<decltype(f)>(f, fdmex, element, Prefix, var,
+                                                  Kind::Difference));
     } else if (operation == "min") {
       auto f = [](const decltype(Parameters)& Parameters)->double {
                  double _min = HUGE_VAL;
 
-                 for (auto p : Parameters) {
+                 for (const auto& p : Parameters) {
                    double x = p->GetValue();
                    if (x < _min)
                      _min = x;
@@ -413,7 +420,7 @@ void FGFunction::Load(Element* el, FGPropertyValue* var, FGFDMExec* fdmex,
       auto f = [](const decltype(Parameters)& Parameters)->double {
                  double _max = -HUGE_VAL;
 
-                 for (auto p : Parameters) {
+                 for (const auto& p : Parameters) {
                    double x = p->GetValue();
                    if (x > _max)
                      _max = x;
@@ -425,7 +432,7 @@ void FGFunction::Load(Element* el, FGPropertyValue* var, FGFDMExec* fdmex,
     } else if (operation == "and") {
       string ctxMsg = element->ReadFrom();
       auto f = [ctxMsg](const decltype(Parameters)& Parameters)->double {
-                 for (auto p : Parameters) {
+                 for (const auto& p : Parameters) {
                    if (!GetBinary(p->GetValue(), ctxMsg)) // As soon as one parameter is false, the expression is guaranteed to be false.
                      return 0.0;
                  }
@@ -437,7 +444,7 @@ void FGFunction::Load(Element* el, FGPropertyValue* var, FGFDMExec* fdmex,
     } else if (operation == "or") {
       string ctxMsg = element->ReadFrom();
       auto f = [ctxMsg](const decltype(Parameters)& Parameters)->double {
-                 for (auto p : Parameters) {
+                 for (const auto& p : Parameters) {
                    if (GetBinary(p->GetValue(), ctxMsg)) // As soon as one parameter is true, the expression is guaranteed to be true.
                      return 1.0;
                  }
@@ -451,7 +458,9 @@ void FGFunction::Load(Element* el, FGPropertyValue* var, FGFDMExec* fdmex,
                  double y = p[1]->GetValue();
                  return y != 0.0 ? p[0]->GetValue()/y : HUGE_VAL;
                };
-      Parameters.push_back(new aFunc<decltype(f), 2>(f, fdmex, element, Prefix, var));
+      Parameters.push_back(new aFunc<decltype(f), 2>(f, fdmex, element, Prefix,
+                                                     var, 2, OddEven::Either,
+                                                     Kind::Quotient));
     } else if (operation == "pow") {
       auto f = [](const decltype(Parameters)& p)->double {
                  return pow(p[0]->GetValue(), p[1]->GetValue());
@@ -900,7 +909,7 @@ FGFunction::~FGFunction()
 
 bool FGFunction::IsConstant(void) const
 {
-  for (auto p: Parameters) {
+  for (const auto& p: Parameters) {
     if (!p->IsConstant())
       return false;
   }
@@ -910,6 +919,17 @@ bool FGFunction::IsConstant(void) const
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGFunction::Compile(void)
+{
+  Program.reset(new FGFunctionProgram(Parameters[0]));
+
+  // Nothing to gain if the whole tree ends up as a single call.
+  if (Program->GetSize() == Program->GetNumCalls())
+    Program.reset();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 void FGFunction::cacheValue(bool cache)
 {
   cached = false; // Must set cached to false prior to calling GetValue(), else
@@ -926,7 +946,7 @@ double FGFunction::GetValue(void) const
 {
   if (cached) return cachedValue;
 
-  double val = Parameters[0]->GetValue();
+  double val = Program ? Program->Evaluate() : Parameters[0]->GetValue();
 
   if (pCopyTo) pCopyTo->setDoubleValue(val);
 
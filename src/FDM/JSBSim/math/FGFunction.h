@@ -34,7 +34,10 @@ SENTRY
 INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
+#include <memory>
+
 #include "FGParameter.h"
+#include "FGFunctionProgram.h"
 #include "input_output/FGPropertyManager.h"
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -754,7 +757,7 @@ class FGFunction : public FGParameter, public FGJSBBase
 public:
   /// Default constructor.
   FGFunction()
-    : cached(false), cachedValue(-HUGE_VAL), PropertyManager(nullptr),
+    : kind(Kind::Other), cached(false), cachedValue(-HUGE_VAL), PropertyManager(nullptr),
       pNode(nullptr), pCopyTo(nullptr) {}
 
   explicit FGFunction(FGPropertyManager* pm)
@@ -811,9 +814,22 @@ public:
     value. */
   void cacheValue(bool shouldCache);
 
+/** Flattens the function into a linear program (see FGFunctionProgram) which
+    is then used by GetValue(). The result is unchanged, only the cost of
+    walking the tree is saved. Properties that are not bound yet are left to
+    the tree, so this is best called once the whole model is loaded. */
+  void Compile(void);
+
   enum class OddEven {Either, Odd, Even};
 
+  /// The arithmetic operations that FGFunctionProgram evaluates in place.
+  enum class Kind {Other, Sum, Product, Difference, Quotient};
+  Kind GetKind(void) const {return kind;}
+  const std::vector<FGParameter_ptr>& GetParameters(void) const
+  {return Parameters;}
+
 protected:
+  Kind kind;
   bool cached;
   double cachedValue;
   std::vector <FGParameter_ptr> Parameters;
@@ -831,6 +847,7 @@ protected:
 private:
   std::string Name;
   FGPropertyNode_ptr pCopyTo; // Property node for CopyTo property string
+  std::unique_ptr<FGFunctionProgram> Program;
 
   void Debug(int from);
 };
@@ -0,0 +1,201 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module: FGFunctionProgram.cpp
+Date started: October 2026
+Purpose: Flattened evaluation of function trees
+
+ ------------- Copyright (C) 2026  The FlightGear developers -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or (at your option) any
+ later version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along
+ with this program; if not, write to the Free Software Foundation, Inc., 59
+ Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be
+ found on the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cmath>
+#include <typeinfo>
+
+#include "FGFunctionProgram.h"
+#include "FGFunction.h"
+#include "FGPropertyValue.h"
+#include "FGRealValue.h"
+
+using namespace std;
+
+namespace JSBSim {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+FGFunctionProgram::FGFunctionProgram(const FGParameter* root)
+  : depth(0), maxDepth(0)
+{
+  Emit(root);
+  Stack.resize(maxDepth);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFunctionProgram::Push(OpCode op, unsigned int count, double value,
+                             FGPropertyNode* node, const FGParameter* param)
+{
+  Code.push_back({op, count, value, node, param});
+
+  // Each instruction pops its operands and pushes one result.
+  depth = depth - count + 1;
+  if (depth > maxDepth) maxDepth = depth;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFunctionProgram::Emit(const FGParameter* p)
+{
+  if (typeid(*p) == typeid(FGRealValue)) {
+    Push(OpCode::Const, 0, p->GetValue());
+    return;
+  }
+
+  // The exact type only: FGFunctionValue also applies a template function.
+  if (typeid(*p) == typeid(FGPropertyValue)) {
+    auto v = static_cast<const FGPropertyValue*>(p);
+    // A late bound property is left to bind itself when it is first read.
+    if (!v->IsLateBound()) {
+      Push(OpCode::Node, 0, v->GetSign(), v->GetBoundNode());
+      return;
+    }
+  }
+
+  auto f = dynamic_cast<const FGFunction*>(p);
+  if (f) {
+    const auto& args = f->GetParameters();
+
+    switch (f->GetKind()) {
+    case FGFunction::Kind::Sum:
+      for (const auto& a: args) Emit(a);
+      Push(OpCode::Sum, args.size());
+      return;
+    case FGFunction::Kind::Product:
+      for (const auto& a: args) Emit(a);
+      Push(OpCode::Product, args.size());
+      return;
+    case FGFunction::Kind::Difference:
+      for (const auto& a: args) Emit(a);
+      Push(OpCode::Difference, args.size());
+      return;
+    case FGFunction::Kind::Quotient:
+      {
+        // <quotient> evaluates its denominator first, and its numerator only
+        // if the denominator is not zero.
+        Emit(args[1]);
+        size_t skip = Code.size();
+        Code.push_back({OpCode::SkipIfZero, 0, 0.0, nullptr, nullptr});
+        Emit(args[0]);
+        Push(OpCode::Quotient, 2);
+        Code[skip].count = Code.size() - 1;
+      }
+      return;
+    default:
+      break;
+    }
+  }
+
+  Push(OpCode::Param, 0, 0.0, nullptr, p);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+size_t FGFunctionProgram::GetNumCalls(void) const
+{
+  size_t n = 0;
+
+  for (const auto& i: Code) {
+    if (i.op == OpCode::Param) n++;
+  }
+
+  return n;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGFunctionProgram::Evaluate(void) const
+{
+  double* sp = Stack.data();
+  const Instruction* code = Code.data();
+  const Instruction* end = code + Code.size();
+
+  // The accumulations start from the same values and run in the same order as
+  // in FGFunction so that the results are identical.
+  for (const Instruction* pc = code; pc != end; ++pc) {
+    const Instruction& i = *pc;
+    switch (i.op) {
+    case OpCode::Const:
+      *sp++ = i.value;
+      break;
+    case OpCode::Node:
+      *sp++ = i.node->getDoubleValue()*i.value;
+      break;
+    case OpCode::Param:
+      *sp++ = i.param->GetValue();
+      break;
+    case OpCode::Sum:
+      {
+        sp -= i.count;
+        double temp = 0.0;
+        for (unsigned int k=0; k<i.count; k++) temp += sp[k];
+        *sp++ = temp;
+      }
+      break;
+    case OpCode::Product:
+      {
+        sp -= i.count;
+        double temp = 1.0;
+        for (unsigned int k=0; k<i.count; k++) temp *= sp[k];
+        *sp++ = temp;
+      }
+      break;
+    case OpCode::Difference:
+      {
+        sp -= i.count;
+        double temp = sp[0];
+        for (unsigned int k=1; k<i.count; k++) temp -= sp[k];
+        *sp++ = temp;
+      }
+      break;
+    case OpCode::SkipIfZero:
+      // The denominator stays on the stack for the quotient, or is replaced
+      // by its result without evaluating the numerator.
+      if (sp[-1] == 0.0) {
+        sp[-1] = HUGE_VAL;
+        pc = code + i.count;
+      }
+      break;
+    case OpCode::Quotient:
+      {
+        double x = *--sp;
+        double y = *--sp;
+        *sp++ = x/y;
+      }
+      break;
+    }
+  }
+
+  return Stack[0];
+}
+
+} // namespace JSBSim
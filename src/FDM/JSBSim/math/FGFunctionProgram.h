@@ -0,0 +1,102 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header: FGFunctionProgram.h
+Date started: October 2026
+
+ ------------- Copyright (C) 2026  The FlightGear developers -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or (at your option) any
+ later version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along
+ with this program; if not, write to the Free Software Foundation, Inc., 59
+ Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be
+ found on the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGFUNCTIONPROGRAM_H
+#define FGFUNCTIONPROGRAM_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <vector>
+
+#include "FGParameter.h"
+#include "input_output/FGPropertyManager.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** A function tree flattened into a linear stack program.
+    Constants, bound properties and the sum, product, difference and quotient
+    operations are evaluated in place, without a virtual call per node. Any
+    other parameter (tables, trigonometric functions, conditions, ...) is kept
+    as a single instruction that calls its GetValue() method, so the program
+    always computes exactly what the tree would have, in the same order. Like
+    <quotient>, the program skips the numerator when the denominator is zero.
+
+    The program refers to the nodes of the tree it was built from, which must
+    therefore outlive it.
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DECLARATION: FGFunctionProgram
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGFunctionProgram
+{
+public:
+  explicit FGFunctionProgram(const FGParameter* root);
+
+  double Evaluate(void) const;
+
+  /// Number of instructions, and how many of them call back into the tree.
+  size_t GetSize(void) const {return Code.size();}
+  size_t GetNumCalls(void) const;
+
+private:
+  enum class OpCode {Const, Node, Param, Sum, Product, Difference,
+                     SkipIfZero, Quotient};
+
+  struct Instruction {
+    OpCode op;
+    unsigned int count;         // operands of Sum, Product and Difference, or
+                                // the Quotient that SkipIfZero jumps past
+    double value;               // Const, or the sign of a Node
+    FGPropertyNode* node;
+    const FGParameter* param;
+  };
+
+  std::vector<Instruction> Code;
+  mutable std::vector<double> Stack;
+  unsigned int depth, maxDepth;
+
+  void Emit(const FGParameter* p);
+  void Push(OpCode op, unsigned int count, double value=0.0,
+            FGPropertyNode* node=nullptr, const FGParameter* param=nullptr);
+};
+
+} // namespace JSBSim
+
+#endif
@@ -73,6 +73,9 @@ public:
   void SetNode(FGPropertyNode* node) {PropertyNode = node;}
   void SetValue(double value);
   bool IsLateBound(void) const { return PropertyNode == nullptr; }
+  /// The node once bound (nullptr before), and the sign applied to its value.
+  FGPropertyNode* GetBoundNode(void) const { return PropertyNode.ptr(); }
+  double GetSign(void) const { return Sign; }
 
   std::string GetName(void) const override;
   virtual std::string GetNameWithSign(void) const;
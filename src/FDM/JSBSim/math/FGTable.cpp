@@ -105,6 +105,34 @@ FGTable::FGTable(const FGTable& t) : PropertyManager(t.PropertyManager)
   lastRowIndex = t.lastRowIndex;
   lastColumnIndex = t.lastColumnIndex;
   lastTableIndex = t.lastTableIndex;
+  for (int a=0; a<2; a++) {
+    uniform[a] = t.uniform[a];
+    uniformStart[a] = t.uniformStart[a];
+    uniformInvStep[a] = t.uniformInvStep[a];
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// Are the keys evenly spaced? The interval index computed from the spacing
+// is only a starting point for the usual search, so a small tolerance is fine.
+
+static bool FindUniformSpacing(const vector<double>& keys, double& start,
+                               double& invStep)
+{
+  size_t n = keys.size();
+  if (n < 3) return false;
+
+  double step = (keys[n-1] - keys[0]) / (n-1);
+  if (step <= 0.0) return false;
+
+  for (size_t i=1; i<n-1; i++) {
+    if (fabs(keys[i] - (keys[0] + i*step)) > 1E-6*step) return false;
+  }
+
+  start = keys[0];
+  invStep = 1.0/step;
+  return true;
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -375,6 +403,8 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el,
     }
   }
 
+  DetectUniformSpacing();
+
   bind(el, Prefix);
 
   if (debug_lvl & 1) Print();
@@ -382,6 +412,26 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el,
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGTable::DetectUniformSpacing(void)
+{
+  vector<double> keys;
+
+  // Row keys are in the first column, 3D breakpoints in the second one.
+  unsigned int keyCol = Type == tt3D ? 1 : 0;
+  for (unsigned int r=1; r<=nRows; r++) keys.push_back(Data[r][keyCol]);
+  uniform[eRow] = FindUniformSpacing(keys, uniformStart[eRow],
+                                     uniformInvStep[eRow]);
+
+  keys.clear();
+  if (Type == tt2D) {
+    for (unsigned int c=1; c<=nCols; c++) keys.push_back(Data[0][c]);
+  }
+  uniform[eColumn] = FindUniformSpacing(keys, uniformStart[eColumn],
+                                        uniformInvStep[eColumn]);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 double** FGTable::Allocate(void)
 {
   Data = new double*[nRows+1];
@@ -453,7 +503,7 @@ double FGTable::GetValue(void) const
 double FGTable::GetValue(double key) const
 {
   double Factor, Value, Span;
-  unsigned int r = lastRowIndex;
+  unsigned int r = StartIndex(eRow, key, nRows, lastRowIndex);
 
   //if the key is off the end of the table, just return the
   //end-of-table value, do not extrapolate
@@ -496,8 +546,8 @@ double FGTable::GetValue(double key) const
 double FGTable::GetValue(double rowKey, double colKey) const
 {
   double rFactor, cFactor, col1temp, col2temp, Value;
-  unsigned int r = lastRowIndex;
-  unsigned int c = lastColumnIndex;
+  unsigned int r = StartIndex(eRow, rowKey, nRows, lastRowIndex);
+  unsigned int c = StartIndex(eColumn, colKey, nCols, lastColumnIndex);
 
   while(r > 2     && Data[r-1][0] > rowKey) { r--; }
   while(r < nRows && Data[r]  [0] < rowKey) { r++; }
@@ -530,7 +580,7 @@ double FGTable::GetValue(double rowKey, double colKey) const
 double FGTable::GetValue(double rowKey, double colKey, double tableKey) const
 {
   double Factor, Value, Span;
-  unsigned int r = lastRowIndex;
+  unsigned int r = StartIndex(eRow, tableKey, nRows, lastRowIndex);
 
   //if the key is off the end  (or before the beginning) of the table,
   // just return the boundary-table value, do not extrapolate
@@ -300,7 +300,20 @@ private:
   unsigned int nRows, nCols, nTables, dimension;
   int colCounter, rowCounter, tableCounter;
   mutable int lastRowIndex, lastColumnIndex, lastTableIndex;
+  // Evenly spaced row (or 3D breakpoint) and column keys, see
+  // DetectUniformSpacing(): the interval is computed instead of searched.
+  bool uniform[2] = {false, false};
+  double uniformStart[2] = {0.0, 0.0};
+  double uniformInvStep[2] = {0.0, 0.0};
   double** Allocate(void);
+  void DetectUniformSpacing(void);
+  unsigned int StartIndex(axis a, double key, unsigned int n, int last) const {
+    if (!uniform[a]) return last;
+    double x = (key - uniformStart[a])*uniformInvStep[a];
+    if (!(x >= 0.0)) return 2;
+    if (x >= n - 1) return n;
+    return static_cast<unsigned int>(x) + 2;
+  }
   FGPropertyManager* const PropertyManager;
   std::string Name;
   void bind(Element* el, const std::string& Prefix);
@@ -546,6 +546,16 @@ string FGAerodynamics::GetAeroFunctionStrings(const string& delimeter) const
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGAerodynamics::CompileFunctions(void)
+{
+  for (unsigned int axis = 0; axis < 6; axis++) {
+    for (auto f: AeroFunctions[axis]) f->Compile();
+    for (auto f: AeroFunctionsAtCG[axis]) f->Compile();
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 string FGAerodynamics::GetAeroFunctionValues(const string& delimeter) const
 {
   ostringstream buf;
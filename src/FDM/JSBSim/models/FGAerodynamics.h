@@ -215,6 +215,10 @@ public:
 
     std::vector<FGFunction*>* GetAeroFunctions(void) const { return AeroFunctions; }
 
+    /** Flattens all the aero functions, see FGFunction::Compile().
+        Should be called once the whole model has been loaded. */
+    void CompileFunctions(void);
+
     struct Inputs {
         double Alpha;
         double Beta;
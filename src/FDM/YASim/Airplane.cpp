@@ -2,6 +2,13 @@
 #  include "config.h"
 #endif
 
+#include <iomanip>
+#include <sstream>
+
+#include <simgear/debug/logstream.hxx>
+#include <simgear/io/iostreams/sgstream.hxx>
+#include <simgear/misc/strutils.hxx>
+
 #include "Atmosphere.hpp"
 #include "ControlMap.hpp"
 #include "Gear.hpp"
@@ -624,7 +631,15 @@ void Airplane::compile(bool verbose)
     solveGear();
     calculateCGHardLimits();
     
-    if(_wing && _tail) solveAirplane(verbose);
+    _solutionCached = false;
+    if(_wing && _tail) {
+        if (loadSolution()) {
+            _solutionCached = true;
+        } else {
+            solveAirplane(verbose);
+            saveSolution();
+        }
+    }
     else
     {
        // The rotor(s) mass:
@@ -635,6 +650,9 @@ void Airplane::compile(bool verbose)
     // Do this after solveGear, because it creates "gear" objects that
     // we don't want to affect.
     compileContactPoints();
+
+    // The surface coefficients are final now
+    _model.compileSurfaces();
 }
 
 void Airplane::solveGear()
@@ -747,6 +765,14 @@ void Airplane::setControlValues(const Vector& controls)
     _controlMap.applyControls(); 
 }
 
+void Airplane::setNeutralControls()
+{
+    Vector controls;
+    if (_tailIncidence != nullptr)
+        controls.add(_tailIncidence);
+    setControlValues(controls);
+}
+
 void Airplane::runConfig(Config &cfg)
 {
     // aoa is consider to be given for approach so we calculate orientation 
@@ -790,6 +816,11 @@ void Airplane::applyDragFactor(float factor)
 {
     float applied = Math::pow(factor, _solverDelta);
     _dragFactor *= applied;
+    scaleDragCoefficients(applied);
+}
+
+void Airplane::scaleDragCoefficients(float applied)
+{
     if(_wing)
       _wing->multiplyDragCoefficient(applied);
     if(_tail)
@@ -836,6 +867,11 @@ void Airplane::applyLiftRatio(float factor)
 {
     float applied = Math::pow(factor, _solverDelta);
     _liftRatio *= applied;
+    scaleLiftCoefficients(applied);
+}
+
+void Airplane::scaleLiftCoefficients(float applied)
+{
     if(_wing)
       _wing->multiplyLiftRatio(applied);
     if(_tail)
@@ -886,11 +922,10 @@ float Airplane::_getDragForce(Config &cfg)
 // problems. To be replaced by a better solution later.
 float Airplane::_checkConvergence(float prev, float current)
 {
-    static int damping {0};
     //different sign and almost same value -> oscilation; 
     if ((prev*current) < 0 && (abs(current + prev) < 0.01f)) {
-        if (!damping) fprintf(stderr,"YASim warning: possible convergence problem.\n");
-        damping++;
+        if (!_convergenceDamping) fprintf(stderr,"YASim warning: possible convergence problem.\n");
+        _convergenceDamping++;
         if (current < 1) current *= abs(current); // quadratic
         else current = sqrt(current);
     }
@@ -905,16 +940,7 @@ void Airplane::solveAirplane(bool verbose)
     _solutionIterations = 0;
     _failureMsg = 0;
 
-    if (_approachElevator == nullptr) {
-        setElevatorControl("/controls/flight/elevator-trim");
-    }
-
-    if (_tailIncidence == nullptr) {
-        // no control mapping from XML parser, so we just create "local" 
-        // variables for solver instead of full mapping / property
-        _tailIncidence = new ControlSetting;
-        _tailIncidenceCopy = new ControlSetting;
-    }
+    setupSolverControls();
 
     if (verbose) {
         fprintf(stdout,"i\tdAoa\tdTail\tcl0\tcp1\n");
@@ -1044,6 +1070,26 @@ void Airplane::solveAirplane(bool verbose)
         }
     }
 
+    checkSolution();
+}
+
+void Airplane::setupSolverControls()
+{
+    if (_approachElevator == nullptr) {
+        setElevatorControl("/controls/flight/elevator-trim");
+    }
+
+    if (_tailIncidence == nullptr) {
+        // no control mapping from XML parser, so we just create "local" 
+        // variables for solver instead of full mapping / property
+        _tailIncidence = new ControlSetting;
+        _tailIncidenceCopy = new ControlSetting;
+    }
+}
+
+/// Sanity checks on the solution, and export of the results
+void Airplane::checkSolution()
+{
     if(_dragFactor < 1e-06 || _dragFactor > 1e6) {
         _failureMsg = "Drag factor beyond reasonable bounds.";
         return;
@@ -1065,6 +1111,113 @@ void Airplane::solveAirplane(bool verbose)
     }
 }
 
+void Airplane::setSolutionCache(const SGPath& dir, const std::string& modelKey)
+{
+    _solutionCacheDir = dir;
+    _modelKey = modelKey;
+}
+
+std::string Airplane::solutionModelKey(const SGPath& xml)
+{
+    sg_ifstream in(xml, std::ios::in | std::ios::binary);
+    if (!in)
+        return std::string();
+
+    std::ostringstream content;
+    content << in.rdbuf();
+    return simgear::strutils::md5(content.str());
+}
+
+/// Everything the solution depends on besides the model definition
+std::string Airplane::solutionCacheKey() const
+{
+    std::ostringstream key;
+    key << "yasim-solution-" << solverVersion << " " << _modelKey
+        << " v" << getVersion()
+        << " mode " << _solverMode
+        << std::setprecision(9)
+        << " delta " << _solverDelta
+        << " threshold " << _solverThreshold
+        << " max-iterations " << _solverMaxIterations;
+    return key.str();
+}
+
+SGPath Airplane::solutionCachePath() const
+{
+    return _solutionCacheDir / (simgear::strutils::md5(solutionCacheKey()) + ".txt");
+}
+
+/// Restore the results of an earlier solveAirplane() for the same model.
+/// Returns false, leaving everything untouched, if there are none.
+bool Airplane::loadSolution()
+{
+    if (_solutionCacheDir.isNull() || _modelKey.empty())
+        return false;
+
+    SGPath path = solutionCachePath();
+    if (!path.exists())
+        return false;
+
+    sg_ifstream in(path);
+    std::string key;
+    float dragFactor, liftRatio, aoa, tailIncidence, elevator;
+    int iterations;
+    std::getline(in, key);
+    in >> dragFactor >> liftRatio >> aoa >> tailIncidence >> elevator >> iterations;
+    if (!in || key != solutionCacheKey()) {
+        SG_LOG(SG_FLIGHT, SG_INFO, "YASim: ignoring stale solution cache " << path);
+        return false;
+    }
+
+    _failureMsg = 0;
+    setupSolverControls();
+    _solutionIterations = iterations;
+    _dragFactor = dragFactor;
+    _liftRatio = liftRatio;
+    scaleDragCoefficients(dragFactor);
+    scaleLiftCoefficients(liftRatio);
+    _config[CRUISE].aoa = aoa;
+    _tailIncidenceCopy->val = _tailIncidence->val = tailIncidence;
+    _tail->setIncidence(tailIncidence);
+    _approachElevator->val = elevator;
+
+    // leave the model as the solver would
+    runConfig(_config[APPROACH]);
+    checkSolution();
+
+    SG_LOG(SG_FLIGHT, SG_INFO, "YASim: using cached solution " << path);
+    return true;
+}
+
+void Airplane::saveSolution() const
+{
+    if (_solutionCacheDir.isNull() || _modelKey.empty() || _failureMsg)
+        return;
+
+    // write and rename, so a reader never sees a partial file
+    SGPath path = solutionCachePath();
+    path.create_dir(0755); // creates the parent directories
+    SGPath tmp = path;
+    tmp.concat(".tmp");
+    {
+        sg_ofstream out(tmp);
+        // 9 significant digits restore a float exactly
+        out << solutionCacheKey() << "\n" << std::setprecision(9)
+            << _dragFactor << "\n" << _liftRatio << "\n"
+            << _config[CRUISE].aoa << "\n" << _tailIncidence->val << "\n"
+            << _approachElevator->val << "\n"
+            << _solutionIterations << "\n";
+        if (!out) {
+            SG_LOG(SG_FLIGHT, SG_WARN, "YASim: failed to write solution cache " << tmp);
+            return;
+        }
+    }
+    if (!tmp.rename(path)) {
+        SG_LOG(SG_FLIGHT, SG_WARN, "YASim: failed to write solution cache " << path);
+        tmp.remove();
+    }
+}
+
 void Airplane::solveHelicopter(bool verbose)
 {
     _solutionIterations = 0;
@@ -7,6 +7,7 @@
 #include "Vector.hpp"
 #include "Version.hpp"
 #include <simgear/props/props.hxx>
+#include <simgear/misc/sg_path.hxx>
 
 namespace yasim {
 
@@ -62,6 +63,7 @@ public:
 
     int  addWeight(const float* pos, float size);
     void setWeight(int handle, float mass);
+    int  numWeights() const { return _weights.size(); }
 
     void setConfig(Configuration cfg, float speed, float altitude, float fuel, 
                    float gla = 0, float aoa = 0);
@@ -95,6 +97,13 @@ public:
     float getTankCapacity(int tank) const { return ((Tank*)_tanks.get(tank))->cap; }
 
     void compile(bool verbose = false); // generate point masses & such, then solve
+    /// Keep solver results in dir and reuse them in later compile() runs.
+    /// modelKey must identify the model definition, e.g. a hash of its XML.
+    void setSolutionCache(const SGPath& dir, const std::string& modelKey);
+    /// a modelKey for an aircraft definition file; empty if it can't be read
+    static std::string solutionModelKey(const SGPath& xml);
+    /// true if the last compile() used a cached solution
+    bool isSolutionCached() const { return _solutionCached; }
     void initEngines();
     void stabilizeThrust();
 
@@ -111,6 +120,10 @@ public:
     // next two are used only in yasim CLI tool
     void setApproachControls() { setControlValues(_config[APPROACH].controls); }
     void setCruiseControls() { setControlValues(_config[CRUISE].controls); }
+    /// all control inputs zero except the solved stabilizer trim (yasim-sweep)
+    void setNeutralControls();
+    /// the control input the solver trims the approach with, -1 if none
+    int getElevatorInputHandle() const { return _approachElevator ? _approachElevator->propHandle : -1; }
     
     float getCGHardLimitXMin() const { return _cgMin; } // get min x-coordinate for c.g (from main gear)
     float getCGHardLimitXMax() const { return _cgMax; } // get max x-coordinate for c.g (from nose gear)
@@ -137,6 +150,11 @@ public:
     void  setSolverThreshold(float threshold) { _solverThreshold = threshold; };
     void  setSolverMaxIterations(int i) { _solverMaxIterations = i; };
     void  setSolverMode(int i) { _solverMode = i; };
+
+    /// Increase whenever solveAirplane() or solveHelicopter() can give
+    /// different results for the same input; cached solutions of an older
+    /// solver are ignored.
+    static const int solverVersion {2};
     
 private:
     struct Tank { 
@@ -207,6 +225,14 @@ private:
     void compileGear(GearRec* gr);
     void applyDragFactor(float factor);
     void applyLiftRatio(float factor);
+    void scaleDragCoefficients(float applied);
+    void scaleLiftCoefficients(float applied);
+    void setupSolverControls();
+    void checkSolution();
+    std::string solutionCacheKey() const;
+    SGPath solutionCachePath() const;
+    bool loadSolution();
+    void saveSolution() const;
     void addContactPoint(const float* pos);
     void compileContactPoints();
     float normFactor(float f);
@@ -255,6 +281,7 @@ private:
     Vector _solveWeights;
 
     int _solutionIterations {0};
+    int _convergenceDamping {0}; // see _checkConvergence()
     float _dragFactor {1};
     float _liftRatio {1};
     ControlSetting* _tailIncidence {nullptr}; // added to approach config so solver can change it
@@ -262,6 +289,9 @@ private:
     ControlSetting* _tailIncidenceCopy {nullptr}; 
     ControlSetting* _approachElevator {nullptr};
     const char* _failureMsg {0};
+    SGPath _solutionCacheDir;
+    std::string _modelKey;
+    bool _solutionCached {false};
     /// hard limits for cg from gear position
     float _cgMax {-1e6};         
     /// hard limits for cg from gear position
@@ -51,6 +51,28 @@ void FGGround::getGroundPlane(const double pos[3],
     for(int i=0; i<3; i++) vel[i] = dvel[i];
 }
 
+void FGGround::getGroundPlanes(Query* queries, int count)
+{
+    _queries.resize(count);
+    for(int i=0; i<count; i++)
+        _queries[i].pt = SGVec3d(queries[i].pos);
+
+    _iface->get_agl_m(_toff, 2, _queries.data(), count);
+
+    for(int i=0; i<count; i++) {
+        const FGGroundCache::AglQuery& aq = _queries[i];
+        Query& q = queries[i];
+        for(int j=0; j<3; j++) {
+            q.plane[j] = aq.normal[j];
+            q.vel[j] = aq.linearVel[j];
+        }
+        // The plane below the actual contact point.
+        q.plane[3] = dot(aq.normal, aq.contact);
+        q.material = aq.material;
+        q.body = aq.id;
+    }
+}
+
 bool FGGround::getBody(double t, double bodyToWorld[16], double linearVel[3],
                        double angularVel[3], unsigned int &body)
 {
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <vector>
+
+#include <FDM/groundcache.hxx>
+
 #include "Ground.hpp"
 
 class FGInterface;
@@ -26,6 +30,8 @@ public:
                                 const simgear::BVHMaterial **material,
                                 unsigned int &body) override;
 
+    void getGroundPlanes(Query* queries, int count) override;
+
     bool getBody(double t, double bodyToWorld[16], double linearVel[3],
                          double angularVel[3], unsigned int &id) override;
 
@@ -43,6 +49,7 @@ public:
 private:
     FGInterface *_iface;
     double _toff;
+    std::vector<FGGroundCache::AglQuery> _queries;
 };
 
 }; // namespace yasim
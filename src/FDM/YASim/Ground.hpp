@@ -7,6 +7,15 @@ namespace yasim {
 
 class Ground {
 public:
+    // One point of a batched ground plane query, pos is the input
+    struct Query {
+        double pos[3];
+        double plane[4];
+        float vel[3];
+        const simgear::BVHMaterial* material;
+        unsigned int body;
+    };
+
     virtual ~Ground() = default;
 
     virtual void getGroundPlane(const double pos[3],
@@ -18,6 +27,10 @@ public:
                                 const simgear::BVHMaterial **material,
                                 unsigned int &body);
 
+    // The ground planes below several points, typically all contacts
+    // of one step.  The default asks for each point in turn.
+    virtual void getGroundPlanes(Query* queries, int count);
+
    virtual bool getBody(double t, double bodyToWorld[16], double linearVel[3],
                         double angularVel[3], unsigned int &id);
 
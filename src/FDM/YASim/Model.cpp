@@ -167,7 +167,70 @@ void Model::iterate()
     initIteration();
     initRotorIteration();
     _body.recalc(); // FIXME: amortize this, somehow
+    // Re-pack the batch if a surface changed since compileSurfaces()
+    // (gear extension, dropped stores)
+    if (_surfaceBatch.size() > 0 && !_surfaceBatch.isCurrent(_surfaces))
+        compileSurfaces();
     _integrator.calcNewInterval();
+    if (useSurfaceBatch())
+        _surfaceBatch.exportResults();
+}
+
+bool Model::useSurfaceBatch() const
+{
+    // Before compileSurfaces(), or if surfaces were added or changed
+    // since and iterate() has not re-packed them yet, fall back to the
+    // scalar path.
+    return !_scalarSurfaces && !_surfaces.empty()
+        && _surfaceBatch.isCurrent(_surfaces);
+}
+
+// Batched equivalent of the per-surface loop in calcForces().
+void Model::calcSurfaceForces(State* s, float alt, float* faero)
+{
+    _surfaceBatch.syncControls();
+
+    float vs[3] {0,0,0}, pos[3] {0,0,0};
+    localWind(pos, s, vs, alt);
+    float mach = _atmo.machFromSpeed(Math::mag3(vs));
+
+    const int n = _surfaceBatch.size();
+    const float* px = _surfaceBatch.posX();
+    const float* py = _surfaceBatch.posY();
+    const float* pz = _surfaceBatch.posZ();
+    float* vx = _surfaceBatch.windX();
+    float* vy = _surfaceBatch.windY();
+    float* vz = _surfaceBatch.windZ();
+
+    if (_turb || _rotorgear.isInUse()) {
+        // turbulence and downwash vary with position in ways we can't
+        // factor out
+        for (int j=0; j<n; j++) {
+            pos[0] = px[j]; pos[1] = py[j]; pos[2] = pz[j];
+            localWind(pos, s, vs, alt);
+            vx[j] = vs[0]; vy[j] = vs[1]; vz[j] = vs[2];
+        }
+    } else {
+        // Otherwise the wind is the wind at the origin (vs, from
+        // above) less the rotational velocity rot x pos.  See
+        // localWind() and RigidBody::pointVelocity().
+        float lrot[3];
+        Math::vmul33(s->orient, s->rot, lrot);
+        for (int j=0; j<n; j++) {
+            vx[j] = vs[0] - (lrot[1]*pz[j] - lrot[2]*py[j]);
+            vy[j] = vs[1] - (lrot[2]*px[j] - lrot[0]*pz[j]);
+            vz[j] = vs[2] - (lrot[0]*py[j] - lrot[1]*px[j]);
+        }
+    }
+
+    float moment[3];
+    _surfaceBatch.calcForces(_atmo.getDensity(), mach, faero, moment);
+
+    // calcForces() returns the moment about the origin; adding the
+    // total force there makes RigidBody account for the c.g. offset.
+    float origin[3] {0,0,0};
+    _body.addForce(origin, faero);
+    _body.addTorque(moment);
 }
 
 void Model::setState(State* s)
@@ -192,49 +255,63 @@ void Model::setGroundEffect(const float* pos, float span, float mul)
 
 void Model::updateGround(State* s)
 {
-    float dummy[3];
-    unsigned int body;
-    _ground_cb->getGroundPlane(s->pos, _global_ground, dummy, body);
+    // All points are looked up in one batch: the aircraft origin, the
+    // landing gear, the hitches and the hook and launchbar tips.
+    const int ngears = _gears.size();
+    const int nhitches = _hitches.size();
+    _groundQueries.resize(1 + ngears + nhitches + (_hook ? 1 : 0) + (_launchbar ? 1 : 0));
+    Ground::Query* q = _groundQueries.data();
+
+    Math::set3(s->pos, q->pos);
+    q++;
 
     int i;
-    // The landing gear
-    for(i=0; i<_gears.size(); i++) {
+    for(i=0; i<ngears; i++, q++) {
         Gear* g = (Gear*)_gears.get(i);
 
         // Get the point of ground contact
         float pos[3];
         g->getContact(pos);
-        
+
         // Transform the local coordinates of the contact point to
         // global coordinates.
-        double pt[3];
-        s->posLocalToGlobal(pos, pt);
-
-        // Ask for the ground plane in the global coordinate system
-        double global_ground[4];
-        float global_vel[3];
-        const simgear::BVHMaterial* material;
-        _ground_cb->getGroundPlane(pt, global_ground, global_vel, &material, body);
-        g->setGlobalGround(global_ground, global_vel, pt[0], pt[1], material, body);
+        s->posLocalToGlobal(pos, q->pos);
     }
 
-    for(i=0; i<_hitches.size(); i++) {
+    for(i=0; i<nhitches; i++, q++) {
         Hitch* h = (Hitch*)_hitches.get(i);
 
         // Get the point of interest
         float pos[3];
         h->getPosition(pos);
+        s->posLocalToGlobal(pos, q->pos);
+    }
 
-        // Transform the local coordinates of the contact point to
-        // global coordinates.
-        double pt[3];
-        s->posLocalToGlobal(pos, pt);
-
-        // Ask for the ground plane in the global coordinate system
-        double global_ground[4];
-        float global_vel[3];
-        _ground_cb->getGroundPlane(pt, global_ground, global_vel, body);
-        h->setGlobalGround(global_ground, global_vel);
+    if(_hook) {
+        _hook->getTipGlobalPosition(s, q->pos);
+        q++;
+    }
+    if(_launchbar) {
+        _launchbar->getTipGlobalPosition(s, q->pos);
+        q++;
+    }
+
+    // Ask for the ground planes in the global coordinate system
+    _ground_cb->getGroundPlanes(_groundQueries.data(), (int)_groundQueries.size());
+
+    q = _groundQueries.data();
+    for(i=0; i<4; i++) _global_ground[i] = q->plane[i];
+    q++;
+
+    // The landing gear
+    for(i=0; i<ngears; i++, q++) {
+        Gear* g = (Gear*)_gears.get(i);
+        g->setGlobalGround(q->plane, q->vel, q->pos[0], q->pos[1], q->material, q->body);
+    }
+
+    for(i=0; i<nhitches; i++, q++) {
+        Hitch* h = (Hitch*)_hitches.get(i);
+        h->setGlobalGround(q->plane, q->vel);
     }
 
     for(i=0; i<_rotorgear.getRotors()->size(); i++) {
@@ -244,20 +321,14 @@ void Model::updateGround(State* s)
 
     // The arrester hook
     if(_hook) {
-        double pt[3];
-        _hook->getTipGlobalPosition(s, pt);
-        double global_ground[4];
-        _ground_cb->getGroundPlane(pt, global_ground, dummy, body);
-        _hook->setGlobalGround(global_ground);
+        _hook->setGlobalGround(q->plane);
+        q++;
     }
 
     // The launchbar/holdback
     if(_launchbar) {
-        double pt[3];
-        _launchbar->getTipGlobalPosition(s, pt);
-        double global_ground[4];
-        _ground_cb->getGroundPlane(pt, global_ground, dummy, body);
-        _launchbar->setGlobalGround(global_ground);
+        _launchbar->setGlobalGround(q->plane);
+        q++;
     }
 }
 
@@ -297,7 +368,10 @@ void Model::calcForces(State* s)
     // Do each surface, remembering that the local velocity at each
     // point is different due to rotation.
     float faero[3] {0,0,0};
-    if (!_surfaces.empty()) {
+    if (useSurfaceBatch()) {
+        calcSurfaceForces(s, alt, faero);
+    }
+    else if (!_surfaces.empty()) {
         // approx mach number for aircraft (instead of per surface)
         float vs[3] {0,0,0}, pos[3] {0,0,0};
         localWind(pos, s, vs, alt);
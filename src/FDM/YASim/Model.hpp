@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "Integrator.hpp"
 #include "RigidBody.hpp"
 #include "BodyEnvironment.hpp"
@@ -7,6 +9,8 @@
 #include "Turbulence.hpp"
 #include "Rotor.hpp"
 #include "Atmosphere.hpp"
+#include "Ground.hpp"
+#include "SurfaceBatch.hpp"
 #include "YASim_fwd.hpp"
 
 #include <simgear/props/props.hxx>
@@ -47,6 +51,13 @@ public:
     void addHook(Hook* hook) { _hook = hook; }
     void addLaunchbar(Launchbar* launchbar) { _launchbar = launchbar; }
     Surface* getSurface(int handle) const { return (Surface*)_surfaces.get(handle); }
+    // Pack the surfaces for batched evaluation, once their
+    // coefficients are final (i.e. after the solver has run).  From
+    // then on iterate() re-packs them whenever a surface changes.
+    void compileSurfaces() { _surfaceBatch.compile(_surfaces); }
+    // Evaluate the surfaces one by one with Surface::calcForce (the
+    // reference implementation) rather than as a batch
+    void setScalarSurfaces(bool scalar) { _scalarSurfaces = scalar; }
     Rotorgear* getRotorgear(void) { return &_rotorgear; }
     Hook* getHook(void) const { return _hook; }
     int addHitch(Hitch* hitch) { return _hitches.add(hitch); }
@@ -54,6 +65,7 @@ public:
 
     // Semi-private methods for use by the Airplane solver.
     int numThrusters() const { return _thrusters.size(); }
+    int numSurfaces() const { return _surfaces.size(); }
     Thruster* getThruster(int handle) { return (Thruster*)_thrusters.get(handle); }
     void setThruster(int handle, Thruster* t) { _thrusters.set(handle, t); }
     void initIteration();
@@ -87,6 +99,8 @@ private:
     void calcGearForce(Gear* g, float* v, float* rot, float* ground);
     float gearFriction(float wgt, float v, Gear* g);
     void localWind(const float* pos, const yasim::State* s, float* out, float alt, bool is_rotor = false);
+    void calcSurfaceForces(State* s, float alt, float* faero);
+    bool useSurfaceBatch() const;
 
     /// Pointer to the Airplane instance this Model is a data member of
     Airplane* _parent;
@@ -98,6 +112,8 @@ private:
 
     Vector _thrusters;
     Vector _surfaces;
+    SurfaceBatch _surfaceBatch;
+    bool _scalarSurfaces {false};
     Rotorgear _rotorgear;
     Vector _gears;
     Hook* _hook {nullptr};
@@ -109,6 +125,7 @@ private:
     float _geRefPoint[3] {0,0,0};
 
     Ground* _ground_cb;
+    std::vector<Ground::Query> _groundQueries;
     double _global_ground[4] {0,0,1, -1e5};
     Atmosphere _atmo;
     float _wind[3] {0,0,0};
@@ -4,7 +4,7 @@
 #include "Surface.hpp"
 
 namespace yasim {
-int Surface::s_idGenerator = 0;
+std::atomic<int> Surface::s_idGenerator {0};
 
 Surface::Surface(Version* version, const float* pos, float c0 = 1 ) :
     _version(version),
@@ -52,6 +52,7 @@ Surface::Surface(Version* version, const float* pos, float c0 = 1 ) :
 void Surface::setPosition(const float* pos)
 {
     Math::set3(pos, _pos);
+    _dirty = true;
     if (_surfN != 0) {
         _surfN->getNode("pos-x", true)->setFloatValue(pos[0]);
         _surfN->getNode("pos-y", true)->setFloatValue(pos[1]);
@@ -62,6 +63,7 @@ void Surface::setPosition(const float* pos)
 void Surface::setChord(float chord) 
 {
     _chord = chord;
+    _dirty = true;
     if (_surfN != 0) {
         _surfN->getNode("chord",true)->setFloatValue(_chord);
     }
@@ -70,6 +72,7 @@ void Surface::setChord(float chord)
 void Surface::setOrientation(const float* o)
 {
     for(int i=0; i<9; i++) _orient[i] = o[i];
+    _dirty = true;
     if (_surfN) {
         // export the chord line (transformed into aircraft coordiantes)
         float xaxis[3] {1,0,0};
@@ -85,18 +88,21 @@ void Surface::setSlatParams(float stallDelta, float dragPenalty)
 {
     _slatAlpha = stallDelta;
     _slatDrag = dragPenalty;
+    _dirty = true;
 }
 
 void Surface::setFlapParams(float liftAdd, float dragPenalty)
 {
     _flapLift = liftAdd;
     _flapDrag = dragPenalty;
+    _dirty = true;
 }
 
 void Surface::setSpoilerParams(float liftPenalty, float dragPenalty)
 {
     _spoilerLift = liftPenalty;
     _spoilerDrag = dragPenalty;
+    _dirty = true;
 }
 
 void Surface::setFlapPos(float pos)
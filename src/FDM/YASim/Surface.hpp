@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 #include <simgear/props/props.hxx>
 #include "Version.hpp"
 #include "Math.hpp"
@@ -12,7 +14,9 @@ namespace yasim {
 // front, and flaps act (in both lift and drag) toward the back.
 class Surface
 {
-    static int s_idGenerator;
+    friend class SurfaceBatch;
+
+    static std::atomic<int> s_idGenerator;
     int _id;        //index for property tree
 
 public:
@@ -59,45 +63,55 @@ public:
     // The offset from base incidence for this surface.
     void setTwist(float angle);
 
-    void  setTotalForceCoefficient(float c0) { _c0 = c0; }
-    void  mulTotalForceCoefficient(float factor) { _c0 *= factor; }
+    void  setTotalForceCoefficient(float c0) { update(_c0, c0); }
+    void  mulTotalForceCoefficient(float factor) { update(_c0, _c0 * factor); }
     float getTotalForceCoefficient() const { return _c0; }
     
-    void  setDragCoefficient(float cx) { _cx = cx; }
-    void  mulDragCoefficient(float factor) { _cx *= factor; }
+    void  setDragCoefficient(float cx) { update(_cx, cx); }
+    void  mulDragCoefficient(float factor) { update(_cx, _cx * factor); }
     float getDragCoefficient() const { return _cx; }
-    void  setYDrag(float cy) { _cy = cy; }
-    void  setLiftCoefficient(float cz) { _cz = cz; }
+    void  setYDrag(float cy) { update(_cy, cy); }
+    void  setLiftCoefficient(float cz) { update(_cz, cz); }
     float getLiftCoefficient() const { return _cz; }
 
     // zero-alpha Z drag ("camber") specified as a fraction of cz
-    void setZeroAlphaLift(float cz0) { _cz0 = cz0; }
+    void setZeroAlphaLift(float cz0) { update(_cz0, cz0); }
 
     // i: 0 == forward, 1 == backwards
-    void setStallPeak(int i, float peak) { _peaks[i] = peak; }
+    void setStallPeak(int i, float peak) { update(_peaks[i], peak); }
 
     // i: 0 == fwd/+z, 1 == fwd/-z, 2 == rev/+z, 3 == rev/-z
-    void setStall(int i, float alpha) { _stalls[i] = alpha; }
-    void setStallWidth(int i, float width) { _widths[i] = width; }
+    void setStall(int i, float alpha) { update(_stalls[i], alpha); }
+    void setStallWidth(int i, float width) { update(_widths[i], width); }
 
     // Induced drag multiplier
-    void setInducedDrag(float mul) { _inducedDrag = mul; }
+    void setInducedDrag(float mul) { update(_inducedDrag, mul); }
 
     void calcForce(const float* v, const float rho, float mach, float* out, float* torque);
 
     float getAlpha() const { return _alpha; };
     float getStallAlpha() const { return _stallAlpha; };
     
-    void setFlowRegime(FlowRegime flow) { _flow = flow; };
+    void setFlowRegime(FlowRegime flow) { _dirty |= _flow != flow; _flow = flow; };
     FlowRegime getFlowRegime() { return _flow; };
     
-    void setCriticalMachNumber(float mach) { _Mcrit = mach; };
+    void setCriticalMachNumber(float mach) { update(_Mcrit, mach); };
     float getCriticalMachNumber() const { return _Mcrit; };
     
 private:
     SGPropertyNode_ptr _surfN;
     Version * _version;
     
+    // Assign a geometry or coefficient member, flagging the change for
+    // SurfaceBatch.  The gear and weights re-set theirs every frame.
+    void update(float& member, float value)
+    {
+        if (member != value) {
+            member = value;
+            _dirty = true;
+        }
+    }
+
     float stallFunc(float* v);
     float flapLift(float alpha);
     float controlDrag(float lift, float drag);
@@ -136,6 +150,10 @@ private:
     FlowRegime _flow{FLOW_SUBSONIC};
     float _Mcrit {0.6f};
 
+    // set by any change to the geometry or coefficients, cleared when
+    // a SurfaceBatch copies them (control positions are re-read anyway)
+    bool _dirty {true};
+
     std::vector<float> pg_coefficients {-1.7671f, 0.4495f, 10.3423f, -6.9237f};
     
     SGPropertyNode* _fxN;
@@ -0,0 +1,240 @@
+#include "yasim-common.hpp"
+#include "Math.hpp"
+#include "Surface.hpp"
+#include "SurfaceBatch.hpp"
+
+namespace yasim {
+
+void SurfaceBatch::compile(const Vector& surfaces)
+{
+    const int n = surfaces.size();
+    _surfaces.resize(n);
+    for(int j=0; j<n; j++)
+        _surfaces[j] = (Surface*)surfaces.get(j);
+    _v32 = n > 0 && _surfaces[0]->_version->isVersionOrNewer(YASIM_VERSION::V_32);
+
+    for(auto* a : {&_px, &_py, &_pz, &_chord,
+                   &_c0, &_cx, &_cy, &_cz, &_cz0, &_active,
+                   &_flapDragAoA, &_inducedDrag, &_transonic, &_mcrit,
+                   &_incidence, &_slatStall, &_flapLift, &_spoilerMul,
+                   &_flapDragPos, &_dragMul,
+                   &_vx, &_vy, &_vz, &_fx, &_fy, &_fz,
+                   &_alpha, &_stallAlpha, &_pg, &_wavedrag})
+        a->assign(n, 0);
+    for(int k=0; k<9; k++) _orient[k].assign(n, 0);
+    for(int k=0; k<2; k++) _peaks[k].assign(n, 0);
+    for(int k=0; k<4; k++) {
+        _stalls[k].assign(n, 0);
+        _widths[k].assign(n, 0);
+    }
+
+    for(int j=0; j<n; j++) {
+        const Surface* sf = _surfaces[j];
+        _px[j] = sf->_pos[0];
+        _py[j] = sf->_pos[1];
+        _pz[j] = sf->_pos[2];
+        for(int k=0; k<9; k++) _orient[k][j] = sf->_orient[k];
+        _chord[j] = sf->_chord;
+
+        _c0[j] = sf->_c0;
+        _cx[j] = sf->_cx;
+        _cy[j] = sf->_cy;
+        _cz[j] = sf->_cz;
+        _cz0[j] = sf->_cz0;
+        _active[j] = (sf->_cx == 0 && sf->_cy == 0 && sf->_cz == 0) ? 0 : 1;
+        for(int k=0; k<2; k++) _peaks[k][j] = sf->_peaks[k];
+        for(int k=0; k<4; k++) {
+            _stalls[k][j] = sf->_stalls[k];
+            _widths[k][j] = sf->_widths[k];
+        }
+        _flapDragAoA[j] = (sf->_flapLift - 1 - sf->_cz0) * sf->_stalls[0];
+        _inducedDrag[j] = sf->_inducedDrag;
+        _transonic[j] = sf->_flow == FLOW_TRANSONIC ? 1 : 0;
+        _mcrit[j] = sf->_Mcrit;
+        _alpha[j] = sf->_alpha;
+        _stallAlpha[j] = sf->_stallAlpha;
+        _surfaces[j]->_dirty = false;
+    }
+    syncControls();
+}
+
+bool SurfaceBatch::isCurrent(const Vector& surfaces) const
+{
+    if(surfaces.size() != size())
+        return false;
+    for(const Surface* sf : _surfaces)
+        if(sf->_dirty)
+            return false;
+    return true;
+}
+
+// Everything here depends only on the control positions, so it is
+// hoisted out of the per-substep evaluation.  See Surface::stallFunc,
+// flapLift and controlDrag for the scalar equivalents.
+void SurfaceBatch::syncControls()
+{
+    const int n = size();
+    for(int j=0; j<n; j++) {
+        const Surface* sf = _surfaces[j];
+        _incidence[j] = sf->_incidence + sf->_twist;
+        _slatStall[j] = _v32 ? sf->_slatPos * sf->_slatAlpha : sf->_slatAlpha;
+        _flapLift[j] = sf->_cz * sf->_flapPos * (sf->_flapLift-1) * sf->_flapEffectiveness;
+        _spoilerMul[j] = 1 + sf->_spoilerPos * (sf->_spoilerLift - 1);
+
+        float fp = sf->_flapPos;
+        if(fp < 0) {
+            fp = -fp;
+            fp -= sf->_cz0/(sf->_flapLift-1);
+            if(fp < 0) fp = 0;
+        }
+        _flapDragPos[j] = fp;
+        _dragMul[j] = (1 + fp * (sf->_flapDrag - 1))
+                    * (1 + sf->_spoilerPos * (sf->_spoilerDrag - 1))
+                    * (1 + sf->_slatPos * (sf->_slatDrag - 1));
+    }
+}
+
+void SurfaceBatch::calcForces(float rho, float mach, float* force, float* moment)
+{
+    Math::zero3(force);
+    Math::zero3(moment);
+    if(_surfaces.empty())
+        return;
+
+    // Prandtl/Glauert and wave drag depend on the aircraft mach
+    // number only, not on the surface.
+    float pgTransonic;
+    if (mach < 0.8f) {
+        pgTransonic = 1.0f/sqrt(1.0f-(mach*mach));
+    } else if (mach < 1.2f) {
+        pgTransonic = Math::polynomial(_surfaces[0]->pg_coefficients, mach);
+    } else {
+        pgTransonic = 2.0f/(((mach*mach)-1.0f)*YASIM_PI);
+    }
+    const float machWave = mach > 1.0f ? 1.0f : mach;
+
+    const int n = size();
+    for(int j=0; j<n; j++) {
+        float vel = Math::sqrt(_vx[j]*_vx[j] + _vy[j]*_vy[j] + _vz[j]*_vz[j]);
+        bool active = (vel != 0) && (_active[j] != 0);
+        float inv = active ? 1/vel : 0;
+
+        // Normalized wind in surface coordinates
+        float wx = inv * (_orient[0][j]*_vx[j] + _orient[1][j]*_vy[j] + _orient[2][j]*_vz[j]);
+        float wy = inv * (_orient[3][j]*_vx[j] + _orient[4][j]*_vy[j] + _orient[5][j]*_vz[j]);
+        float wz = inv * (_orient[6][j]*_vx[j] + _orient[7][j]*_vy[j] + _orient[8][j]*_vz[j]);
+
+        float incidence = _incidence[j];
+        wz += incidence * wx;
+        const float lx = wx, ly = wy, lz = wz;
+
+        // Stall multiplier
+        float stallMul = 1;
+        if(active && wx != 0) {
+            float alpha = Math::abs(wz/wx);
+            int fwdBak = wx > 0;
+            int posNeg = wz < 0;
+            int i = (fwdBak<<1) | posNeg;
+            float stallAlpha = _stalls[i][j];
+            if(stallAlpha != 0) {
+                if(i == 0) stallAlpha += _slatStall[j];
+                float scale = 0.5f*_peaks[fwdBak][j]/_stalls[i&2][j];
+                float frac = (alpha - stallAlpha) / _widths[i][j];
+                frac = frac*frac*(3-2*frac);
+                stallMul = alpha > stallAlpha + _widths[i][j] ? 1
+                         : alpha <= stallAlpha ? scale
+                         : scale*(1-frac) + frac;
+            }
+            _alpha[j] = alpha;
+            _stallAlpha[j] = stallAlpha;
+        }
+        stallMul *= _spoilerMul[j];
+
+        const float cz = _cz[j];
+        float stallLift = (stallMul - 1) * cz * wz;
+
+        // Flap lift, faded out past the stall
+        float flaplift = 0;
+        const float stall0 = _stalls[0][j];
+        if(stall0 != 0) {
+            float a = Math::abs(wz);
+            float frac = (a - stall0) / _widths[0][j];
+            frac = frac*frac*(3-2*frac);
+            flaplift = a < stall0 ? _flapLift[j]
+                     : a > stall0 + _widths[0][j] ? 0
+                     : _flapLift[j] * (1-frac);
+        }
+
+        wz = wz*cz + cz*_cz0[j] + stallLift + flaplift;
+
+        float pg = 1, wavedrag = 0;
+        if(_transonic[j] != 0) {
+            pg = pgTransonic;
+            wz *= pg;
+            if(mach > _mcrit[j]) {
+                wavedrag = 9.5f * Math::pow(machWave-_mcrit[j], 2.8f) + 0.00193f;
+                wx += wavedrag;
+            }
+        }
+
+        float ty = 0.1667f * _chord[j] * (flaplift - (cz*_cz0[j] + stallLift));
+
+        // Control drag
+        float drag = _cx[j] * wx;
+        float fd = Math::abs(wz * _flapDragAoA[j] * _flapDragPos[j]);
+        drag += drag < 0 ? -fd : fd;
+        wx = drag * _dragMul[j];
+        wy *= _cy[j];
+
+        // Induced drag
+        float k = -_inducedDrag[j]*wz*lz;
+        wx += k*lx;
+        wy += k*ly;
+        wz += k*lz;
+
+        if(_v32) wx += incidence * wz;
+        else     wz -= incidence * wx;
+
+        float scale = active ? 0.5f*rho*vel*vel*_c0[j] : 0;
+        wx *= scale; wy *= scale; wz *= scale;
+        ty *= scale;
+
+        // Back to local coordinates
+        float fx = _orient[0][j]*wx + _orient[3][j]*wy + _orient[6][j]*wz;
+        float fy = _orient[1][j]*wx + _orient[4][j]*wy + _orient[7][j]*wz;
+        float fz = _orient[2][j]*wx + _orient[5][j]*wy + _orient[8][j]*wz;
+        _fx[j] = fx; _fy[j] = fy; _fz[j] = fz;
+        _pg[j] = pg;
+        _wavedrag[j] = wavedrag;
+
+        force[0] += fx;
+        force[1] += fy;
+        force[2] += fz;
+        moment[0] += _py[j]*fz - _pz[j]*fy + _orient[3][j]*ty;
+        moment[1] += _pz[j]*fx - _px[j]*fz + _orient[4][j]*ty;
+        moment[2] += _px[j]*fy - _py[j]*fx + _orient[5][j]*ty;
+    }
+}
+
+void SurfaceBatch::exportResults()
+{
+    const int n = size();
+    for(int j=0; j<n; j++) {
+        Surface* sf = _surfaces[j];
+        sf->_alpha = _alpha[j];
+        sf->_stallAlpha = _stallAlpha[j];
+        if (sf->_surfN != 0) {
+            float f[3] {_fx[j], _fy[j], _fz[j]};
+            sf->_fabsN->setFloatValue(Math::mag3(f));
+            sf->_fxN->setFloatValue(f[0]);
+            sf->_fyN->setFloatValue(f[1]);
+            sf->_fzN->setFloatValue(f[2]);
+            sf->_alphaN->setFloatValue(_alpha[j]);
+            sf->_stallAlphaN->setFloatValue(_stallAlpha[j]);
+            sf->_pgCorrectionN->setFloatValue(_pg[j]);
+            sf->_dcdwaveN->setFloatValue(_wavedrag[j]);
+        }
+    }
+}
+
+}; // namespace yasim
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vector>
+
+#include "Vector.hpp"
+
+namespace yasim {
+
+class Surface;
+
+// All of a model's surfaces packed into parallel arrays, one per
+// parameter, so the forces can be evaluated in a single pass over
+// contiguous memory.  Geometry and coefficients are copied when the
+// airplane is compiled (after the solver has settled them); the
+// control positions are re-read before each evaluation.
+//
+// Surface::calcForce remains the reference implementation: the
+// results here are the same up to float rounding.
+class SurfaceBatch {
+public:
+    // Pack the surfaces; must be called again if their geometry or
+    // coefficients change.
+    void compile(const Vector& surfaces);
+
+    int size() const { return (int)_surfaces.size(); }
+
+    // False if surfaces were added, or any geometry or coefficient
+    // changed, since compile().
+    bool isCurrent(const Vector& surfaces) const;
+
+    // Copy the current control positions from the surfaces
+    void syncControls();
+
+    // Wind at each surface, in local coordinates.  Filled by the
+    // caller before calcForces().
+    float* windX() { return _vx.data(); }
+    float* windY() { return _vy.data(); }
+    float* windZ() { return _vz.data(); }
+    const float* posX() const { return _px.data(); }
+    const float* posY() const { return _py.data(); }
+    const float* posZ() const { return _pz.data(); }
+
+    // Evaluate all surfaces.  Returns the summed force, and the
+    // summed moment about the local origin (including the surfaces'
+    // own pitching torques).
+    void calcForces(float rho, float mach, float* force, float* moment);
+
+    // Hand the results of the last calcForces() back to the surfaces,
+    // for getAlpha() and the debug properties.
+    void exportResults();
+
+private:
+    std::vector<Surface*> _surfaces;
+    bool _v32 {false};
+
+    // geometry
+    std::vector<float> _px, _py, _pz;
+    std::vector<float> _orient[9];
+    std::vector<float> _chord;
+
+    // coefficients
+    std::vector<float> _c0, _cx, _cy, _cz, _cz0;
+    std::vector<float> _active; // 0 for surfaces producing no force
+    std::vector<float> _peaks[2];
+    std::vector<float> _stalls[4];
+    std::vector<float> _widths[4];
+    std::vector<float> _flapDragAoA, _inducedDrag;
+    std::vector<float> _transonic, _mcrit;
+
+    // control state, see syncControls()
+    std::vector<float> _incidence;
+    std::vector<float> _slatStall;   // stall angle shift from the slats
+    std::vector<float> _flapLift;    // flap lift before the stall
+    std::vector<float> _spoilerMul;  // stall (lift) multiplier
+    std::vector<float> _flapDragPos; // effective flap position for drag
+    std::vector<float> _dragMul;     // combined control drag multiplier
+
+    // inputs and results
+    std::vector<float> _vx, _vy, _vz;
+    std::vector<float> _fx, _fy, _fz;
+    std::vector<float> _alpha, _stallAlpha, _pg, _wavedrag;
+};
+
+}; // namespace yasim
@@ -70,7 +70,8 @@ void YASim::report()
     float drag = 1000 * a->getDragCoefficient();
 
     SG_LOG(SG_FLIGHT,SG_INFO,"YASim solution results:");
-    SG_LOG(SG_FLIGHT,SG_INFO,"       Iterations: "<<a->getSolutionIterations());
+    SG_LOG(SG_FLIGHT,SG_INFO,"       Iterations: "<<a->getSolutionIterations()
+           << (a->isSolutionCached() ? " (cached)" : ""));
     SG_LOG(SG_FLIGHT,SG_INFO," Drag Coefficient: "<< drag);
     SG_LOG(SG_FLIGHT,SG_INFO,"       Lift Ratio: "<<a->getLiftRatio());
     SG_LOG(SG_FLIGHT,SG_INFO,"       Cruise AoA: "<< aoa);
@@ -140,6 +141,9 @@ void YASim::init()
     _pilot_g         = fgGetNode("/accelerations/pilot-g", true);
     _speed_setprop   = fgGetNode("/sim/presets/speed-set", true);
 
+    // Evaluate surfaces one at a time, for comparison with the batch
+    model->setScalarSurfaces(fgGetBool("/fdm/yasim/scalar-surfaces", false));
+
     // Superclass hook
     common_init();
 
@@ -174,6 +178,12 @@ void YASim::init()
         throw e;
     }
 
+    // Solving takes a while for detailed models, reuse earlier results
+    if (fgGetBool("/fdm/yasim/solution-cache", true)) {
+        airplane->setSolutionCache(globals->get_fg_home() / "cache" / "yasim",
+                                   Airplane::solutionModelKey(f));
+    }
+
     // Compile it into a real airplane, and tell the user what they got
     airplane->compile();
     report();
@@ -0,0 +1,437 @@
+// yasim-sweep: trim (and optionally fly) a YASim aircraft over a list of
+// weight, fuel, altitude and speed combinations, on all cores.
+//
+// Every worker thread owns an independent Airplane; there is no scenery
+// and no property tree.  Results are streamed as CSV, or as raw doubles
+// for large sweeps.
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <simgear/props/props.hxx>
+#include <simgear/xml/easyxml.hxx>
+#include <simgear/misc/sg_path.hxx>
+#include <simgear/misc/strutils.hxx>
+#include <simgear/structure/exception.hxx>
+#include <simgear/io/iostreams/sgstream.hxx>
+
+#include "yasim-common.hpp"
+#include "FGFDM.hpp"
+#include "Airplane.hpp"
+#include "Ground.hpp"
+#include "RigidBody.hpp"
+
+using namespace yasim;
+using std::string;
+
+// Stubs.  Not needed by a batch program, but required to link.
+bool fgSetFloat (const char * name, float val) { return false; }
+bool fgSetBool(char const * name, bool val) { return false; }
+bool fgGetBool(char const * name, bool def) { return false; }
+bool fgSetString(char const * name, char const * str) { return false; }
+SGPropertyNode* fgGetNode (const char * path, bool create) { return 0; }
+SGPropertyNode* fgGetNode (const char * path, int i, bool create) { return 0; }
+float fgGetFloat (const char * name, float defaultValue) { return 0; }
+double fgGetDouble (const char * name, double defaultValue = 0.0) { return 0; }
+bool fgSetDouble (const char * name, double defaultValue = 0.0) { return 0; }
+
+namespace {
+
+// The solver works in a frame with "up" along +z (as seen from the
+// north pole), so time histories are flown there too, above a flat
+// ground at the polar radius.
+const double POLAR_RADIUS_M = 6356752.3142;
+
+class FlatGround : public Ground {
+public:
+    void getGroundPlane(const double pos[3], double plane[4], float vel[3],
+                        unsigned int &body) override
+    {
+        plane[0] = 0;
+        plane[1] = 0;
+        plane[2] = 1;
+        plane[3] = POLAR_RADIUS_M;
+        vel[0] = vel[1] = vel[2] = 0;
+        body = 0;
+    }
+
+    void getGroundPlane(const double pos[3], double plane[4], float vel[3],
+                        const simgear::BVHMaterial **material,
+                        unsigned int &body) override
+    {
+        getGroundPlane(pos, plane, vel, body);
+        *material = nullptr;
+    }
+};
+
+struct Options {
+    string aircraft;
+    string cases;
+    string output;
+    bool binary {false};
+    unsigned threads {0};
+    float duration {0};    // seconds of time history per case, 0 to only trim
+    float dt {1.0f/120};
+    int every {12};        // time history output decimation
+    SGPath cacheDir;
+};
+
+// One row of the case file.  Columns: altitude-m, speed-kts, fuel
+// (fraction), config (approach|cruise|none) and weight<N> (kg, for the
+// N-th <weight> of the aircraft definition).  Missing values default
+// to 0 m, 100 kts, full fuel, no config (all controls neutral but the
+// solved stabilizer trim) and empty weights.
+struct Case {
+    int id {0};
+    float altitude {0};
+    float kts {100};
+    float fuel {1};
+    Airplane::Configuration config {Airplane::NONE};
+    std::vector<std::pair<int, float>> weights;
+};
+
+const char* TRIM_COLUMNS[] = {"case", "altitude-m", "speed-kts", "mass-kg", "cg-x-m",
+                              "aoa-deg", "elevator", "drag-g", "pitch-accel-rad_s2", "converged"};
+const char* HISTORY_COLUMNS[] = {"case", "time-s", "altitude-m", "speed-kts",
+                                 "pitch-deg", "aoa-deg", "climb-mps"};
+
+// Serialises result rows from the workers onto one stream.
+class Writer {
+public:
+    Writer(FILE* f, bool binary) : _f(f), _binary(binary) {}
+
+    template <size_t N>
+    void header(const char* (&columns)[N])
+    {
+        for (size_t i = 0; i < N; i++)
+            fprintf(_f, "%s%s", i ? (_binary ? " " : ",") : "", columns[i]);
+        fputc('\n', _f);
+    }
+
+    void rows(const std::vector<double>& values, size_t columns)
+    {
+        std::lock_guard<std::mutex> g(_lock);
+        if (_binary) {
+            fwrite(values.data(), sizeof(double), values.size(), _f);
+            return;
+        }
+        for (size_t i = 0; i < values.size(); i++)
+            fprintf(_f, "%.9g%c", values[i], (i+1) % columns ? ',' : '\n');
+    }
+
+private:
+    FILE* _f;
+    bool _binary;
+    std::mutex _lock;
+};
+
+bool readCases(const string& path, std::vector<Case>& cases)
+{
+    sg_ifstream in(SGPath::fromLocal8Bit(path.c_str()));
+    if (!in) {
+        fprintf(stderr, "can't read %s\n", path.c_str());
+        return false;
+    }
+
+    string line;
+    std::getline(in, line);
+    std::vector<string> header = simgear::strutils::split(simgear::strutils::strip(line), ",");
+
+    while (std::getline(in, line)) {
+        line = simgear::strutils::strip(line);
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::vector<string> fields = simgear::strutils::split(line, ",");
+        Case c;
+        c.id = (int)cases.size();
+        for (size_t i = 0; i < std::min(header.size(), fields.size()); i++) {
+            const string name = simgear::strutils::strip(header[i]);
+            const string value = simgear::strutils::strip(fields[i]);
+            if (name == "altitude-m") c.altitude = std::atof(value.c_str());
+            else if (name == "speed-kts") c.kts = std::atof(value.c_str());
+            else if (name == "fuel") c.fuel = std::atof(value.c_str());
+            else if (name == "config") {
+                if (value == "approach") c.config = Airplane::APPROACH;
+                else if (value == "cruise") c.config = Airplane::CRUISE;
+            }
+            else if (name.compare(0, 6, "weight") == 0) {
+                c.weights.emplace_back(std::atoi(name.c_str() + 6), std::atof(value.c_str()));
+            }
+            else {
+                fprintf(stderr, "unknown column '%s'\n", name.c_str());
+                return false;
+            }
+        }
+        cases.push_back(c);
+    }
+    return true;
+}
+
+std::unique_ptr<FGFDM> loadAircraft(const Options& opt)
+{
+    std::unique_ptr<FGFDM> fdm(new FGFDM());
+    Airplane* a = fdm->getAirplane();
+    SGPath file = SGPath::fromLocal8Bit(opt.aircraft.c_str());
+    readXML(file, *fdm);
+    if (!opt.cacheDir.isNull())
+        a->setSolutionCache(opt.cacheDir, Airplane::solutionModelKey(file));
+    a->compile();
+    if (a->getFailureMsg())
+        throw sg_exception(string("solution failure: ") + a->getFailureMsg());
+
+    a->getModel()->setGroundCallback(new FlatGround());
+    a->getModel()->getIntegrator()->setInterval(opt.dt);
+    return fdm;
+}
+
+// Linear and angular acceleration (global frame) in unaccelerated
+// flight at the given angle of attack, as in yasim-test
+void calcAcceleration(Airplane* a, float aoa, float speed, float* acc, float* racc)
+{
+    Model* m = a->getModel();
+    State s;
+    s.setupState(aoa, speed, 0);
+    m->getBody()->reset();
+    m->initIteration();
+    m->calcForces(&s);
+    m->getBody()->getAccel(acc);
+    s.localToGlobal(acc, acc);
+    m->getBody()->getAngularAccel(racc);
+    s.localToGlobal(racc, racc);
+}
+
+void setElevator(Airplane* a, float elevator)
+{
+    ControlMap* cm = a->getControlMap();
+    cm->setInput(a->getElevatorInputHandle(), elevator);
+    cm->applyControls();
+}
+
+void setupCase(Airplane* a, const Case& c)
+{
+    Model* m = a->getModel();
+    for (int i = 0; i < a->numWeights(); i++)
+        a->setWeight(i, 0);
+    for (const auto& w : c.weights) {
+        if (w.first >= 0 && w.first < a->numWeights())
+            a->setWeight(w.first, w.second);
+    }
+    a->setFuelFraction(c.fuel);
+    m->setStandardAtmosphere(c.altitude);
+    // each of these resets every control input, so a case does not
+    // inherit the controls of the previous one on the same worker
+    switch (c.config) {
+        case Airplane::APPROACH: a->setApproachControls(); break;
+        case Airplane::CRUISE: a->setCruiseControls(); break;
+        default: a->setNeutralControls(); break;
+    }
+    m->getBody()->recalc();
+}
+
+// Find the angle of attack and elevator for 1g without pitch
+// acceleration at the case speed (Newton's method, with finite
+// difference derivatives).  Aircraft without an elevator input are
+// trimmed in angle of attack only.
+bool trim(Airplane* a, float speed, float& aoa, float& elevator, float* acc, float* racc)
+{
+    const float DAOA = 0.1f*DEG2RAD, DELEV = 0.01f;
+    const bool hasElevator = a->getElevatorInputHandle() >= 0;
+    float dacc[3], dracc[3];
+    aoa = 0;
+    elevator = 0;
+    for (int i = 0; i < 50; i++) {
+        if (hasElevator)
+            setElevator(a, elevator);
+        calcAcceleration(a, aoa, speed, acc, racc);
+        if (Math::abs(acc[2]) < 1e-4f * 9.8f
+            && (!hasElevator || Math::abs(racc[1]) < 1e-3f))
+            return true;
+
+        calcAcceleration(a, aoa + DAOA, speed, dacc, dracc);
+        const float liftAoA = (dacc[2] - acc[2]) / DAOA;
+        const float pitchAoA = (dracc[1] - racc[1]) / DAOA;
+        float dAoA, dElev = 0;
+        if (hasElevator) {
+            setElevator(a, elevator + DELEV);
+            calcAcceleration(a, aoa, speed, dacc, dracc);
+            const float liftElev = (dacc[2] - acc[2]) / DELEV;
+            const float pitchElev = (dracc[1] - racc[1]) / DELEV;
+            const float det = liftAoA * pitchElev - liftElev * pitchAoA;
+            if (det == 0)
+                break;
+            dAoA = (liftElev * racc[1] - pitchElev * acc[2]) / det;
+            dElev = (pitchAoA * acc[2] - liftAoA * racc[1]) / det;
+        } else {
+            if (liftAoA == 0)
+                break;
+            dAoA = -acc[2] / liftAoA;
+        }
+        aoa = Math::clamp(aoa + dAoA, -15*DEG2RAD, 30*DEG2RAD);
+        elevator = Math::clamp(elevator + dElev, -1, 1);
+    }
+    // leave the model at the last estimate
+    if (hasElevator)
+        setElevator(a, elevator);
+    calcAcceleration(a, aoa, speed, acc, racc);
+    return false;
+}
+
+void fly(Airplane* a, const Options& opt, const Case& c, float aoa, float speed,
+         Writer& out)
+{
+    Model* m = a->getModel();
+    State s;
+    s.setupState(aoa, speed, 0);
+    s.pos[2] = POLAR_RADIUS_M + c.altitude;
+    m->setState(&s);
+
+    const int steps = (int)(opt.duration / opt.dt + 0.5f);
+    const size_t columns = sizeof(HISTORY_COLUMNS)/sizeof(HISTORY_COLUMNS[0]);
+    std::vector<double> rows;
+    for (int i = 0; i <= steps; i++) {
+        State* st = m->getState();
+        const double alt = st->pos[2] - POLAR_RADIUS_M;
+        if (i % opt.every == 0 || i == steps) {
+            float v[3];
+            st->globalToLocal(st->v, v);
+            rows.insert(rows.end(), {
+                (double)c.id, i * opt.dt, alt, Math::mag3(st->v) * MPS2KTS,
+                Math::asin(Math::clamp(st->orient[2], -1, 1)) * RAD2DEG,
+                Math::atan2(-v[2], v[0]) * RAD2DEG, st->v[2]});
+        }
+        if (i == steps || m->isCrashed())
+            break;
+        m->setStandardAtmosphere(alt);
+        m->updateGround(st);
+        a->iterate(opt.dt);
+    }
+    out.rows(rows, columns);
+}
+
+void runCase(Airplane* a, const Options& opt, const Case& c, Writer& out)
+{
+    setupCase(a, c);
+    float speed = c.kts * KTS2MPS;
+    float aoa, elevator, acc[3], racc[3], cg[3];
+    bool converged = trim(a, speed, aoa, elevator, acc, racc);
+
+    if (opt.duration > 0) {
+        fly(a, opt, c, aoa, speed, out);
+        return;
+    }
+
+    a->getModel()->getBody()->getCG(cg);
+    out.rows({(double)c.id, c.altitude, c.kts, a->getModel()->getMass(), cg[0],
+              aoa * RAD2DEG, elevator, -acc[0] / 9.8, racc[1], converged ? 1.0 : 0.0},
+             sizeof(TRIM_COLUMNS)/sizeof(TRIM_COLUMNS[0]));
+}
+
+int usage()
+{
+    fprintf(stderr, "Usage: \n");
+    fprintf(stderr, "  yasim-sweep <aircraft.xml> <cases.csv> [-j threads] [-o file] [--binary]\n");
+    fprintf(stderr, "              [-t seconds [--dt step] [--every n]] [--cache dir]\n");
+    fprintf(stderr, "      cases.csv  header and one row per case; columns altitude-m, speed-kts,\n");
+    fprintf(stderr, "                 fuel, config (approach|cruise, else neutral controls),\n");
+    fprintf(stderr, "                 weight<N> (kg)\n");
+    fprintf(stderr, "      each case is trimmed in angle of attack and elevator for level flight\n");
+    fprintf(stderr, "      -j         worker threads, default one per core\n");
+    fprintf(stderr, "      -o         output file, default stdout\n");
+    fprintf(stderr, "      --binary   column names on the first line, then rows of doubles\n");
+    fprintf(stderr, "      -t         fly each case from its trim for this long\n");
+    fprintf(stderr, "      --dt       integration step, default 1/120 s\n");
+    fprintf(stderr, "      --every    output every n-th step, default 12\n");
+    fprintf(stderr, "      --cache    solution cache directory, so the workers solve only once\n");
+    return 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    if (argc < 3)
+        return usage();
+    opt.aircraft = argv[1];
+    opt.cases = argv[2];
+    for (int i = 3; i < argc; i++) {
+        bool hasArg = i+1 < argc;
+        if (!strcmp(argv[i], "-j") && hasArg) opt.threads = std::atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-o") && hasArg) opt.output = argv[++i];
+        else if (!strcmp(argv[i], "--binary")) opt.binary = true;
+        else if (!strcmp(argv[i], "-t") && hasArg) opt.duration = std::atof(argv[++i]);
+        else if (!strcmp(argv[i], "--dt") && hasArg) opt.dt = std::atof(argv[++i]);
+        else if (!strcmp(argv[i], "--every") && hasArg) opt.every = std::atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--cache") && hasArg) opt.cacheDir = SGPath::fromLocal8Bit(argv[++i]);
+        else return usage();
+    }
+    if (opt.dt <= 0 || opt.every < 1)
+        return usage();
+
+    std::vector<Case> cases;
+    if (!readCases(opt.cases, cases))
+        return 1;
+
+    if (opt.threads == 0)
+        opt.threads = std::max(1u, std::thread::hardware_concurrency());
+    opt.threads = std::min<unsigned>(opt.threads, std::max<size_t>(cases.size(), 1));
+
+    FILE* f = opt.output.empty() ? stdout : fopen(opt.output.c_str(), opt.binary ? "wb" : "w");
+    if (!f) {
+        fprintf(stderr, "can't write %s\n", opt.output.c_str());
+        return 1;
+    }
+    Writer out(f, opt.binary);
+    if (opt.duration > 0) out.header(HISTORY_COLUMNS);
+    else out.header(TRIM_COLUMNS);
+
+    // The first instance is compiled up front, so a parse or solver
+    // failure is reported once and the cache (if any) is populated
+    // before the other workers start.
+    std::vector<std::unique_ptr<FGFDM>> fdms;
+    try {
+        fdms.push_back(loadAircraft(opt));
+    } catch (const sg_exception& e) {
+        fprintf(stderr, "%s: %s\n", opt.aircraft.c_str(), e.getFormattedMessage().c_str());
+        return 1;
+    }
+    fdms.resize(opt.threads);
+
+    std::atomic<size_t> next {0};
+    std::atomic<int> failures {0};
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < opt.threads; t++) {
+        workers.emplace_back([&, t]() {
+            try {
+                if (!fdms[t])
+                    fdms[t] = loadAircraft(opt);
+            } catch (const sg_exception& e) {
+                fprintf(stderr, "worker %u: %s\n", t, e.getFormattedMessage().c_str());
+                failures++;
+                return;
+            }
+            Airplane* a = fdms[t]->getAirplane();
+            for (size_t i = next++; i < cases.size(); i = next++)
+                runCase(a, opt, cases[i], out);
+        });
+    }
+    for (auto& w : workers)
+        w.join();
+
+    if (f != stdout)
+        fclose(f);
+    return failures ? 1 : 0;
+}
@@ -1,5 +1,6 @@
 #include <stdio.h>
 
+#include <chrono>
 #include <cstring>
 #include <cstdlib>
 
@@ -395,6 +396,71 @@ void report(Airplane* a)
     printf(" Axis    z     Yaw   %7.0f  %7.0f  %7.0f\n", SI_inertia[6], SI_inertia[7], SI_inertia[8]);
 }
 
+// Time Model::calcForces with the batched and the reference (one
+// surface at a time) aerodynamics, and check they agree.
+void yasim_bench(Airplane* a, const float alt, const float kts, Airplane::Configuration cfgID, int count)
+{
+    _setup(a, cfgID, alt);
+    Model* m = a->getModel();
+    float speed = kts * KTS2MPS;
+    float aoa = a->getCruiseAoA();
+    float acc[2][3];
+
+    printf("surfaces: %d, calls: %d\n", m->numSurfaces(), count);
+    for (int scalar = 0; scalar < 2; scalar++) {
+        m->setScalarSurfaces(scalar != 0);
+        State s;
+        s.setupState(aoa, speed, 0);
+        m->getBody()->reset();
+        m->initIteration();
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < count; i++) {
+            m->getBody()->reset();
+            m->calcForces(&s);
+        }
+        auto end = std::chrono::steady_clock::now();
+        m->getBody()->getAccel(acc[scalar]);
+
+        double us = std::chrono::duration<double, std::micro>(end - start).count() / count;
+        printf("%-8s %10.3f us/calcForces\n", scalar ? "scalar" : "batch", us);
+    }
+    m->setScalarSurfaces(false);
+
+    float diff[3];
+    Math::sub3(acc[0], acc[1], diff);
+    printf("acceleration difference: %g m/s^2 (of %g)\n", Math::mag3(diff), Math::mag3(acc[1]));
+}
+
+// Solve each aircraft and store the results in the solution cache
+// directory, so the simulator can skip the solver on startup.
+int populate_cache(const SGPath& dir, int count, char** files)
+{
+    int failures = 0;
+    for (int i = 0; i < count; i++) {
+        FGFDM* fdm = new FGFDM();
+        Airplane* a = fdm->getAirplane();
+        SGPath file = SGPath::fromLocal8Bit(files[i]);
+        try {
+            readXML(file, *fdm);
+            a->setSolutionCache(dir, Airplane::solutionModelKey(file));
+            a->compile();
+            if (a->getFailureMsg()) {
+                printf("%s: SOLUTION FAILURE: %s\n", files[i], a->getFailureMsg());
+                failures++;
+            } else {
+                printf("%s: %s\n", files[i], a->isSolutionCached() ? "already cached" : "solved");
+            }
+        }
+        catch (const sg_exception &e) {
+            printf("%s: XML parse error: %s (%s)\n", files[i], e.getFormattedMessage().c_str(), e.getOrigin());
+            failures++;
+        }
+        delete fdm;
+    }
+    return failures ? 1 : 0;
+}
+
 int usage()
 {
     fprintf(stderr, "Usage: \n");
@@ -402,6 +468,7 @@ int usage()
     fprintf(stderr, "  yasim <aircraft.xml> [-d [-a meters] [-approach | -cruise] ]\n");
     fprintf(stderr, "  yasim <aircraft.xml> [-m] [-h] [--min-speed]\n");
     fprintf(stderr, "  yasim <aircraft.xml> [-test] [-a meters] [-s kts] [-approach | -cruise] ]\n");
+    fprintf(stderr, "  yasim <aircraft.xml> [--bench [-n calls] [-a meters] [-s kts] [-approach | -cruise] ]\n");
     fprintf(stderr, "                       -g print lift/drag table: aoa, lift, drag, lift/drag \n");
     fprintf(stderr, "                       -d print drag over TAS: kts, drag\n");
     fprintf(stderr, "                       -D print kts at lowest drag at specified altitude\n");
@@ -409,11 +476,15 @@ int usage()
     fprintf(stderr, "                       -a set altitude in meters!\n");
     fprintf(stderr, "                       -s set speed in knots\n");
     fprintf(stderr, "                       -m print mass distribution table: id, x, y, z, mass \n");
+    fprintf(stderr, "                       --bench print time per force evaluation, batched and scalar\n");
     fprintf(stderr, "                     Options to generate LD curve and greater detailed plotting\n");
     fprintf(stderr, "  yasim <aircraft.xml> [--detailed-graph] [--detailed-drag]\n");
     fprintf(stderr, "  yasim <aircraft.xml> [--detailed-min-speed -approach]\n");
     fprintf(stderr, "  yasim <aircraft.xml> [--detailed-min-speed -cruise]\n");
     fprintf(stderr, "                       -test print summary and output like -g -m \n");
+    fprintf(stderr, "  yasim --populate-cache <dir> <aircraft.xml>...\n");
+    fprintf(stderr, "                       solve and store the results for the simulator,\n");
+    fprintf(stderr, "                       dir is the cache/yasim directory in $FG_HOME\n");
     return 1;
 }
 
@@ -426,6 +497,11 @@ int main(int argc, char** argv)
     if (argc < 2 || !strcmp(argv[1], "-h") || !strcmp(argv[1], "--help")) {
         return usage();
     }
+    if (!strcmp(argv[1], "--populate-cache")) {
+        delete fdm;
+        if (argc < 4) return usage();
+        return populate_cache(SGPath::fromLocal8Bit(argv[2]), argc - 3, argv + 3);
+    }
     // Read
     try {
         string file = argv[1];
@@ -551,6 +627,25 @@ int main(int argc, char** argv)
         else if(strcmp(argv[2], "-m") == 0) {
             yasim_masses(a);
         }
+        else if(strcmp(argv[2], "--bench") == 0) {
+            int count = 100000;
+            for(int i=3; i<argc; i++) {
+                if (std::strcmp(argv[i], "-a") == 0) {
+                    if (i+1 < argc) alt = std::atof(argv[++i]);
+                }
+                else if(std::strcmp(argv[i], "-s") == 0) {
+                    if(i+1 < argc) kts = std::atof(argv[++i]);
+                }
+                else if(std::strcmp(argv[i], "-n") == 0) {
+                    if(i+1 < argc) count = std::atoi(argv[++i]);
+                }
+                else if(std::strcmp(argv[i], "-approach") == 0) cfg = Airplane::APPROACH;
+                else if(std::strcmp(argv[i], "-cruise") == 0) cfg = Airplane::CRUISE;
+                else return usage();
+            }
+            if (count < 1) return usage();
+            yasim_bench(a, alt, kts, cfg, count);
+        }
         else if(strcmp(argv[2], "--min-speed") == 0) {
             alt = 10;
             for(int i=3; i<argc; i++) {
@@ -22,12 +22,14 @@
 
 #include <config.h>
 
+#include <algorithm>
 #include <cassert>
 #include <simgear/structure/exception.hxx>
 #include <simgear/props/props_io.hxx>
 
 #include <FDM/fdm_shell.hxx>
 #include <FDM/flight.hxx>
+#include <FDM/FDMThread.hxx>
 #include <Aircraft/replay.hxx>
 #include <Main/globals.hxx>
 #include <Main/fg_props.hxx>
@@ -69,6 +71,7 @@ FDMShell::FDMShell() : _tankProperties(fgGetNode("/consumables/fuel", true))
 
 FDMShell::~FDMShell()
 {
+    stopThread();
 }
 
 void FDMShell::init()
@@ -90,6 +93,12 @@ void FDMShell::init()
   _max_radius_nm    = _props->getNode("fdm/ai-wake/max-radius-nm",          true);
   _ai_wake_enabled  = _props->getNode("fdm/ai-wake/enabled",                true);
 
+  // optional dedicated FDM thread; fixed when the FDM is created
+  _threaded         = _props->getBoolValue("sim/fdm/threaded", false);
+  _speed_up         = _props->getNode("sim/speed-up",                       true);
+  _clock_freeze     = _props->getNode("sim/freeze/clock",                   true);
+  _thread_stats     = _props->getNode("fdm/stats",                          true);
+
   _nanCheckFailed = false;
   fgSetBool("/sim/fdm-nan-failure", false);
   _lastValidPos = SGGeod::invalid();
@@ -115,6 +124,8 @@ void FDMShell::postinit()
 
 void FDMShell::shutdown()
 {
+    stopThread();
+
     if (_impl) {
         fgSetBool("/sim/fdm-initialized", false);
         _impl->unbind();
@@ -131,6 +142,46 @@ void FDMShell::shutdown()
     _density_slugft .clear();
     _data_logging.clear();
     _replay_master.clear();
+    _speed_up.clear();
+    _clock_freeze.clear();
+    _thread_stats.clear();
+}
+
+std::unique_lock<std::recursive_timed_mutex> FDMShell::lockThread()
+{
+    return std::unique_lock<std::recursive_timed_mutex>(_threadLock);
+}
+
+void FDMShell::startThread()
+{
+    if (!_threaded || _thread) {
+        return;
+    }
+
+    const double dt = 1.0 / fgGetInt("/sim/model-hz");
+    SG_LOG(SG_FLIGHT, SG_INFO, "Running the FDM on a dedicated thread at " << (1.0 / dt) << "Hz");
+    if (!fgGetBool("/sim/property-locking/active")) {
+        // we keep it off the subsystem update, but rendering still reads properties
+        SG_LOG(SG_FLIGHT, SG_WARN, "FDM thread enabled without /sim/property-locking/active");
+    }
+
+    // the scene graph is only walked here, see update()
+    _impl->set_ground_cache_scene_access(false);
+    _impl->collect_ground_cache();
+
+    _thread.reset(new FDMThread(_impl, dt, _threadLock, _clock_freeze));
+    _thread->start();
+}
+
+void FDMShell::stopThread()
+{
+    if (_thread) {
+        _thread->stop();
+        _thread.reset();
+        if (_impl) {
+            _impl->set_ground_cache_scene_access(true);
+        }
+    }
 }
 
 void FDMShell::reinit()
@@ -161,6 +212,7 @@ void FDMShell::bind()
 
 void FDMShell::unbind()
 {
+  stopThread();
   if( _impl ) _impl->unbind();
   _tankProperties.unbind();
 }
@@ -215,17 +267,24 @@ void FDMShell::update(double dt)
     return; // still waiting
   }
 
+  // normally already held by the main loop
+  auto threadLock = lockThread();
+  startThread();
+
   // AI aerodynamic wake interaction
   if (_ai_wake_enabled->getBoolValue()) {
+      const SGVec3d pos = _impl->getCartPosition();
+      const double maxRangeM = _max_radius_nm->getDoubleValue()*SG_NM_TO_METER;
+      const double maxRangeSqr = maxRangeM*maxRangeM;
+
       for (FGAIBase* base : _ai_mgr->get_ai_list()) {
           try {
               if (base->isa(FGAIBase::object_type::otAircraft) ) {
-                  SGVec3d pos = _impl->getCartPosition();
-                  const SGSharedPtr<FGAIAircraft> aircraft = dynamic_cast<FGAIAircraft*>(base);
-                  double range = _ai_mgr->calcRangeFt(pos, aircraft)*SG_FEET_TO_METER;
+                  // isa() has checked the type already
+                  FGAIAircraft* aircraft = static_cast<FGAIAircraft*>(base);
 
                   if (!aircraft->onGround() && aircraft->getSpeed() > 0.0
-                      && range < _max_radius_nm->getDoubleValue()*SG_NM_TO_METER) {
+                      && distSqr(pos, aircraft->getCartPos()) < maxRangeSqr) {
                       _impl->add_ai_wake(aircraft);
                   }
               }
@@ -239,21 +298,31 @@ void FDMShell::update(double dt)
   }
 
   // pull environmental data in, since the FDMs are lazy
-  _impl->set_Velocities_Local_Airmass(
-          _wind_north->getDoubleValue(),
-          _wind_east->getDoubleValue(),
-          _wind_down->getDoubleValue());
+  FDMThread::Inputs inputs;
+  inputs.windNorthFps = _wind_north->getDoubleValue();
+  inputs.windEastFps = _wind_east->getDoubleValue();
+  inputs.windDownFps = _wind_down->getDoubleValue();
 
-  if (_control_fdm_atmo->getBoolValue()) {
+  inputs.controlAtmosphere = _control_fdm_atmo->getBoolValue();
+  if (inputs.controlAtmosphere) {
     // convert from Rankine to Celsius
     double tempDegC = _temp_degc->getDoubleValue();
-    _impl->set_Static_temperature((9.0/5.0) * (tempDegC + 273.15));
-    
+    inputs.staticTemperatureR = (9.0/5.0) * (tempDegC + 273.15);
+
     // convert from inHG to PSF
     double pressureInHg = _pressure_inhg->getDoubleValue();
-    _impl->set_Static_pressure(pressureInHg * 70.726566);
+    inputs.staticPressurePsf = pressureInHg * 70.726566;
     // keep in slugs/ft^3
-    _impl->set_Density(_density_slugft->getDoubleValue());
+    inputs.densitySlugFt3 = _density_slugft->getDoubleValue();
+  }
+
+  if (!_thread) {
+    _impl->set_Velocities_Local_Airmass(inputs.windNorthFps, inputs.windEastFps, inputs.windDownFps);
+    if (inputs.controlAtmosphere) {
+      _impl->set_Static_temperature(inputs.staticTemperatureR);
+      _impl->set_Static_pressure(inputs.staticPressurePsf);
+      _impl->set_Density(inputs.densitySlugFt3);
+    }
   }
 
   bool doLog = _data_logging->getBoolValue();
@@ -266,7 +335,12 @@ void FDMShell::update(double dt)
   {
       case 0:
           // normal FDM operation
-          _impl->update(dt);
+          if (_thread) {
+              // the thread runs in real time, so apply speed-up there
+              inputs.iterations = std::max(1, static_cast<int>(_speed_up->getDoubleValue() + 0.5));
+          } else {
+              _impl->update(dt);
+          }
           break;
       case 3:
           // resume FDM operation at current replay position
@@ -277,6 +351,15 @@ void FDMShell::update(double dt)
           break;
   }
 
+  if (_thread) {
+      // the FDM thread may not walk the scene graph, which the pager and
+      // the tile manager modify on this thread: collect ahead for it
+      _impl->collect_ground_cache();
+      _thread->setInputs(inputs);
+      _thread->applyDisplayState();
+      _thread->updateStats(_thread_stats);
+  }
+
   validateOutputProperties();
 }
 
@@ -22,6 +22,9 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
+
 #include <simgear/math/SGGeod.hxx>
 #include <simgear/structure/subsystem_mgr.hxx>
 
@@ -30,6 +33,7 @@
 // forward decls
 class FGInterface;
 class FGAIManager;
+class FDMThread;
 
 /**
  * Wrap an FDM implementation in a subsystem with standard semantics
@@ -59,6 +63,19 @@ public:
 
     FGInterface* getInterface() const;
 
+    /**
+     * When the FDM runs on its own thread (/sim/fdm/threaded), hold it off
+     * for as long as the returned lock is owned. The main loop holds this
+     * across the subsystem update and the event and update traversals of
+     * the viewer, so the FDM state, the properties it uses and the scene
+     * graph are never accessed concurrently. Without a thread the lock is
+     * still taken, and is uncontended.
+     */
+    std::unique_lock<std::recursive_timed_mutex> lockThread();
+
+    /// whether the FDM iterates on its own thread
+    bool threadRunning() const { return _thread != nullptr; }
+
 private:
     void createImplementation();
 
@@ -66,6 +83,9 @@ private:
 
     void doInitAndBind();
 
+    void startThread();
+    void stopThread();
+
 private:
     TankPropertiesList _tankProperties;
     SGSharedPtr<FGInterface> _impl;
@@ -84,4 +104,9 @@ private:
     SGSharedPtr<FGAIManager> _ai_mgr;
     SGPropertyNode_ptr _max_radius_nm;
     SGPropertyNode_ptr _ai_wake_enabled;
+
+    bool _threaded = false;
+    std::recursive_timed_mutex _threadLock;
+    std::unique_ptr<FDMThread> _thread;
+    SGPropertyNode_ptr _speed_up, _clock_freeze, _thread_stats;
 };
@@ -175,6 +175,8 @@ void FGInterface::common_init()
     set_inited(true);
 
     ground_cache.set_cache_time_offset(globals->get_sim_time_sec());
+    // keep the collected ground for up to that many seconds of movement
+    ground_cache.set_lookahead(fgGetDouble("/fdm/ground-cache/lookahead-sec", 1.0));
 
     // Set initial position
     SG_LOG(SG_FLIGHT, SG_INFO, "...initializing position...");
@@ -449,6 +451,24 @@ void FGInterface::bind()
 
     _tiedProperties.Tie("/accelerations/n-z-cg-fps_sec",
                         this, &FGInterface::get_N_Z_cg); // read-only
+
+    // Ground cache statistics
+    _tiedProperties.Tie("/fdm/ground-cache/builds",
+                        this, &FGInterface::get_ground_cache_builds); // read-only
+    _tiedProperties.Tie("/fdm/ground-cache/reuses",
+                        this, &FGInterface::get_ground_cache_reuses); // read-only
+    _tiedProperties.Tie("/fdm/ground-cache/misses",
+                        this, &FGInterface::get_ground_cache_misses); // read-only
+    _tiedProperties.Tie("/fdm/ground-cache/build-ms",
+                        this, &FGInterface::get_ground_cache_build_ms); // read-only
+    _tiedProperties.Tie("/fdm/ground-cache/lookups",
+                        this, &FGInterface::get_ground_cache_lookups); // read-only
+    _tiedProperties.Tie("/fdm/ground-cache/batches",
+                        this, &FGInterface::get_ground_cache_batches); // read-only
+    _tiedProperties.Tie("/fdm/ground-cache/batch-points",
+                        this, &FGInterface::get_ground_cache_batch_points); // read-only
+    _tiedProperties.Tie("/fdm/ground-cache/lookup-us",
+                        this, &FGInterface::get_ground_cache_lookup_us); // read-only
 }
 
 
@@ -774,6 +794,15 @@ bool FGInterface::prepare_ground_cache_ft(double startSimTime, double endSimTime
                                              pt_ft, rad * SG_FEET_TO_METER);
 }
 
+bool FGInterface::collect_ground_cache()
+{
+    // around where the FDM asked last time, at its time
+    double ref_time, rad;
+    SGVec3d pt;
+    ground_cache.is_valid(ref_time, pt, rad);
+    return ground_cache.collect_ahead(ref_time, getCartPosition(), SGMiscd::max(rad, 10));
+}
+
 bool FGInterface::is_valid_m(double* ref_time, double pt[3], double* rad)
 {
     SGVec3d _pt;
@@ -861,6 +890,21 @@ bool FGInterface::get_agl_m(double t, const double pt[3], double max_altoff,
     return ret;
 }
 
+unsigned FGInterface::get_agl_m(double t, double max_altoff,
+                                FGGroundCache::AglQuery* queries, unsigned count)
+{
+    for (unsigned i = 0; i < count; ++i)
+        queries[i].pt -= max_altoff * ground_cache.get_down();
+
+    unsigned found = ground_cache.get_agl(t, queries, count);
+    // velocities at the contact points, as for a single query
+    for (unsigned i = 0; i < count; ++i) {
+        FGGroundCache::AglQuery& q = queries[i];
+        q.linearVel += cross(q.angularVel, q.contact - q.pt);
+    }
+    return found;
+}
+
 bool FGInterface::get_agl_ft(double t, const double pt[3], double max_altoff,
                              double contact[3], double normal[3],
                              double linearVel[3], double angularVel[3],
@@ -149,6 +149,11 @@ private:
 
     FlightState _state;
 
+    // exchanges the flight state with the FDM it iterates
+    friend class FDMThread;
+    const FlightState& getState() const { return _state; }
+    void setState(const FlightState& state) { _state = state; }
+
     simgear::TiedPropertyList _tiedProperties;
 
     // the ground cache object itself.
@@ -157,6 +162,16 @@ private:
     GroundReactions _groundReactions;
     AIWakeGroup wake_group;
 
+    // ground cache statistics, see bind()
+    int get_ground_cache_builds() const { return ground_cache.get_stats().builds; }
+    int get_ground_cache_reuses() const { return ground_cache.get_stats().reuses; }
+    int get_ground_cache_misses() const { return ground_cache.get_stats().misses; }
+    double get_ground_cache_build_ms() const { return ground_cache.get_stats().buildMs; }
+    int get_ground_cache_lookups() const { return ground_cache.get_stats().lookups; }
+    int get_ground_cache_batches() const { return ground_cache.get_stats().batches; }
+    int get_ground_cache_batch_points() const { return ground_cache.get_stats().batchPoints; }
+    double get_ground_cache_lookup_us() const { return ground_cache.get_stats().lookupUs; }
+
     void set_A_X_pilot(double x)
     {
         _set_Accels_Pilot_Body(x, _state.a_pilot_body_v[1], _state.a_pilot_body_v[2]);
@@ -346,6 +361,12 @@ public:
     bool readState(SGIOChannel* io);
     bool writeState(SGIOChannel* io);
 
+    // While the FDM runs on its own thread, the ground cache is collected
+    // here, on the main thread, around the current position, and
+    // prepare_ground_cache_* only serve from it.
+    void set_ground_cache_scene_access(bool access) { ground_cache.set_scene_access(access); }
+    bool collect_ground_cache();
+
     // Define the various supported flight models (many not yet implemented)
     enum {
         // Magic Carpet mode
@@ -697,6 +718,12 @@ public:
                     double contact[3], double normal[3], double linearVel[3],
                     double angularVel[3], simgear::BVHMaterial const*& material,
                     simgear::BVHNode::Id& id);
+
+    // Same as get_agl_m for several points at once, with a single traversal
+    // of the ground cache. The query points are moved up by max_altoff
+    // on return. Returns the number of points with ground found below.
+    unsigned get_agl_m(double t, double max_altoff,
+                       FGGroundCache::AglQuery* queries, unsigned count);
     double get_groundlevel_m(double lat, double lon, double alt);
     double get_groundlevel_m(const SGGeod& geod);
 
@@ -57,6 +57,23 @@
 
 using namespace simgear;
 
+namespace {
+
+// exponential smoothing factor for the timing statistics
+const double statsSmoothing = 0.05;
+
+// extra radius collected around the predicted path
+const double lookaheadMargin = 20;
+
+// position changes faster than this are taken as repositioning
+const double maxPredictedSpeed = 1000;
+
+// lookahead when the tree is collected on the main thread for the FDM
+// thread, which can not collect when it runs out of it
+const double minThreadedLookahead = 1;
+
+} // namespace
+
 class FGGroundCache::CacheFill : public osg::NodeVisitor {
 public:
     CacheFill(const SGVec3d& center, const SGVec3d& down, const double& radius,
@@ -287,12 +304,6 @@ FGGroundCache::FGGroundCache() :
     down(0.0, 0.0, 0.0),
     found_ground(false)
 {
-#ifdef GROUNDCACHE_DEBUG
-    _lookupTime = SGTimeStamp::fromSec(0.0);
-    _lookupCount = 0;
-    _buildTime = SGTimeStamp::fromSec(0.0);
-    _buildCount = 0;
-#endif
 }
 
 FGGroundCache::~FGGroundCache()
@@ -308,27 +319,25 @@ FGGroundCache::prepare_ground_cache(double startSimTime, double endSimTime,
         rad = 10000.0;
     }
 
-#ifdef GROUNDCACHE_DEBUG
-    SGTimeStamp t0 = SGTimeStamp::now();
-#endif
-
     // Empty cache.
+    const bool hadGround = found_ground;
     found_ground = false;
 
-    auto scenery = globals->get_scenery();
-    if (!scenery) {
-        return false;
-    }
-
     SGGeod geodPt = SGGeod::fromCart(pt);
-    // Don't blow away the cache ground_radius and stuff if there's no
-    // scenery
-    if (!scenery->schedule_scenery(geodPt, rad, 1.0)) {
-        SG_LOG(SG_FLIGHT, SG_BULK, "prepare_ground_cache(): scenery_available "
-               "returns false at " << geodPt << " " << pt << " " << rad);
-        return false;
+    if (_sceneAccess) {
+        auto scenery = globals->get_scenery();
+        if (!scenery) {
+            return false;
+        }
+
+        // Don't blow away the cache ground_radius and stuff if there's no
+        // scenery
+        if (!scenery->schedule_scenery(geodPt, rad, 1.0)) {
+            SG_LOG(SG_FLIGHT, SG_BULK, "prepare_ground_cache(): scenery_available "
+                   "returns false at " << geodPt << " " << pt << " " << rad);
+            return false;
+        }
     }
-    _material = 0;
 
     // If we have an active wire, get some more area into the groundcache
     if (_wire)
@@ -344,12 +353,108 @@ FGGroundCache::prepare_ground_cache(double startSimTime, double endSimTime,
     SGQuatd hlToEc = SGQuatd::fromLonLat(geodPt);
     down = hlToEc.rotate(SGVec3d(0, 0, 1));
 
-    // Get the ground cache, that is a local collision tree of the environment
+    // Estimate where the vehicle is heading from the previous call
+    _velocity = SGVec3d::zeros();
+    const double dt = startSimTime - _lastPrepareTime;
+    if (_havePrepared && 0 < dt) {
+        _velocity = (pt - _lastPreparePoint)/dt;
+        // a reposition, not a movement
+        if (maxPredictedSpeed < norm(_velocity))
+            _velocity = SGVec3d::zeros();
+    }
+    _havePrepared = true;
+    _lastPreparePoint = pt;
+    _lastPrepareTime = startSimTime;
+
     startSimTime += cache_time_offset;
     endSimTime += cache_time_offset;
-    CacheFill subtreeCollector(pt, down, rad, startSimTime, endSimTime);
+
+    // Keep the tree as long as the requested sphere and time span lie
+    // within what was collected last time.
+    if (hadGround && covers(pt, rad, startSimTime, endSimTime)) {
+        // refresh the coarse altitude, or keep the last one
+        findGroundBelow(pt, startSimTime);
+        found_ground = true;
+        _stats.reuses++;
+        return found_ground;
+    }
+
+    if (!_sceneAccess) {
+        // The main thread has not caught up with the vehicle yet, see
+        // collect_ahead(). Use what we have until it does.
+        _stats.misses++;
+        found_ground = (_localBvhTree && findGroundBelow(pt, startSimTime)) || hadGround;
+        return found_ground;
+    }
+
+    return collect(pt, rad, startSimTime, endSimTime, _lookahead);
+}
+
+bool
+FGGroundCache::collect_ahead(double startSimTime, const SGVec3d& pt, double rad)
+{
+    rad = SGMiscd::min(rad, 10000.0);
+
+    auto scenery = globals->get_scenery();
+    SGGeod geodPt = SGGeod::fromCart(pt);
+    if (!scenery || !scenery->schedule_scenery(geodPt, rad, 1.0)) {
+        return false;
+    }
+
+    if (_wire)
+        rad = SGMiscd::max(200, rad);
+
+    // Without any lookahead the FDM thread would miss on every step
+    const double lookahead = SGMiscd::max(_lookahead, minThreadedLookahead);
+    startSimTime += cache_time_offset;
+    if (found_ground && covers(pt, rad, startSimTime, startSimTime + 0.5*lookahead)) {
+        return true;
+    }
+
+    SGQuatd hlToEc = SGQuatd::fromLonLat(geodPt);
+    down = hlToEc.rotate(SGVec3d(0, 0, 1));
+    return collect(pt, rad, startSimTime, startSimTime + lookahead, lookahead);
+}
+
+bool
+FGGroundCache::covers(const SGVec3d& pt, double rad, double startSimTime,
+                      double endSimTime) const
+{
+    return _localBvhTree &&
+        _collectedStartTime <= startSimTime && endSimTime <= _collectedEndTime &&
+        dist(pt, _collectedCenter) + rad <= _collectedRadius;
+}
+
+bool
+FGGroundCache::collect(const SGVec3d& pt, double rad, double startSimTime,
+                       double endSimTime, double lookahead)
+{
+    SGTimeStamp t0 = SGTimeStamp::now();
+
+    found_ground = false;
+    _material = 0;
+
+    // Collect ahead of the vehicle: a sphere covering its predicted
+    // path over the lookahead time, so the next calls can reuse it.
+    lookahead = SGMiscd::max(0, lookahead);
+    SGVec3d center = pt;
+    double collectRadius = rad;
+    double collectEndTime = endSimTime;
+    if (0 < lookahead) {
+        center += (0.5*lookahead)*_velocity;
+        collectRadius += 0.5*lookahead*norm(_velocity) + lookaheadMargin;
+        collectRadius = SGMiscd::min(collectRadius, 10000.0);
+        collectEndTime = SGMiscd::max(endSimTime, startSimTime + lookahead);
+    }
+
+    // Get the ground cache, that is a local collision tree of the environment
+    CacheFill subtreeCollector(center, down, collectRadius, startSimTime, collectEndTime);
     globals->get_scenery()->get_scene_graph()->accept(subtreeCollector);
     _localBvhTree = subtreeCollector.getBVHNode();
+    _collectedCenter = center;
+    _collectedRadius = collectRadius;
+    _collectedStartTime = startSimTime;
+    _collectedEndTime = collectEndTime;
 
     if (subtreeCollector.getHaveElevationBelowCache()) {
         // Use the altitude value below the cache that we gathered during
@@ -360,16 +465,7 @@ FGGroundCache::prepare_ground_cache(double startSimTime, double endSimTime,
     } else if (_localBvhTree) {
         // We have nothing below us, so try starting with the lowest point
         // upwards for a coarse altitude value
-        SGLineSegmentd line(pt + reference_vehicle_radius*down, pt - 1e3*down);
-        simgear::BVHLineSegmentVisitor lineSegmentVisitor(line, startSimTime);
-        _localBvhTree->accept(lineSegmentVisitor);
-
-        if (!lineSegmentVisitor.empty()) {
-            SGGeod geodPt = SGGeod::fromCart(lineSegmentVisitor.getPoint());
-            _altitude = geodPt.getElevationM();
-            _material = lineSegmentVisitor.getMaterial();
-            found_ground = true;
-        }
+        found_ground = findGroundBelow(pt, startSimTime);
     }
 
     if (!found_ground) {
@@ -377,7 +473,7 @@ FGGroundCache::prepare_ground_cache(double startSimTime, double endSimTime,
         double alt = 0;
         _material = 0;
         found_ground = globals->get_scenery()->
-            get_elevation_m(SGGeod::fromGeodM(geodPt, 10000), alt, &_material);
+            get_elevation_m(SGGeod::fromGeodM(SGGeod::fromCart(pt), 10000), alt, &_material);
         if (found_ground)
             _altitude = alt;
     }
@@ -389,26 +485,11 @@ FGGroundCache::prepare_ground_cache(double startSimTime, double endSimTime,
     //    SG_LOG(SG_FLIGHT, SG_WARN, "prepare_ground_cache(): trying to build "
     //           "cache without any scenery below the aircraft");
 
-#ifdef GROUNDCACHE_DEBUG
-    t0 = SGTimeStamp::now() - t0;
-    _buildTime += t0;
-    _buildCount++;
-
-    if (_buildCount > 60) {
-        double buildTime = 0;
-        if (_buildCount)
-            buildTime = _buildTime.toSecs()/_buildCount;
-        double lookupTime = 0;
-        if (_lookupCount)
-            lookupTime = _lookupTime.toSecs()/_lookupCount;
-        _buildTime = SGTimeStamp::fromSec(0.0);
-        _buildCount = 0;
-        _lookupTime = SGTimeStamp::fromSec(0.0);
-        _lookupCount = 0;
-        SG_LOG(SG_FLIGHT, SG_ALERT, "build time = " << buildTime
-               << ", lookup Time = " << lookupTime);
-    }
+    const double buildMs = (SGTimeStamp::now() - t0).toSecs() * 1000;
+    _stats.buildMs += (buildMs - _stats.buildMs) * statsSmoothing;
+    _stats.builds++;
 
+#ifdef GROUNDCACHE_DEBUG
     if (!_group.valid()) {
         _group = new osg::Group;
         globals->get_scenery()->get_scene_graph()->addChild(_group);
@@ -428,6 +509,21 @@ FGGroundCache::prepare_ground_cache(double startSimTime, double endSimTime,
     return found_ground;
 }
 
+bool
+FGGroundCache::findGroundBelow(const SGVec3d& pt, double t)
+{
+    SGLineSegmentd line(pt + reference_vehicle_radius*down, pt - 1e3*down);
+    simgear::BVHLineSegmentVisitor lineSegmentVisitor(line, t);
+    _localBvhTree->accept(lineSegmentVisitor);
+    if (lineSegmentVisitor.empty())
+        return false;
+
+    SGGeod geodPt = SGGeod::fromCart(lineSegmentVisitor.getPoint());
+    _altitude = geodPt.getElevationM();
+    _material = lineSegmentVisitor.getMaterial();
+    return true;
+}
+
 bool
 FGGroundCache::is_valid(double& ref_time, SGVec3d& pt, double& rad)
 {
@@ -696,9 +792,7 @@ FGGroundCache::get_agl(double t, const SGVec3d& pt, SGVec3d& contact,
         throw sg_range_exception("FGGroundCache::get_agl: NaN position input");
     }
 
-#ifdef GROUNDCACHE_DEBUG
     SGTimeStamp t0 = SGTimeStamp::now();
-#endif
 
     // Just set up a ground intersection query for the given point
     SGLineSegmentd line(pt, pt + 10*reference_vehicle_radius*down);
@@ -707,11 +801,8 @@ FGGroundCache::get_agl(double t, const SGVec3d& pt, SGVec3d& contact,
     if (_localBvhTree)
         _localBvhTree->accept(lineSegmentVisitor);
 
-#ifdef GROUNDCACHE_DEBUG
-    t0 = SGTimeStamp::now() - t0;
-    _lookupTime += t0;
-    _lookupCount++;
-#endif
+    _stats.lookups++;
+    addLookupTime(t0, 1);
 
     if (!lineSegmentVisitor.empty()) {
         // Have an intersection
@@ -743,6 +834,272 @@ FGGroundCache::get_agl(double t, const SGVec3d& pt, SGVec3d& contact,
 }
 
 
+// Intersects a packet of line segments with the tree in one traversal.
+// Per segment this does what BVHLineSegmentVisitor does for a single one:
+// each hit shortens the segment, so the nearest triangle wins. A subtree
+// is entered if any of the still active segments touches its bounds, and
+// below it only those segments are tested.
+class FGGroundCache::GroundIntersector : public BVHVisitor {
+public:
+    GroundIntersector(AglQuery* queries, std::vector<SGLineSegmentd>& segments,
+                      std::vector<unsigned>& active, const double& t) :
+        _queries(queries),
+        _segments(segments),
+        _active(active),
+        _begin(0),
+        _end(active.size()),
+        _time(t)
+    { }
+
+    virtual void apply(BVHGroup& group)
+    {
+        const SGSphered& sphere = group.getBoundingSphere();
+        narrow([&](const SGLineSegmentd& s) { return intersects(sphere, s); },
+               [&] { group.traverse(*this); });
+    }
+    virtual void apply(BVHPageNode& node)
+    {
+        const SGSphered& sphere = node.getBoundingSphere();
+        narrow([&](const SGLineSegmentd& s) { return intersects(sphere, s); },
+               [&] { node.traverse(*this); });
+    }
+    virtual void apply(BVHTransform& transform)
+    {
+        const SGSphered& sphere = transform.getBoundingSphere();
+        narrow([&](const SGLineSegmentd& s) { return intersects(sphere, s); },
+               [&] {
+            const SGMatrixd& toLocal = transform.getToLocalTransform();
+            const SGMatrixd& toWorld = transform.getToWorldTransform();
+            std::vector<Saved> saved = push(toLocal);
+            transform.traverse(*this);
+            for (size_t i = _begin; i < _end; ++i) {
+                const Saved& old = saved[i - _begin];
+                AglQuery& q = _queries[_active[i]];
+                SGLineSegmentd& s = _segments[_active[i]];
+                if (q.found) {
+                    q.linearVel = transform.vecToWorld(q.linearVel);
+                    q.angularVel = transform.vecToWorld(q.angularVel);
+                    q.normal = transform.vecToWorld(q.normal);
+                    s = SGLineSegmentd(old.segment.getStart(), toWorld.xformPt(s.getEnd()));
+                } else {
+                    pop(old, q, s);
+                }
+            }
+        });
+    }
+    virtual void apply(BVHMotionTransform& transform)
+    {
+        const SGSphered& sphere = transform.getBoundingSphere();
+        narrow([&](const SGLineSegmentd& s) { return intersects(sphere, s); },
+               [&] {
+            std::vector<Saved> saved = push(transform.getToLocalTransform(_time));
+            transform.traverse(*this);
+            SGMatrixd toWorld = transform.getToWorldTransform(_time);
+            for (size_t i = _begin; i < _end; ++i) {
+                const Saved& old = saved[i - _begin];
+                AglQuery& q = _queries[_active[i]];
+                SGLineSegmentd& s = _segments[_active[i]];
+                if (q.found) {
+                    q.linearVel += transform.getLinearVelocityAt(s.getStart());
+                    q.angularVel += transform.getAngularVelocity();
+                    q.linearVel = toWorld.xformVec(q.linearVel);
+                    q.angularVel = toWorld.xformVec(q.angularVel);
+                    q.normal = toWorld.xformVec(q.normal);
+                    s = SGLineSegmentd(old.segment.getStart(), toWorld.xformPt(s.getEnd()));
+                    if (!q.id)
+                        q.id = transform.getId();
+                } else {
+                    pop(old, q, s);
+                }
+            }
+        });
+    }
+    virtual void apply(BVHLineGeometry& node) { }
+    virtual void apply(BVHStaticGeometry& node)
+    {
+        const SGSphered& sphere = node.getBoundingSphere();
+        narrow([&](const SGLineSegmentd& s) { return intersects(sphere, s); },
+               [&] { node.traverse(*this); });
+    }
+    virtual void apply(BVHTerrainTile& tile)
+    {
+        // Terrain tiles build their geometry on demand, leave that to the
+        // single segment visitor.
+        for (size_t i = _begin; i < _end; ++i) {
+            AglQuery& q = _queries[_active[i]];
+            SGLineSegmentd& s = _segments[_active[i]];
+            BVHLineSegmentVisitor visitor(s, _time);
+            tile.accept(visitor);
+            if (visitor.empty())
+                continue;
+            s = SGLineSegmentd(s.getStart(), visitor.getPoint());
+            q.normal = visitor.getNormal();
+            q.linearVel = visitor.getLinearVelocity();
+            q.angularVel = visitor.getAngularVelocity();
+            q.material = visitor.getMaterial();
+            q.id = visitor.getId();
+            q.found = true;
+        }
+    }
+
+    virtual void apply(const BVHStaticBinary& node, const BVHStaticData& data)
+    {
+        const SGBoxf& box = node.getBoundingBox();
+        narrow([&](const SGLineSegmentd& s) { return intersects(SGLineSegmentf(s), box); },
+               [&] {
+            // Enter the child nearest to the first start point first: the
+            // contact points are close together, and a hit there may cut
+            // the segments short enough to skip the other child.
+            node.traverse(*this, data, _segments[_active[_begin]].getStart());
+        });
+    }
+    virtual void apply(const BVHStaticTriangle& triangle, const BVHStaticData& data)
+    {
+        SGTrianglef tri = triangle.getTriangle(data);
+        for (size_t i = _begin; i < _end; ++i) {
+            SGLineSegmentd& s = _segments[_active[i]];
+            SGVec3f point;
+            if (!intersects(point, tri, SGLineSegmentf(s), 1e-4f))
+                continue;
+            AglQuery& q = _queries[_active[i]];
+            s = SGLineSegmentd(s.getStart(), SGVec3d(point));
+            q.normal = SGVec3d(tri.getNormal());
+            q.linearVel = SGVec3d::zeros();
+            q.angularVel = SGVec3d::zeros();
+            q.material = data.getMaterial(triangle.getMaterialIndex());
+            q.id = 0;
+            q.found = true;
+        }
+    }
+
+private:
+    struct Saved {
+        SGLineSegmentd segment;
+        SGVec3d normal;
+        SGVec3d linearVel;
+        SGVec3d angularVel;
+        const BVHMaterial* material;
+        BVHNode::Id id;
+        bool found;
+    };
+
+    // Run body with the active set narrowed to the segments passing test.
+    // The subsets are stacked at the end of _active.
+    template<typename Test, typename Body>
+    void narrow(Test test, Body body)
+    {
+        const size_t begin = _begin, end = _end;
+        const size_t subset = _active.size();
+        for (size_t i = begin; i < end; ++i) {
+            if (test(_segments[_active[i]]))
+                _active.push_back(_active[i]);
+        }
+        if (_active.size() == subset)
+            return;
+
+        _begin = subset;
+        _end = _active.size();
+        body();
+        _active.resize(subset);
+        _begin = begin;
+        _end = end;
+    }
+
+    // Save the active segments' state and move them into a local frame
+    std::vector<Saved> push(const SGMatrixd& toLocal)
+    {
+        std::vector<Saved> saved;
+        saved.reserve(_end - _begin);
+        for (size_t i = _begin; i < _end; ++i) {
+            AglQuery& q = _queries[_active[i]];
+            SGLineSegmentd& s = _segments[_active[i]];
+            saved.push_back({s, q.normal, q.linearVel, q.angularVel, q.material, q.id, q.found});
+            s = s.transform(toLocal);
+            q.found = false;
+        }
+        return saved;
+    }
+
+    static void pop(const Saved& old, AglQuery& q, SGLineSegmentd& s)
+    {
+        s = old.segment;
+        q.normal = old.normal;
+        q.linearVel = old.linearVel;
+        q.angularVel = old.angularVel;
+        q.material = old.material;
+        q.id = old.id;
+        q.found = old.found;
+    }
+
+    AglQuery* _queries;
+    std::vector<SGLineSegmentd>& _segments;
+    std::vector<unsigned>& _active;
+    size_t _begin;
+    size_t _end;
+    double _time;
+};
+
+unsigned
+FGGroundCache::get_agl(double t, AglQuery* queries, unsigned count)
+{
+    SGTimeStamp t0 = SGTimeStamp::now();
+
+    _batchSegments.resize(count);
+    _batchActive.clear();
+    for (unsigned i = 0; i < count; ++i) {
+        AglQuery& q = queries[i];
+        if (isNaN(q.pt)) {
+            throw sg_range_exception("FGGroundCache::get_agl: NaN position input");
+        }
+        _batchSegments[i] = SGLineSegmentd(q.pt, q.pt + 10*reference_vehicle_radius*down);
+        _batchActive.push_back(i);
+        q.found = false;
+    }
+
+    t += cache_time_offset;
+    if (_localBvhTree && count) {
+        GroundIntersector intersector(queries, _batchSegments, _batchActive, t);
+        _localBvhTree->accept(intersector);
+    }
+
+    _stats.batches++;
+    _stats.batchPoints += count;
+    addLookupTime(t0, count);
+
+    unsigned found = 0;
+    for (unsigned i = 0; i < count; ++i) {
+        AglQuery& q = queries[i];
+        if (q.found) {
+            q.contact = _batchSegments[i].getEnd();
+            if (0 < dot(q.normal, down))
+                q.normal = -q.normal;
+        } else {
+            // No ground triangle below, same fallback as for a single point
+            SGGeod geodPt = SGGeod::fromCart(q.pt);
+            geodPt.setElevationM(_altitude);
+            q.contact = SGVec3d::fromGeod(geodPt);
+            q.normal = -down;
+            q.linearVel = SGVec3d(0, 0, 0);
+            q.angularVel = SGVec3d(0, 0, 0);
+            q.material = _material;
+            q.id = 0;
+            q.found = found_ground;
+        }
+        if (q.found)
+            ++found;
+    }
+    return found;
+}
+
+void FGGroundCache::addLookupTime(const SGTimeStamp& start, unsigned points)
+{
+    if (!points)
+        return;
+    const double us = (SGTimeStamp::now() - start).toSecs() * 1e6 / points;
+    _stats.lookupUs += (us - _stats.lookupUs) * statsSmoothing;
+}
+
+
 bool
 FGGroundCache::get_nearest(double t, const SGVec3d& pt, double maxDist,
                            SGVec3d& contact, SGVec3d& linearVel,
@@ -752,9 +1109,7 @@ FGGroundCache::get_nearest(double t, const SGVec3d& pt, double maxDist,
     if (!_localBvhTree)
         return false;
 
-#ifdef GROUNDCACHE_DEBUG
     SGTimeStamp t0 = SGTimeStamp::now();
-#endif
 
     // Just set up a ground intersection query for the given point
     SGSphered sphere(pt, maxDist);
@@ -762,11 +1117,8 @@ FGGroundCache::get_nearest(double t, const SGVec3d& pt, double maxDist,
     simgear::BVHNearestPointVisitor nearestPointVisitor(sphere, t);
     _localBvhTree->accept(nearestPointVisitor);
 
-#ifdef GROUNDCACHE_DEBUG
-    t0 = SGTimeStamp::now() - t0;
-    _lookupTime += t0;
-    _lookupCount++;
-#endif
+    _stats.lookups++;
+    addLookupTime(t0, 1);
 
     if (nearestPointVisitor.empty())
         return false;
@@ -22,18 +22,20 @@
 
 #pragma once
 
+#include <vector>
+
 #include <simgear/compiler.h>
 #include <simgear/constants.h>
 #include <simgear/math/SGMath.hxx>
 #include <simgear/math/SGGeometry.hxx>
 #include <simgear/bvh/BVHNode.hxx>
 #include <simgear/structure/SGSharedPtr.hxx>
+#include <simgear/timing/timestamp.hxx>
 
 // #define GROUNDCACHE_DEBUG
 #ifdef GROUNDCACHE_DEBUG
 #include <osg/Group>
 #include <osg/ref_ptr>
-#include <simgear/timing/timestamp.hxx>
 #endif
 
 namespace simgear {
@@ -41,8 +43,46 @@ class BVHLineGeometry;
 class BVHMaterial;
 }
 
+namespace FGTestApi {
+namespace PrivateAccessor {
+namespace FDM {
+class Accessor;
+}
+} // namespace PrivateAccessor
+} // namespace FGTestApi
+
 class FGGroundCache {
 public:
+    // One point of a batched get_agl query, pt is the input.
+    struct AglQuery {
+        SGVec3d pt;
+
+        SGVec3d contact;
+        SGVec3d normal;
+        SGVec3d linearVel;
+        SGVec3d angularVel;
+        simgear::BVHNode::Id id = 0;
+        const simgear::BVHMaterial* material = nullptr;
+        // Same meaning as the return value of the single point get_agl
+        bool found = false;
+    };
+
+    // Cumulative lookup and build counters, and smoothed timings.
+    struct Stats {
+        unsigned builds = 0;
+        // prepare calls served by the previously collected tree
+        unsigned reuses = 0;
+        // prepare calls outside the tree while the scene may not be
+        // walked, served by it anyway
+        unsigned misses = 0;
+        double buildMs = 0;
+        unsigned lookups = 0;
+        unsigned batches = 0;
+        unsigned batchPoints = 0;
+        // per point, for single and batched lookups alike
+        double lookupUs = 0;
+    };
+
     FGGroundCache();
     ~FGGroundCache();
 
@@ -56,6 +96,26 @@ public:
     bool prepare_ground_cache(double startSimTime, double endSimTime,
                               const SGVec3d& pt, double rad);
 
+    // How far ahead, in seconds of the vehicle's movement, the cache is
+    // collected. Until the vehicle leaves that area the collected tree is
+    // kept instead of being rebuilt on every prepare_ground_cache call.
+    // 0 collects just the requested sphere each time.
+    void set_lookahead(double seconds)
+    { _lookahead = seconds; }
+
+    // Whether prepare_ground_cache may walk the scene graph. It may not
+    // while the FDM runs on its own thread, since tiles are added and
+    // removed by the main thread meanwhile. The main thread then keeps
+    // the tree collected ahead with collect_ahead(), and
+    // prepare_ground_cache only serves from it.
+    void set_scene_access(bool access)
+    { _sceneAccess = access; }
+
+    // Main thread: collect around the wgs84 position pt, reaching ahead
+    // along the movement seen by prepare_ground_cache, unless the tree
+    // collected before still covers the next half of the lookahead time.
+    bool collect_ahead(double startSimTime, const SGVec3d& pt, double rad);
+
     // Returns true if the cache is valid.
     // Also the reference time, point and radius values where the cache
     // is valid for are returned.
@@ -91,6 +151,12 @@ public:
                  simgear::BVHNode::Id& id,
                  const simgear::BVHMaterial*& material);
 
+    // Same as above for count points at once, typically all gear contacts
+    // of one step. The local tree is traversed once for the whole set of
+    // line segments instead of once per point.
+    // Returns the number of points with found set.
+    unsigned get_agl(double t, AglQuery* queries, unsigned count);
+
     bool get_nearest(double t, const SGVec3d& pt, double maxDist,
                      SGVec3d& contact, SGVec3d& linearVel, SGVec3d& angularVel,
                      simgear::BVHNode::Id& id,
@@ -110,8 +176,14 @@ public:
     // the wire end position.
     void release_wire(void);
 
+    const Stats& get_stats() const
+    { return _stats; }
+
 private:
+    friend class FGTestApi::PrivateAccessor::FDM::Accessor;
+
     class CacheFill;
+    class GroundIntersector;
     class BodyFinder;
     class CatapultFinder;
     class WireIntersector;
@@ -139,12 +211,41 @@ private:
 
     SGSharedPtr<simgear::BVHNode> _localBvhTree;
 
-#ifdef GROUNDCACHE_DEBUG
-    SGTimeStamp _lookupTime;
-    unsigned _lookupCount;
-    SGTimeStamp _buildTime;
-    unsigned _buildCount;
+    // What _localBvhTree was collected for, with the cache time offset
+    // applied to the times
+    double _lookahead = 0;
+    SGVec3d _collectedCenter;
+    double _collectedRadius = 0;
+    double _collectedStartTime = 0;
+    double _collectedEndTime = 0;
+
+    // The previous prepare_ground_cache call, to predict the movement
+    bool _havePrepared = false;
+    SGVec3d _lastPreparePoint;
+    double _lastPrepareTime = 0;
+    SGVec3d _velocity = SGVec3d::zeros();
+
+    bool _sceneAccess = true;
+
+    // Coarse altitude and material below pt, from the local tree
+    bool findGroundBelow(const SGVec3d& pt, double t);
+
+    // Whether the collected tree covers the sphere over the time span,
+    // times with the cache time offset applied
+    bool covers(const SGVec3d& pt, double rad, double startSimTime, double endSimTime) const;
 
+    // Walk the scene graph for the tree around pt over the lookahead time
+    bool collect(const SGVec3d& pt, double rad, double startSimTime, double endSimTime,
+                 double lookahead);
+
+    Stats _stats;
+    void addLookupTime(const SGTimeStamp& start, unsigned points);
+
+    // Scratch space for the batched get_agl
+    std::vector<SGLineSegmentd> _batchSegments;
+    std::vector<unsigned> _batchActive;
+
+#ifdef GROUNDCACHE_DEBUG
     osg::ref_ptr<osg::Group> _group;
 #endif
 };
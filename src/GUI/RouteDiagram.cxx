@@ -138,7 +138,7 @@ void RouteDiagram::doComputeBounds()
 void RouteDiagram::fpChanged()
 {
     FlightPlanRef fp = m_flightplan->flightplan();
-    m_path.reset(new RoutePath(fp));
+    m_path.reset(new RoutePath(fp->routePath()));
     m_activeLegIndex = 0;
 
     if (fp && (fp->numLegs() > 0)) {
@@ -7,8 +7,15 @@
 
 #include <config.h>
 
+#include <atomic>
+#include <cerrno>
 #include <cstring>
 #include <cstdio>
+#include <set>
+#include <thread>
+#include <vector>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -18,7 +25,6 @@ extern "C" {
     #include <libudev.h>
 }
 
-#include <poll.h>
 #include <linux/input.h>
 #include <fcntl.h>
 
@@ -284,6 +290,16 @@ static inline bool bitSet( unsigned char * buf, unsigned bit )
   return (buf[bit/sizeof(unsigned char)/8] >> (bit%(sizeof(unsigned char)*8))) & 1;
 }
 
+// absolute axes whose value is a position, where only the latest counts.
+// Hats step between a few positions and every step may be bound; the
+// multitouch codes depend on the ABS_MT_SLOT before them.
+static inline bool isContinuousAxis( unsigned code )
+{
+  return code <= ABS_BRAKE ||
+         (code >= ABS_PRESSURE && code <= ABS_TOOL_WIDTH) ||
+         code == ABS_VOLUME;
+}
+
 bool FGLinuxInputDevice::Open()
 {
   if( fd != -1 ) return true;
@@ -300,6 +316,10 @@ bool FGLinuxInputDevice::Open()
     SG_LOG( SG_INPUT, SG_WARN, "Can't grab " << devfile << " for exclusive access" );
   }
 
+  // stamp events on the monotonic clock, for the latency statistics
+  int monotonic = CLOCK_MONOTONIC;
+  clockId = ioctl( fd, EVIOCSCLOCKID, &monotonic ) == 0 ? CLOCK_MONOTONIC : CLOCK_REALTIME;
+
   {
     unsigned char buf[ABS_CNT/sizeof(unsigned char)/8];
     // get axes maximums
@@ -390,6 +410,42 @@ double FGLinuxInputDevice::Normalize( struct input_event & event )
   }
 }
 
+void FGLinuxInputDevice::RecordDispatched( const struct input_event & event )
+{
+  dispatchedEvents++;
+
+  struct timespec now;
+  clock_gettime( clockId, &now );
+  double latency = (now.tv_sec - event.input_event_sec) +
+                   (now.tv_nsec / 1000 - event.input_event_usec) * 1e-6;
+  if( latency < 0.0 )
+    return;
+
+  latencySum += latency;
+  latencyCount++;
+  if( latency > latencyMax )
+    latencyMax = latency;
+}
+
+void FGLinuxInputDevice::UpdateStats( double dt )
+{
+  statsAge += dt;
+  if( statsAge < 1.0 )
+    return;
+
+  if( !statsNode )
+    statsNode = deviceNode->getNode( "stats", true );
+
+  statsNode->setIntValue( "events-per-sec", (int)((dispatchedEvents + coalescedEvents) / statsAge) );
+  statsNode->setIntValue( "dispatched-per-sec", (int)(dispatchedEvents / statsAge) );
+  statsNode->setIntValue( "coalesced-per-sec", (int)(coalescedEvents / statsAge) );
+  statsNode->setDoubleValue( "latency-ms", latencyCount ? 1000.0 * latencySum / latencyCount : 0.0 );
+  statsNode->setDoubleValue( "latency-max-ms", 1000.0 * latencyMax );
+
+  statsAge = latencySum = latencyMax = 0.0;
+  latencyCount = dispatchedEvents = coalescedEvents = 0;
+}
+
 void FGLinuxInputDevice::Close()
 {
   if( fd != -1 ) {
@@ -455,12 +511,152 @@ void FGLinuxInputDevice::SetDevname( const std::string & name )
   this->devfile = name;
 }
 
+/*
+ * Waits for the devices with epoll on a thread of its own and reads what
+ * they have in batches, handing the raw events to the main thread through
+ * a single producer, single consumer ring. Nothing but the file
+ * descriptors is touched here; normalising and binding the events happens
+ * in FGLinuxEventInput::update().
+ */
+class FGLinuxEventInput::Reader
+{
+public:
+  Reader( const std::map<int,FGInputDevice*> & devices );
+  ~Reader();
+
+  // main thread only
+  bool Pop( QueuedEvent & queued );
+  unsigned Dropped() const { return dropped.load( std::memory_order_relaxed ); }
+
+private:
+  void Run();
+  bool Push( const QueuedEvent & queued );
+
+  // a power of two; a second's worth of events of a busy cockpit
+  static const size_t QUEUE_SIZE = 8192;
+  static const size_t READ_BATCH = 64;
+  static const uint64_t WAKE = ~uint64_t(0);
+
+  std::vector<QueuedEvent> ring;
+  std::atomic<size_t> head {0}; // next to pop, written by the main thread
+  std::atomic<size_t> tail {0}; // next to push, written by the reader
+  std::atomic<unsigned> dropped {0};
+
+  std::map<int,int> fds; // device index by fd
+  int epollFd {-1};
+  int wakeFd {-1};
+  std::atomic<bool> stop {false};
+  std::thread thread;
+};
+
+FGLinuxEventInput::Reader::Reader( const std::map<int,FGInputDevice*> & devices ) :
+  ring( QUEUE_SIZE )
+{
+  epollFd = epoll_create1( EPOLL_CLOEXEC );
+  wakeFd = eventfd( 0, EFD_CLOEXEC );
+  if( epollFd == -1 || wakeFd == -1 ) {
+    SG_LOG( SG_INPUT, SG_ALERT, "Can't set up event input. errno=" << errno << ": " << strerror(errno) );
+    return;
+  }
+
+  struct epoll_event ev;
+  ev.events = EPOLLIN;
+  ev.data.u64 = WAKE;
+  epoll_ctl( epollFd, EPOLL_CTL_ADD, wakeFd, &ev );
+
+  for( auto it : devices ) {
+    int fd = static_cast<FGLinuxInputDevice*>(it.second)->GetFd();
+    ev.data.u64 = fd;
+    if( fd == -1 || epoll_ctl( epollFd, EPOLL_CTL_ADD, fd, &ev ) == -1 )
+      continue;
+    fds[fd] = it.first;
+  }
+
+  thread = std::thread( &Reader::Run, this );
+}
+
+FGLinuxEventInput::Reader::~Reader()
+{
+  if( thread.joinable() ) {
+    stop = true;
+    uint64_t one = 1;
+    if( write( wakeFd, &one, sizeof(one) ) != sizeof(one) )
+      SG_LOG( SG_INPUT, SG_WARN, "Can't wake the event input thread" );
+    thread.join();
+  }
+
+  if( wakeFd != -1 ) ::close( wakeFd );
+  if( epollFd != -1 ) ::close( epollFd );
+}
+
+bool FGLinuxEventInput::Reader::Push( const QueuedEvent & queued )
+{
+  size_t t = tail.load( std::memory_order_relaxed );
+  if( t - head.load( std::memory_order_acquire ) == QUEUE_SIZE )
+    return false;
+
+  ring[t & (QUEUE_SIZE - 1)] = queued;
+  tail.store( t + 1, std::memory_order_release );
+  return true;
+}
+
+bool FGLinuxEventInput::Reader::Pop( QueuedEvent & queued )
+{
+  size_t h = head.load( std::memory_order_relaxed );
+  if( h == tail.load( std::memory_order_acquire ) )
+    return false;
+
+  queued = ring[h & (QUEUE_SIZE - 1)];
+  head.store( h + 1, std::memory_order_release );
+  return true;
+}
+
+void FGLinuxEventInput::Reader::Run()
+{
+  struct epoll_event ready[16];
+  struct input_event events[READ_BATCH];
+
+  while( !stop ) {
+    int n = epoll_wait( epollFd, ready, sizeof(ready)/sizeof(ready[0]), -1 );
+    if( n == -1 ) {
+      if( errno == EINTR )
+        continue;
+      SG_LOG( SG_INPUT, SG_ALERT, "Event input stopped. errno=" << errno << ": " << strerror(errno) );
+      return;
+    }
+
+    for( int i = 0; i < n; i++ ) {
+      if( ready[i].data.u64 == WAKE )
+        continue;
+
+      int fd = static_cast<int>(ready[i].data.u64);
+      int device = fds[fd];
+      ssize_t bytes = read( fd, events, sizeof(events) );
+      if( bytes <= 0 ) {
+        if( bytes == 0 || (errno != EINTR && errno != EAGAIN) ) {
+          // unplugged, most likely: stop listening to it
+          SG_LOG( SG_INPUT, SG_WARN, "Can't read event device " << device << ". errno=" << errno << ": " << strerror(errno) );
+          epoll_ctl( epollFd, EPOLL_CTL_DEL, fd, NULL );
+          fds.erase( fd );
+        }
+        continue;
+      }
+
+      for( size_t e = 0; e < bytes / sizeof(events[0]); e++ ) {
+        if( !Push( { device, events[e] } ) )
+          dropped.fetch_add( 1, std::memory_order_relaxed );
+      }
+    }
+  }
+}
+
 FGLinuxEventInput::FGLinuxEventInput() : FGEventInput("Input/Event", "/input/event")
 {
 }
 
 FGLinuxEventInput::~FGLinuxEventInput()
 {
+  reader.reset();
 }
 
 void FGLinuxEventInput::postinit()
@@ -506,47 +702,68 @@ void FGLinuxEventInput::postinit()
   udev_enumerate_unref(enumerate); // REVIEW: this should fix the memory leak
   udev_unref(udev);
 
+  reader.reset( new Reader( inputDevices ) );
+}
+
+void FGLinuxEventInput::shutdown()
+{
+  // the reader uses the devices' file descriptors
+  reader.reset();
+  FGEventInput::shutdown();
 }
 
 void FGLinuxEventInput::update( double dt )
 {
   FGEventInput::update( dt );
-  // index the input devices by the associated fd and prepare
-  // the pollfd array by filling in the file descriptor
-  struct pollfd fds[inputDevices.size()];
-  std::map<int,FGLinuxInputDevice*> devicesByFd;
-  std::map<int,FGInputDevice*>::const_iterator it;
-  int i;
-  for( i=0, it = inputDevices.begin(); it != inputDevices.end(); ++it, i++ ) {
-    FGInputDevice* p = (*it).second;
-    int fd = ((FGLinuxInputDevice*)p)->GetFd();
-    fds[i].fd = fd;
-    fds[i].events = POLLIN;
-    devicesByFd[fd] = (FGLinuxInputDevice*)p;
+  if( !reader )
+    return;
+
+  // take what the reader has queued since the last frame
+  pending.clear();
+  QueuedEvent queued;
+  while( reader->Pop( queued ) )
+    pending.push_back( queued );
+
+  // of the continuous axis events of a device only the last one per axis
+  // counts; walk backwards to find the ones that are superseded
+  skip.assign( pending.size(), false );
+  std::set<std::pair<int,unsigned>> seen;
+  for( size_t i = pending.size(); i-- > 0; ) {
+    const auto & e = pending[i];
+    if( e.event.type == EV_ABS && isContinuousAxis( e.event.code ) &&
+        !seen.insert( std::make_pair( e.device, (unsigned)e.event.code ) ).second )
+      skip[i] = true;
   }
 
   int modifiers = fgGetKeyModifiers();
-  // poll all devices until no more events are in the queue
-  // do no more than maxpolls in a single loop to prevent locking
-  int maxpolls = 100;
-  while( maxpolls-- > 0 && ::poll( fds, i, 0 ) > 0 ) {
-    for( unsigned i = 0; i < sizeof(fds)/sizeof(fds[0]); i++ ) {
-      if( fds[i].revents & POLLIN ) {
+  for( size_t i = 0; i < pending.size(); i++ ) {
+    auto it = inputDevices.find( pending[i].device );
+    if( it == inputDevices.end() )
+      continue;
+
+    FGLinuxInputDevice * device = static_cast<FGLinuxInputDevice*>(it->second);
+    struct input_event & event = pending[i].event;
+    if( skip[i] ) {
+      device->RecordCoalesced();
+      continue;
+    }
 
-        // if this device reports data ready, it should be a input_event struct
-        struct input_event event;
+    device->RecordDispatched( event );
+    FGLinuxEventData eventData( event, dt, modifiers );
 
-        if( read( fds[i].fd, &event, sizeof(event) ) != sizeof(event) )
-          continue;
+    if( event.type == EV_ABS )
+      eventData.value = device->Normalize( event );
 
-        FGLinuxEventData eventData( event, dt, modifiers );
+    // let the FGInputDevice handle the data
+    device->HandleEvent( eventData );
+  }
 
-        if( event.type == EV_ABS )
-          eventData.value = devicesByFd[fds[i].fd]->Normalize( event );
+  for( auto it : inputDevices )
+    static_cast<FGLinuxInputDevice*>(it.second)->UpdateStats( dt );
 
-        // let the FGInputDevice handle the data
-        devicesByFd[fds[i].fd]->HandleEvent( eventData );
-      }
-    }
+  unsigned dropped = reader->Dropped();
+  if( dropped != reportedDropped ) {
+    SG_LOG( SG_INPUT, SG_WARN, "Event input queue full, dropped " << dropped - reportedDropped << " events" );
+    reportedDropped = dropped;
   }
 }
@@ -7,6 +7,9 @@
 
 #pragma once
 
+#include <ctime>
+#include <memory>
+
 #include "FGEventInput.hxx"
 #include <linux/input.h>
 
@@ -42,11 +45,30 @@ public:
     int GetFd() { return fd; }
 
     double Normalize( struct input_event & event );
+
+    // count event as handled, and the time from the kernel stamping it to
+    // now, on the main thread
+    void RecordDispatched( const struct input_event & event );
+    // count an axis event superseded by a later one in the same frame
+    void RecordCoalesced() { coalescedEvents++; }
+    // publish the event rates (received, dispatched and coalesced) and
+    // latency statistics below the device node once a second
+    void UpdateStats( double dt );
+
 private:
     std::string devfile;
     std::string devpath;
     int fd {-1};
+    int clockId {CLOCK_REALTIME};
     std::map<unsigned int,input_absinfo> absinfo;
+
+    double statsAge {0.0};
+    double latencySum {0.0};
+    double latencyMax {0.0};
+    unsigned latencyCount {0};
+    unsigned dispatchedEvents {0};
+    unsigned coalescedEvents {0};
+    SGPropertyNode_ptr statsNode;
 };
 
 class FGLinuxEventInput : public FGEventInput
@@ -57,10 +79,24 @@ public:
 
     // Subsystem API.
     void postinit() override;
+    void shutdown() override;
     void update(double dt) override;
 
     // Subsystem identification.
     static const char* staticSubsystemClassId() { return "input-event"; }
 
-protected:
+private:
+    struct QueuedEvent {
+        int device; // index into inputDevices
+        struct input_event event;
+    };
+
+    // reads the devices on a thread of its own, see FGLinuxEventInput.cxx
+    class Reader;
+    std::unique_ptr<Reader> reader;
+
+    // reused from frame to frame
+    std::vector<QueuedEvent> pending;
+    std::vector<bool> skip;
+    unsigned reportedDropped {0};
 };
@@ -9,6 +9,7 @@
 #include "commradio.hxx"
 
 #include <assert.h>
+#include <set>
 
 #include <simgear/sg_inlines.h>
 #include <simgear/props/propertyObject.hxx>
@@ -54,9 +55,16 @@ public:
     _stationId = stationId;
   }
 
+  void setPriority(int priority)
+  {
+    _synthesizeRequest.priority = priority;
+  }
 
 private:
   SynthesizeRequest _synthesizeRequest;
+  FLITEVoiceSynthesizer * _synthesizer = nullptr;
+  // every synthesizer we used, which may still be rendering for us
+  std::set<FLITEVoiceSynthesizer*> _usedSynthesizers;
   SGLockedQueue<SGSharedPtr<SGSoundSample> > _spokenAtis;
   string _stationId;
 };
@@ -71,7 +79,13 @@ AtisSpeaker::AtisSpeaker()
 
 AtisSpeaker::~AtisSpeaker()
 {
-
+  // the synthesizers are owned by the sound manager, don't touch them
+  // if it is already gone
+  if (globals->get_subsystem<FGSoundManager>()) {
+    // wait for each, its worker calls SoundSampleReady() on us
+    for (auto synthesizer : _usedSynthesizers)
+      synthesizer->cancel(this);
+  }
 }
 void AtisSpeaker::valueChanged(SGPropertyNode * node)
 {
@@ -124,6 +138,14 @@ void AtisSpeaker::valueChanged(SGPropertyNode * node)
   SG_LOG(SG_INSTR, SG_DEBUG,"node->getPath()=" << node->getPath() << " AtisSpeaker voice is " << voice );
   FLITEVoiceSynthesizer * synthesizer = dynamic_cast<FLITEVoiceSynthesizer*>(smgr->getSynthesizer(voice));
 
+  // the station changed voice, forget what is still queued for the old one;
+  // a phrase it is rendering still arrives, and the destructor waits for it
+  if (_synthesizer && _synthesizer != synthesizer) {
+    _synthesizer->cancel(this, false);
+  }
+  _synthesizer = synthesizer;
+  _usedSynthesizers.insert(synthesizer);
+
   synthesizer->synthesize(_synthesizeRequest);
 }
 
@@ -651,6 +673,8 @@ void CommRadioImpl::update(double dt)
   _airportId = _commStationForFrequency->airport()->getId();
 
   _atisSpeaker.setStationId(_airportId);
+  _atisSpeaker.setPriority(_signalQuality_norm >= _cutoffSignalQuality ?
+      SynthesizeRequest::PRIORITY_TUNED : SynthesizeRequest::PRIORITY_BACKGROUND);
 
   switch (_commStationForFrequency->type()) {
     case FGPositioned::FREQ_ATIS:
@@ -8,9 +8,15 @@
 
 #include "logger.hxx"
 
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
 #include <ios>
+#include <mutex>
 #include <string>
-#include <cstdlib>
+#include <thread>
 
 #include <simgear/debug/logstream.hxx>
 #include <simgear/io/iostreams/sgstream.hxx>
@@ -18,10 +24,236 @@
 
 #include "fg_props.hxx"
 #include "globals.hxx"
+#include "loggerformat.hxx"
 
 using std::string;
 using std::endl;
 
+using flightgear::logformat::ColumnType;
+
+
+////////////////////////////////////////////////////////////////////////
+// Implementation of FGLogger::BinaryWriter
+////////////////////////////////////////////////////////////////////////
+
+/**
+ * Samples typed property values into blocks of rows stored column by
+ * column. Full blocks are handed to a worker thread which writes them out,
+ * and are then recycled, so that logging doesn't format, allocate or write
+ * on the main thread once the pool of blocks has grown to what the writer
+ * needs.
+ */
+class FGLogger::BinaryWriter
+{
+public:
+    BinaryWriter(std::ostream& out, const std::vector<SGPropertyNode_ptr>& nodes,
+                 const std::vector<string>& titles, unsigned int rowsPerBlock);
+
+    // writes the rows sampled so far and stops the worker
+    ~BinaryWriter();
+
+    void sample(double sim_time_sec);
+
+private:
+    struct Block {
+        uint32_t rows = 0;
+        std::vector<double> time;
+        std::vector<string> columns; // raw values
+    };
+
+    Block* acquire();
+    void run();
+    void write(const Block& block);
+
+    std::ostream& _out;
+    const std::vector<SGPropertyNode_ptr>& _nodes;
+    std::vector<ColumnType> _types;
+    const unsigned int _rowsPerBlock;
+
+    // all blocks, owned here; the worker only sees the pointers in _full
+    std::vector<std::unique_ptr<Block>> _blocks;
+    Block* _current = nullptr;
+
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    std::deque<Block*> _full;
+    std::deque<Block*> _free;
+    bool _done = false;
+    std::thread _thread;
+};
+
+namespace {
+
+ColumnType columnType(const SGPropertyNode* node)
+{
+    switch (node->getType()) {
+    case simgear::props::BOOL:   return ColumnType::Bool;
+    case simgear::props::INT:    return ColumnType::Int;
+    case simgear::props::LONG:   return ColumnType::Long;
+    case simgear::props::FLOAT:  return ColumnType::Float;
+    case simgear::props::STRING:
+    case simgear::props::UNSPECIFIED:
+    case simgear::props::EXTENDED:
+        return ColumnType::String;
+    default:
+        // doubles, and properties which have no value yet
+        return ColumnType::Double;
+    }
+}
+
+template <typename T>
+void put(std::ostream& out, const T& v)
+{
+    out.write(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+template <typename T>
+void append(string& column, const T& v)
+{
+    column.append(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+} // namespace
+
+FGLogger::BinaryWriter::BinaryWriter(std::ostream& out,
+                                     const std::vector<SGPropertyNode_ptr>& nodes,
+                                     const std::vector<string>& titles,
+                                     unsigned int rowsPerBlock)
+    : _out(out),
+      _nodes(nodes),
+      _rowsPerBlock(std::max(rowsPerBlock, 1u))
+{
+    // The column types are fixed here, from the properties' types when
+    // logging starts.
+    _out.write(flightgear::logformat::magic, sizeof(flightgear::logformat::magic));
+    put<uint32_t>(_out, _nodes.size());
+    for (size_t i = 0; i < _nodes.size(); ++i) {
+        _types.push_back(columnType(_nodes[i]));
+        put(_out, _types.back());
+        const uint16_t length = std::min<size_t>(titles[i].size(), UINT16_MAX);
+        put(_out, length);
+        _out.write(titles[i].data(), length);
+    }
+
+    _current = acquire();
+    _thread = std::thread(&BinaryWriter::run, this);
+}
+
+FGLogger::BinaryWriter::~BinaryWriter()
+{
+    {
+        std::lock_guard<std::mutex> g(_mutex);
+        if (_current->rows > 0) {
+            _full.push_back(_current);
+        }
+        _done = true;
+    }
+    _cond.notify_one();
+    _thread.join();
+}
+
+FGLogger::BinaryWriter::Block* FGLogger::BinaryWriter::acquire()
+{
+    {
+        std::lock_guard<std::mutex> g(_mutex);
+        if (!_free.empty()) {
+            Block* b = _free.front();
+            _free.pop_front();
+            return b;
+        }
+    }
+
+    // the writer is behind (or this is the first block): grow the pool
+    std::unique_ptr<Block> b(new Block);
+    b->time.reserve(_rowsPerBlock);
+    b->columns.resize(_nodes.size());
+    _blocks.push_back(std::move(b));
+    return _blocks.back().get();
+}
+
+void FGLogger::BinaryWriter::sample(double sim_time_sec)
+{
+    Block& b = *_current;
+    b.time.push_back(sim_time_sec);
+    for (size_t i = 0; i < _nodes.size(); ++i) {
+        const SGPropertyNode* node = _nodes[i];
+        string& column = b.columns[i];
+        switch (_types[i]) {
+        case ColumnType::Bool:
+            append<uint8_t>(column, node->getBoolValue());
+            break;
+        case ColumnType::Int:
+            append<int32_t>(column, node->getIntValue());
+            break;
+        case ColumnType::Long:
+            append<int64_t>(column, node->getLongValue());
+            break;
+        case ColumnType::Float:
+            append<float>(column, node->getFloatValue());
+            break;
+        case ColumnType::Double:
+            append<double>(column, node->getDoubleValue());
+            break;
+        case ColumnType::String: {
+            const string s = node->getStringValue();
+            const uint16_t length = std::min<size_t>(s.size(), UINT16_MAX);
+            append(column, length);
+            column.append(s.data(), length);
+            break;
+        }
+        }
+    }
+
+    if (++b.rows < _rowsPerBlock) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> g(_mutex);
+        _full.push_back(_current);
+    }
+    _cond.notify_one();
+    _current = acquire();
+}
+
+void FGLogger::BinaryWriter::run()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (;;) {
+        _cond.wait(lock, [this] { return _done || !_full.empty(); });
+        if (_full.empty()) {
+            break; // done, and everything is written
+        }
+
+        Block* b = _full.front();
+        _full.pop_front();
+        lock.unlock();
+
+        write(*b);
+        b->rows = 0;
+        b->time.clear();
+        for (auto& column : b->columns) {
+            column.clear(); // keeps the capacity for the next use
+        }
+
+        lock.lock();
+        _free.push_back(b);
+    }
+
+    _out.flush();
+}
+
+void FGLogger::BinaryWriter::write(const Block& block)
+{
+    put<uint32_t>(_out, block.rows);
+    _out.write(reinterpret_cast<const char*>(block.time.data()),
+               block.rows * sizeof(double));
+    for (const auto& column : block.columns) {
+        put<uint32_t>(_out, column.size());
+        _out.write(column.data(), column.size());
+    }
+}
+
 
 ////////////////////////////////////////////////////////////////////////
 // Implementation of FGLogger
@@ -69,6 +301,17 @@ FGLogger::init ()
     _logs.emplace_back(new Log());
     Log &log = *_logs.back();
 
+    string format = child->getStringValue("format");
+    if (format.empty()) {
+        format = "csv";
+        child->setStringValue("format", format.c_str());
+    } else if ((format != "csv") && (format != "binary")) {
+        SG_LOG(SG_GENERAL, SG_ALERT, "Unknown log format '" << format
+               << "' for " << filename << ", using csv");
+        format = "csv";
+    }
+    const bool binary = (format == "binary");
+
     string delimiter = child->getStringValue("delimiter");
     if (delimiter.empty()) {
         delimiter = ",";
@@ -79,7 +322,8 @@ FGLogger::init ()
     log.last_time_ms = globals->get_sim_time_sec() * 1000;
     log.delimiter = delimiter.c_str()[0];
     // Security: use the return value of SGPath::validate()
-    log.output.reset(new sg_ofstream(authorizedPath, std::ios_base::out));
+    log.output.reset(new sg_ofstream(authorizedPath,
+        binary ? (std::ios_base::out | std::ios_base::binary) : std::ios_base::out));
     if ( !(*log.output) ) {
       SG_LOG(SG_GENERAL, SG_ALERT, "Cannot write log to " << filename);
       _logs.pop_back();
@@ -90,7 +334,7 @@ FGLogger::init ()
     // Process the individual entries (Time is automatic).
     //
     std::vector<SGPropertyNode_ptr> entries = child->getChildren("entry");
-    (*log.output) << "Time";
+    std::vector<string> titles;
     for (unsigned int j = 0; j < entries.size(); j++) {
       SGPropertyNode * entry = entries[j];
 
@@ -108,8 +352,18 @@ FGLogger::init ()
       SGPropertyNode * node =
 	fgGetNode(entry->getStringValue("property"), true);
       log.nodes.push_back(node);
-      (*log.output) << log.delimiter
-		    << entry->getStringValue("title", node->getPath().c_str());
+      titles.push_back(entry->getStringValue("title", node->getPath().c_str()));
+    }
+
+    if (binary) {
+      log.binary.reset(new BinaryWriter(*log.output, log.nodes, titles,
+                                        child->getIntValue("block-rows", 1000)));
+      continue;
+    }
+
+    (*log.output) << "Time";
+    for (const auto& title : titles) {
+      (*log.output) << log.delimiter << title;
     }
     (*log.output) << endl;
   }
@@ -138,14 +392,22 @@ FGLogger::update (double dt)
     double sim_time_sec = globals->get_sim_time_sec();
     double sim_time_ms = sim_time_sec * 1000;
     for (unsigned int i = 0; i < _logs.size(); i++) {
-        while ((sim_time_ms - _logs[i]->last_time_ms) >= _logs[i]->interval_ms) {
-            _logs[i]->last_time_ms += _logs[i]->interval_ms;
-            (*_logs[i]->output) << sim_time_sec;
-            for (unsigned int j = 0; j < _logs[i]->nodes.size(); j++) {
-                (*_logs[i]->output) << _logs[i]->delimiter
-                                    << _logs[i]->nodes[j]->getStringValue();
+        Log& log = *_logs[i];
+        while ((sim_time_ms - log.last_time_ms) >= log.interval_ms) {
+            log.last_time_ms += log.interval_ms;
+            if (log.binary) {
+                log.binary->sample(sim_time_sec);
+                continue;
+            }
+
+            // no endl: the stream is flushed when its buffer is full, or
+            // when the log is closed
+            sg_ofstream& output = *log.output;
+            output << sim_time_sec;
+            for (unsigned int j = 0; j < log.nodes.size(); j++) {
+                output << log.delimiter << log.nodes[j]->getStringValue();
             }
-            (*_logs[i]->output) << endl;
+            output << '\n';
         }
     }
 }
@@ -162,6 +424,8 @@ FGLogger::Log::Log ()
 {
 }
 
+FGLogger::Log::~Log () = default;
+
 
 // Register the subsystem.
 SGSubsystemMgr::Registrant<FGLogger> registrantFGLogger;
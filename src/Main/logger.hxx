@@ -15,7 +15,8 @@
 #include <simgear/props/props.hxx>
 
 /**
- * Log any property values to any number of CSV files.
+ * Log any property values to any number of CSV files, or to binary files
+ * written by a worker thread (see loggerformat.hxx).
  */
 class FGLogger : public SGSubsystem
 {
@@ -31,17 +32,23 @@ public:
     static const char* staticSubsystemClassId() { return "logger"; }
 
 private:
+    class BinaryWriter;
+
     /**
      * A single instance of a log file (the logger can contain many).
      */
     struct Log {
       Log ();
+      ~Log ();
 
       std::vector<SGPropertyNode_ptr> nodes;
       std::unique_ptr<sg_ofstream> output;
       long interval_ms;
       double last_time_ms;
       char delimiter;
+      // binary logs only; declared last, as it writes to output until it
+      // is destroyed
+      std::unique_ptr<BinaryWriter> binary;
     };
 
     std::vector< std::unique_ptr<Log> > _logs;
@@ -0,0 +1,173 @@
+// loggerformat.cxx - conversion of the binary FGLogger output to CSV.
+//
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// no config.h: this file is also built into utils/fglogconvert
+
+#include "loggerformat.hxx"
+
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace flightgear {
+namespace logformat {
+
+namespace {
+
+struct Column {
+    ColumnType type;
+    std::string title;
+    std::vector<char> data;
+    size_t pos = 0;
+};
+
+template <typename T>
+bool read(std::istream& in, T& v)
+{
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&v), sizeof(T)));
+}
+
+// the shortest text which reads back as the same value
+template <typename T>
+void writeNumber(std::ostream& out, T v)
+{
+    char buf[32];
+    const auto r = std::to_chars(buf, buf + sizeof(buf), v);
+    out.write(buf, r.ptr - buf);
+}
+
+template <typename T>
+bool take(Column& c, T& v)
+{
+    if (c.pos + sizeof(T) > c.data.size()) {
+        return false;
+    }
+    memcpy(&v, c.data.data() + c.pos, sizeof(T));
+    c.pos += sizeof(T);
+    return true;
+}
+
+// write the next value of the column, false if the column has run out
+bool writeValue(std::ostream& out, Column& c)
+{
+    switch (c.type) {
+    case ColumnType::Bool: {
+        uint8_t v;
+        if (!take(c, v)) return false;
+        out << (v ? "true" : "false");
+        return true;
+    }
+    case ColumnType::Int: {
+        int32_t v;
+        if (!take(c, v)) return false;
+        out << v;
+        return true;
+    }
+    case ColumnType::Long: {
+        int64_t v;
+        if (!take(c, v)) return false;
+        out << v;
+        return true;
+    }
+    case ColumnType::Float: {
+        float v;
+        if (!take(c, v)) return false;
+        writeNumber(out, v);
+        return true;
+    }
+    case ColumnType::Double: {
+        double v;
+        if (!take(c, v)) return false;
+        writeNumber(out, v);
+        return true;
+    }
+    case ColumnType::String: {
+        uint16_t length;
+        if (!take(c, length) || (c.pos + length > c.data.size())) return false;
+        out.write(c.data.data() + c.pos, length);
+        c.pos += length;
+        return true;
+    }
+    }
+
+    return false;
+}
+
+} // namespace
+
+int convertToCsv(std::istream& in, std::ostream& out, char delimiter)
+{
+    char id[sizeof(magic)];
+    uint32_t numColumns = 0;
+    if (!in.read(id, sizeof(id)) ||
+        memcmp(id, magic, sizeof(id)) ||
+        !read(in, numColumns)) {
+        std::cerr << "not a FlightGear binary log" << std::endl;
+        return 1;
+    }
+
+    std::vector<Column> columns(numColumns);
+    out << "Time";
+    for (auto& c : columns) {
+        uint8_t type;
+        uint16_t length;
+        if (!read(in, type) || !read(in, length)) {
+            std::cerr << "truncated header" << std::endl;
+            return 1;
+        }
+        if ((type < static_cast<uint8_t>(ColumnType::Bool)) ||
+            (type > static_cast<uint8_t>(ColumnType::String))) {
+            std::cerr << "unknown column type " << int(type) << std::endl;
+            return 1;
+        }
+        c.type = static_cast<ColumnType>(type);
+        c.title.resize(length);
+        in.read(&c.title[0], length);
+        out << delimiter << c.title;
+    }
+    out << '\n';
+
+    std::vector<double> time;
+    uint32_t rows;
+    while (read(in, rows)) {
+        time.resize(rows);
+        bool ok = static_cast<bool>(in.read(reinterpret_cast<char*>(time.data()),
+                                            rows * sizeof(double)));
+        for (auto& c : columns) {
+            uint32_t bytes = 0;
+            ok = ok && read(in, bytes);
+            if (ok) {
+                c.data.resize(bytes);
+                c.pos = 0;
+                ok = static_cast<bool>(in.read(c.data.data(), bytes));
+            }
+        }
+
+        if (!ok) {
+            // a log which was not closed cleanly: keep what was complete
+            std::cerr << "truncated block, stopping" << std::endl;
+            return 1;
+        }
+
+        for (uint32_t r = 0; r < rows; ++r) {
+            writeNumber(out, time[r]);
+            for (auto& c : columns) {
+                out << delimiter;
+                if (!writeValue(out, c)) {
+                    std::cerr << "corrupt column " << c.title << std::endl;
+                    return 1;
+                }
+            }
+            out << '\n';
+        }
+    }
+
+    return 0;
+}
+
+} // namespace logformat
+} // namespace flightgear
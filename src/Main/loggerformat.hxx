@@ -0,0 +1,51 @@
+// loggerformat.hxx - layout of the binary FGLogger output.
+//
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+
+/*
+ * A binary log is a header followed by any number of blocks, all values in
+ * the byte order of the machine that wrote it:
+ *
+ *   header:  char[8] magic "FGLOGB01"
+ *            uint32  number of columns, not counting the time
+ *            per column: uint8 type, uint16 title length, title bytes
+ *
+ *   block:   uint32  number of rows
+ *            double  sim time in seconds, one per row
+ *            per column: uint32 byte length, then one value per row
+ *
+ * Values are stored in the column's type; a string is a uint16 length
+ * followed by its bytes. This header and loggerformat.cxx are shared with
+ * utils/fglogconvert and must not depend on anything but the standard
+ * library.
+ */
+namespace flightgear {
+namespace logformat {
+
+const char magic[8] = {'F', 'G', 'L', 'O', 'G', 'B', '0', '1'};
+
+enum class ColumnType : uint8_t {
+    Bool = 1, // uint8
+    Int,      // int32
+    Long,     // int64
+    Float,    // float
+    Double,   // double
+    String    // uint16 length + bytes
+};
+
+/**
+ * Write the binary log read from in to out as CSV, with a Time column
+ * first. Returns 0 on success, or 1 with a message on std::cerr if the log
+ * is not valid; the rows of the blocks before the first truncated or
+ * corrupt one have been written by then.
+ */
+int convertToCsv(std::istream& in, std::ostream& out, char delimiter);
+
+} // namespace logformat
+} // namespace flightgear
@@ -37,6 +37,7 @@
 #include <simgear/timing/sg_time.hxx>
 
 #include <Add-ons/AddonManager.hxx>
+#include <FDM/fdm_shell.hxx>
 #include <GUI/MessageBox.hxx>
 #include <GUI/gui.h>
 #include <Main/locale.hxx>
@@ -144,12 +145,21 @@ static void fgMainLoop( void )
     double sim_dt, real_dt;
     mgr->get_subsystem<TimeManager>()->computeTimeDeltas(sim_dt, real_dt);
 
-    // update all subsystems
-    mgr->update(sim_dt);
+    // update all subsystems. If the FDM runs on its own thread, it is held
+    // off meanwhile and iterates while we render.
+    {
+        auto fdm = mgr->get_subsystem<FDMShell>();
+        std::unique_lock<std::recursive_timed_mutex> fdmLock;
+        if (fdm) {
+            fdmLock = fdm->lockThread();
+        }
 
-    // flush commands waiting in the queue
-    SGCommandMgr::instance()->executedQueuedCommands();
-    simgear::AtomicChangeListener::fireChangeListeners();
+        mgr->update(sim_dt);
+
+        // flush commands waiting in the queue
+        SGCommandMgr::instance()->executedQueuedCommands();
+        simgear::AtomicChangeListener::fireChangeListeners();
+    }
 
 #ifdef NASAL_BACKGROUND_GC_THREAD
     simgear::Emesary::GlobalTransmitter::instance()->NotifyAll(mln_end);
@@ -1700,6 +1700,10 @@ bool FlightPlan::Leg::setHoldCount(int count)
     auto fp = owner();
     fp->lockDelegates();
     fp->_waypointsChanged = true;
+    const int legIndex = static_cast<int>(index());
+    if ((fp->_routePathDirtyIndex < 0) || (legIndex < fp->_routePathDirtyIndex)) {
+        fp->_routePathDirtyIndex = legIndex;
+    }
     fp->unlockDelegates();
   }
 
@@ -1742,7 +1746,8 @@ void FlightPlan::rebuildLegData()
 {
   _totalDistance = 0.0;
   double totalDistanceIncludingMissed = 0.0;
-  RoutePath path(this);
+  updateRoutePath();
+  const RoutePath& path(*_routePath);
 
   for (unsigned int l=0; l<_legs.size(); ++l) {
     _legs[l]->_courseDeg = path.trackForIndex(l);
@@ -1759,15 +1764,35 @@ void FlightPlan::rebuildLegData()
   } // of legs iteration
 }
 
+void FlightPlan::updateRoutePath() const
+{
+    if (_routePath) {
+        _routePath->update(this, _routePathDirtyIndex);
+    } else {
+        _routePath.reset(new RoutePath(this));
+    }
+
+    _routePathDirtyIndex = -1;
+}
+
+const RoutePath& FlightPlan::routePath() const
+{
+    // legs may have changed inside a delegate lock, before rebuildLegData
+    if (!_routePath || _waypointsChanged || (_routePathDirtyIndex >= 0)) {
+        updateRoutePath();
+    }
+
+    return *_routePath;
+}
+
 SGGeod FlightPlan::pointAlongRoute(int aIndex, double aOffsetNm) const
 {
-    RoutePath rp(this);
-    return rp.positionForDistanceFrom(aIndex, aOffsetNm * SG_NM_TO_METER);
+    return routePath().positionForDistanceFrom(aIndex, aOffsetNm * SG_NM_TO_METER);
 }
 
 SGGeod FlightPlan::pointAlongRouteNorm(int aIndex, double aOffsetNorm) const
 {
-    RoutePath rp(this);
+    const RoutePath& rp(routePath());
     if (fabs(aOffsetNorm) > 1.0) {
         SG_LOG(SG_AUTOPILOT, SG_ALERT, "FlightPlan::pointAlongRouteNorm: called with invalid arg:" << aOffsetNorm);
         return rp.positionForIndex(aIndex);
@@ -1912,6 +1937,7 @@ FlightPlan::Delegate::~Delegate()
 void FlightPlan::setFollowLegTrackToFixes(bool tf)
 {
     _followLegTrackToFix = tf;
+    _routePathDirtyIndex = 0;
 }
 
 bool FlightPlan::followLegTrackToFixes() const
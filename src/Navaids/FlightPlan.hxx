@@ -9,10 +9,13 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 
 #include <Navaids/route.hxx>
 #include <Airports/airport.hxx>
 
+class RoutePath;
+
 namespace flightgear
 {
 
@@ -344,6 +347,14 @@ public:
      */
   SGGeod pointAlongRouteNorm(int aIndex, double aOffsetNorm) const;
 
+  /**
+   * computed path geometry for the current legs. This is cached and only
+   * recomputed from the first changed leg onwards, so callers should use it
+   * instead of constructing their own RoutePath. The reference is valid
+   * until the next change to the legs.
+   */
+  const RoutePath& routePath() const;
+
   /**
     @brief given an index to insert a waypoint into the plan, find the geographical vicinity.
         This is used to aid disambiguration searches, etc: see the vicinity parameter to 'waypointFromString'
@@ -494,6 +505,11 @@ private:
 
     double _totalDistance;
     void rebuildLegData();
+    void updateRoutePath() const;
+
+    mutable std::unique_ptr<RoutePath> _routePath;
+    /// first leg modified in place since the route path was updated, or -1
+    mutable int _routePathDirtyIndex = -1;
 
     using LegVec = std::vector<LegRef>;
     LegVec _legs;
@@ -10,6 +10,7 @@
 #include "NavDataCache.hxx"
 
 // std
+#include <atomic>
 #include <cstddef>  // for std::size_t
 #include <map>
 #include <cstring>  // for memcoy
@@ -47,6 +48,7 @@
 
 #include "CacheSchema.h"
 #include "PositionedOctree.hxx"
+#include "PositionedSnapshot.hxx"
 #include "fix.hxx"
 #include "markerbeacon.hxx"
 #include "navrecord.hxx"
@@ -580,6 +582,9 @@ public:
     getAirportItems = prepare("SELECT guid FROM all_positioned WHERE airport=?1 " AND_TYPED);
 
 
+    metarStations = prepare("SELECT positioned.rowid, cart_x, cart_y, cart_z FROM positioned "
+                            "JOIN airport ON airport.rowid=positioned.rowid "
+                            "WHERE has_metar > 0 AND type >= ?1 AND type <= ?2");
     setAirportMetar = prepare("UPDATE airport SET has_metar=?2 WHERE rowid="
                               "(SELECT rowid FROM positioned WHERE ident=?1 AND type>=?3 AND type <=?4)");
     sqlite3_bind_int(setAirportMetar, 3, FGPositioned::AIRPORT);
@@ -697,6 +702,9 @@ public:
     airwayEdgesFrom = prepare("SELECT airway, b FROM airway_edge WHERE network=?1 AND a=?2");
     airwayEdgesTo = prepare("SELECT airway, a FROM airway_edge WHERE network=?1 AND b=?2");
     airwayEdges = prepare("SELECT a, b FROM airway_edge WHERE airway=?1");
+    airwayNetworkEdges = prepare("SELECT airway, a, b FROM airway_edge WHERE network=?1");
+    airwayNetworkNodes = prepare("SELECT guid, cart_x, cart_y, cart_z FROM all_positioned WHERE guid IN "
+                                 "(SELECT a FROM airway_edge WHERE network=?1 UNION SELECT b FROM airway_edge WHERE network=?1)");
   }
 
   void writeIntProperty(const string& key, int value)
@@ -850,6 +858,11 @@ public:
     sqlite3_bind_double(insertPositionedQuery, 11, cartPos.z());
 
     PositionedID r = execInsert(insertPositionedQuery);
+
+    // a snapshot opened later finds the row through its maxId() query
+    if (spatialIndex && spatialSnapshot && !outer->rebuildInProgress) {
+        spatialSnapshot->add({r, ty, cartPos});
+    }
     return r;
   }
 
@@ -962,12 +975,109 @@ public:
 
   void removePositioned(PositionedID rowid)
   {
+      if (rowid > 0) {
+          auto snapshot = currentSpatialSnapshot();
+          if (snapshot && (rowid > snapshot->maxId())) {
+              snapshot->remove(rowid);
+          } else {
+              invalidateSpatialSnapshot();
+          }
+      }
+
       auto stmt = rowid < 0 ? removeTempPosQuery : removePositionedQuery;
       sqlite3_bind_int64(stmt, 1, rowid);
       execUpdate(stmt);
       reset(stmt);
   }
 
+  SGPath spatialSnapshotPath() const
+  {
+      return SGPath(path.utf8Str() + ".spatial");
+  }
+
+  // map the snapshot on first use, and add the rows inserted since it was
+  // written. Returns nullptr when there is none, or it was invalidated.
+  PositionedSnapshot* currentSpatialSnapshot()
+  {
+      if (outer->rebuildInProgress || spatialSnapshotStale) {
+          return nullptr;
+      }
+
+      if (!spatialSnapshotChecked) {
+          spatialSnapshotChecked = true;
+          const SGPath p = spatialSnapshotPath();
+          if (p.exists()) {
+              spatialSnapshot = PositionedSnapshot::open(p, outer->readStringProperty("spatial-snapshot-stamp"));
+          }
+
+          if (spatialSnapshot) {
+              sqlite3_stmt_ptr query = prepare("SELECT rowid, type, cart_x, cart_y, cart_z FROM positioned "
+                                               "WHERE octree_node IS NOT NULL AND rowid > ?1");
+              sqlite3_bind_int64(query, 1, spatialSnapshot->maxId());
+              while (stepSelect(query)) {
+                  spatialSnapshot->add({sqlite3_column_int64(query, 0),
+                                        static_cast<FGPositioned::Type>(sqlite3_column_int(query, 1)),
+                                        SGVec3d(sqlite3_column_double(query, 2),
+                                                sqlite3_column_double(query, 3),
+                                                sqlite3_column_double(query, 4))});
+              }
+              reset(query);
+          }
+      }
+
+      return spatialSnapshot.get();
+  }
+
+  // an item stored in the snapshot moved or was removed (its rowid could
+  // be reused): drop the snapshot for this session, clear the stamp and
+  // the file, and write a fresh one when the cache is closed
+  void invalidateSpatialSnapshot()
+  {
+      if (!currentSpatialSnapshot()) {
+          return;
+      }
+
+      spatialSnapshotStale = true;
+      spatialSnapshot.reset();
+      spatialSnapshotChecked = true;
+
+      if (!readOnly) {
+          outer->writeStringProperty("spatial-snapshot-stamp", "");
+          spatialSnapshotPath().remove();
+      }
+  }
+
+  void writeSpatialSnapshot()
+  {
+      // unmap any previous snapshot, it is re-opened on next use
+      spatialSnapshot.reset();
+      spatialSnapshotChecked = false;
+      spatialSnapshotStale = false;
+
+      if (!spatialSnapshotEnabled) {
+          spatialSnapshotPath().remove();
+          return;
+      }
+
+      sqlite3_stmt_ptr query = prepare("SELECT rowid, type, cart_x, cart_y, cart_z FROM positioned "
+                                       "WHERE octree_node IS NOT NULL");
+      std::vector<PositionedSnapshot::Item> items;
+      while (stepSelect(query)) {
+          items.push_back({sqlite3_column_int64(query, 0),
+                           static_cast<FGPositioned::Type>(sqlite3_column_int(query, 1)),
+                           SGVec3d(sqlite3_column_double(query, 2),
+                                   sqlite3_column_double(query, 3),
+                                   sqlite3_column_double(query, 4))});
+      }
+      reset(query);
+
+      // the stamp ties the snapshot to this build of the database
+      const std::string stamp = std::to_string(SGTimeStamp::now().toUSecs());
+      if (PositionedSnapshot::write(spatialSnapshotPath(), stamp, std::move(items))) {
+          outer->writeStringProperty("spatial-snapshot-stamp", stamp);
+      }
+  }
+
   NavDataCache* outer;
   sqlite3* db;
   SGPath path;
@@ -1004,6 +1114,7 @@ public:
     sqlite3_stmt_ptr insertPositionedQuery, insertAirport, insertTower, insertRunway,
         insertCommStation, insertNavaid;
     sqlite3_stmt_ptr insertTempPosQuery;
+    sqlite3_stmt_ptr metarStations;
     sqlite3_stmt_ptr setAirportMetar, setRunwayReciprocal, setRunwayILS, setNavaidColocated,
         updatePosition, updateTempPos;
     sqlite3_stmt_ptr removePositionedQuery, removeTempPosQuery;
@@ -1026,6 +1137,7 @@ public:
     sqlite3_stmt_ptr findAirway, findAirwayNet, insertAirwayEdge,
         isPosInAirway, airwayEdgesFrom, airwayEdgesTo,
         insertAirway, airwayEdges;
+    sqlite3_stmt_ptr airwayNetworkEdges, airwayNetworkNodes;
     sqlite3_stmt_ptr loadAirway;
 
     // since there's many permutations of ident/name queries, we create
@@ -1044,7 +1156,14 @@ public:
 
     // transient rowIDs (not actually present in the on-disk DB, only in our
     // in-memory cache / temporary table) start at this value and count down
-    PositionedID nextTransientId = -1000;
+    // ground networks are loaded on worker threads, see GroundNetLoader
+    std::atomic<PositionedID> nextTransientId{-1000};
+
+    std::unique_ptr<PositionedSnapshot> spatialSnapshot;
+    bool spatialSnapshotChecked = false;
+    bool spatialSnapshotStale = false;
+    // /sim/navdb/spatial-snapshot, read before the rebuild thread starts
+    bool spatialSnapshotEnabled = true;
 };
 
 //////////////////////////////////////////////////////////////////////
@@ -1404,6 +1523,9 @@ NavDataCache::~NavDataCache()
       d->abandonCache = true;
       d->rebuilder.reset(); // will the destructor which does a join()
       addSentryBreadcrumb("abandoned rebuild scuessfully", "info");
+  } else if (d->spatialSnapshotStale && !d->readOnly) {
+      // the snapshot was dropped when an item in it changed
+      d->writeSpatialSnapshot();
   }
 
 
@@ -1524,6 +1646,7 @@ bool NavDataCache::isRebuildRequired()
 NavDataCache::RebuildPhase NavDataCache::rebuild()
 {
     if (!d->rebuilder.get()) {
+        d->spatialSnapshotEnabled = fgGetBool("/sim/navdb/spatial-snapshot", true);
         d->rebuilder.reset(new RebuildThread(this));
         d->rebuilder->start();
     }
@@ -1661,6 +1784,7 @@ void NavDataCache::doRebuild()
           SG_LOG(SG_NAVCACHE, SG_INFO, "awy.dat load took:" << st.elapsedMSec());
 
           d->flushDeferredOctreeUpdates();
+          d->writeSpatialSnapshot();
 
           string sceneryPaths = SGPath::join(globals->get_fg_scenery(), ";");
           writeStringProperty("scenery_paths", sceneryPaths);
@@ -2002,6 +2126,14 @@ void NavDataCache::updatePosition(PositionedID item, const SGGeod &pos)
     sqlite3_bind_double(stmt, 4, pos.getElevationM());
 
     if (!isTemporary) {
+        // rows newer than the snapshot are held in memory and simply move
+        auto snapshot = d->currentSpatialSnapshot();
+        if (snapshot && (item > snapshot->maxId()) && (it != d->cache.end())) {
+            snapshot->add({item, it->second->type(), cartPos});
+        } else {
+            d->invalidateSpatialSnapshot();
+        }
+
         // bug 905; the octree leaf may change here, but the leaf may already be
         // loaded, and caching its children. (Either the old or new leaf!). Worse,
         // we may be called here as a result of loading one of those leaf's children.
@@ -2176,6 +2308,21 @@ bool NavDataCache::removePOI(FGPositionedRef ref)
     return true;
 }
 
+MetarStationVec NavDataCache::metarStations()
+{
+    MetarStationVec result;
+    sqlite3_bind_int(d->metarStations, 1, FGPositioned::AIRPORT);
+    sqlite3_bind_int(d->metarStations, 2, FGPositioned::SEAPORT);
+    while (d->stepSelect(d->metarStations)) {
+        SGVec3d cart(sqlite3_column_double(d->metarStations, 1),
+                     sqlite3_column_double(d->metarStations, 2),
+                     sqlite3_column_double(d->metarStations, 3));
+        result.push_back(MetarStation(sqlite3_column_int64(d->metarStations, 0), cart));
+    }
+    d->reset(d->metarStations);
+    return result;
+}
+
 void NavDataCache::setAirportMetar(const string& icao, bool hasMetar)
 {
   sqlite_bind_stdstring(d->setAirportMetar, 1, icao);
@@ -2618,6 +2765,26 @@ AirwayEdgeVec NavDataCache::airwayEdgesFrom(int network, PositionedID pos)
   return result;
 }
 
+void NavDataCache::loadAirwayNetwork(int network, AirwayNetworkEdgeVec& edges, AirwayNetworkNodeVec& nodes)
+{
+    sqlite3_bind_int(d->airwayNetworkEdges, 1, network);
+    while (d->stepSelect(d->airwayNetworkEdges)) {
+        edges.push_back({sqlite3_column_int(d->airwayNetworkEdges, 0),
+                         sqlite3_column_int64(d->airwayNetworkEdges, 1),
+                         sqlite3_column_int64(d->airwayNetworkEdges, 2)});
+    }
+    d->reset(d->airwayNetworkEdges);
+
+    sqlite3_bind_int(d->airwayNetworkNodes, 1, network);
+    while (d->stepSelect(d->airwayNetworkNodes)) {
+        SGVec3d cart(sqlite3_column_double(d->airwayNetworkNodes, 1),
+                     sqlite3_column_double(d->airwayNetworkNodes, 2),
+                     sqlite3_column_double(d->airwayNetworkNodes, 3));
+        nodes.push_back(AirwayNetworkNode(sqlite3_column_int64(d->airwayNetworkNodes, 0), cart));
+    }
+    d->reset(d->airwayNetworkNodes);
+}
+
 AirwayRef NavDataCache::loadAirway(int airwayID)
 {
     sqlite3_bind_int(d->loadAirway, 1, airwayID);
@@ -2769,6 +2936,15 @@ SGPath NavDataCache::path() const
     return d->path;
 }
 
+const PositionedSnapshot* NavDataCache::spatialSnapshot()
+{
+    if (!fgGetBool("/sim/navdb/spatial-snapshot", true)) {
+        return nullptr;
+    }
+
+    return d->currentSpatialSnapshot();
+}
+
 PositionedID NavDataCache::createTransientID()
 {
     return d->nextTransientId--;
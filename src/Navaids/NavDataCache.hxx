@@ -32,6 +32,22 @@ typedef std::vector<TypedPositioned> TypedPositionedVec;
 typedef std::pair<int, PositionedID> AirwayEdge;
 typedef std::vector<AirwayEdge> AirwayEdgeVec;
 
+// an edge of an airway network: airway ID, from node ID, to node ID
+struct AirwayNetworkEdge {
+    int airway;
+    PositionedID from;
+    PositionedID to;
+};
+typedef std::vector<AirwayNetworkEdge> AirwayNetworkEdgeVec;
+
+// a node of an airway network, with its cartesian position
+typedef std::pair<PositionedID, SGVec3d> AirwayNetworkNode;
+typedef std::vector<AirwayNetworkNode> AirwayNetworkNodeVec;
+
+// an airport with a METAR, with its cartesian position
+typedef std::pair<PositionedID, SGVec3d> MetarStation;
+typedef std::vector<MetarStation> MetarStationVec;
+
 namespace Octree {
 class Node;
 class Branch;
@@ -40,6 +56,8 @@ class Branch;
 class Airway;
 using AirwayRef = SGSharedPtr<Airway>;
 
+class PositionedSnapshot;
+
 class NavDataCache
 {
 public:
@@ -55,6 +73,15 @@ public:
 
     SGPath path() const;
 
+    /**
+     * Read-only snapshot of the spatially indexed items written by the
+     * last rebuild, or nullptr if it is disabled, missing, or one of its
+     * items was moved or removed this session. Items inserted since the
+     * rebuild are included. When present, spatial queries use it instead
+     * of the persistent octree.
+     */
+    const PositionedSnapshot* spatialSnapshot();
+
     enum DatFileType {
         DATFILETYPE_APT = 0,
         DATFILETYPE_METAR,
@@ -190,6 +217,9 @@ public:
     /// update the metar flag associated with an airport
     void setAirportMetar(const std::string& icao, bool hasMetar);
 
+    /// all airports, heliports and seaports with a METAR, with one query
+    MetarStationVec metarStations();
+
     /**
    * Modify the position of an existing item.
    */
@@ -303,6 +333,13 @@ public:
    */
     AirwayEdgeVec airwayEdgesFrom(int network, PositionedID pos);
 
+    /**
+     * retrieve a complete airway network, all edges and the positions of
+     * all nodes, with one query each. Used to build the in-memory routing
+     * graph.
+     */
+    void loadAirwayNetwork(int network, AirwayNetworkEdgeVec& edges, AirwayNetworkNodeVec& nodes);
+
     AirwayRef loadAirway(int airwayID);
 
     /**
@@ -19,6 +19,7 @@
 #include <simgear/timing/timestamp.hxx>
 
 #include "PolyLine.hxx"
+#include "PositionedSnapshot.hxx"
 
 namespace flightgear::Octree
 {
@@ -325,18 +326,90 @@ int Branch::childMask() const
   return result;
 }
 
+static FGPositioned::Type filterMinType(FGPositioned::Filter* aFilter)
+{
+    return aFilter ? aFilter->minType() : FGPositioned::INVALID;
+}
+
+static FGPositioned::Type filterMaxType(FGPositioned::Filter* aFilter)
+{
+    return aFilter ? aFilter->maxType() : FGPositioned::LAST_TYPE;
+}
+
+/**
+ * Nearest persistent items from the snapshot, in increasing distance.
+ * Only candidates passing the type range are loaded and given to the filter.
+ * Returns false if the time ran out before the search was done.
+ */
+static bool findNearestInSnapshot(const PositionedSnapshot& aSnapshot, const SGVec3d& aPos,
+                                  unsigned int aN, double aCutoffM, FGPositioned::Filter* aFilter,
+                                  FindNearestResults& aResults, const SGTimeStamp& aStart, int aCutoffMsec)
+{
+    NavDataCache* cache = NavDataCache::instance();
+    PositionedSnapshot::NearestIterator it(aSnapshot, aPos, aCutoffM,
+                                           filterMinType(aFilter), filterMaxType(aFilter));
+    PositionedSnapshot::Candidate c;
+    while (aResults.size() < aN) {
+        if (aStart.elapsedMSec() >= aCutoffMsec) {
+            return false;
+        }
+
+        if (!it.next(c)) {
+            break;
+        }
+
+        FGPositioned* p = cache->loadById(c.second);
+        if (!p || (aFilter && !aFilter->pass(p))) {
+            continue;
+        }
+
+        aResults.push_back(OrderedPositioned(p, c.first));
+    }
+
+    return true;
+}
+
+static void findAllInSnapshot(const PositionedSnapshot& aSnapshot, const SGVec3d& aPos,
+                              double aRangeM, FGPositioned::Filter* aFilter,
+                              FindNearestResults& aResults)
+{
+    PositionedSnapshot::CandidateVec candidates;
+    aSnapshot.findWithinRange(aPos, aRangeM, filterMinType(aFilter), filterMaxType(aFilter), candidates);
+
+    NavDataCache* cache = NavDataCache::instance();
+    for (const auto& c : candidates) {
+        FGPositioned* p = cache->loadById(c.second);
+        if (!p || (aFilter && !aFilter->pass(p))) {
+            continue;
+        }
+
+        aResults.push_back(OrderedPositioned(p, c.first));
+    }
+
+    // the octree search merges into sorted results
+    std::sort(aResults.begin(), aResults.end());
+}
+
 bool findNearestN(const SGVec3d& aPos, unsigned int aN, double aCutoffM, FGPositioned::Filter* aFilter, FGPositionedList& aResults, int aCutoffMsec)
 {
   aResults.clear();
   FindNearestPQueue pq;
   FindNearestResults results;
-  pq.push(Ordered<Node*>(globalPersistentOctree(), 0));
-  pq.push(Ordered<Node*>(globalTransientOctree(), 0));
   double cut = aCutoffM;
 
   SGTimeStamp tm;
   tm.stamp();
 
+  // with a snapshot, only transient items need the octree
+  bool snapshotComplete = true;
+  auto snapshot = NavDataCache::instance()->spatialSnapshot();
+  if (snapshot) {
+      snapshotComplete = findNearestInSnapshot(*snapshot, aPos, aN, aCutoffM, aFilter, results, tm, aCutoffMsec);
+  } else {
+      pq.push(Ordered<Node*>(globalPersistentOctree(), 0));
+  }
+  pq.push(Ordered<Node*>(globalTransientOctree(), 0));
+
   while (!pq.empty() && (tm.elapsedMSec() < aCutoffMsec)) {
     if (!results.empty()) {
         // terminate the search if we have sufficient results, and we are
@@ -364,7 +437,7 @@ bool findNearestN(const SGVec3d& aPos, unsigned int aN, double aCutoffM, FGPosit
     aResults[r] = results[r].get();
   }
 
-  return !pq.empty();
+  return !pq.empty() || !snapshotComplete;
 }
 
 bool findAllWithinRange(const SGVec3d& aPos, double aRangeM, FGPositioned::Filter* aFilter, FGPositionedList& aResults, int aCutoffMsec)
@@ -372,10 +445,17 @@ bool findAllWithinRange(const SGVec3d& aPos, double aRangeM, FGPositioned::Filte
   aResults.clear();
   FindNearestPQueue pq;
   FindNearestResults results;
-  pq.push(Ordered<Node*>(globalPersistentOctree(), 0));
-  pq.push(Ordered<Node*>(globalTransientOctree(), 0));
   double rng = aRangeM;
 
+  // with a snapshot, only transient items need the octree
+  auto snapshot = NavDataCache::instance()->spatialSnapshot();
+  if (snapshot) {
+      findAllInSnapshot(*snapshot, aPos, aRangeM, aFilter, results);
+  } else {
+      pq.push(Ordered<Node*>(globalPersistentOctree(), 0));
+  }
+  pq.push(Ordered<Node*>(globalTransientOctree(), 0));
+
   SGTimeStamp tm;
   tm.stamp();
 
@@ -0,0 +1,294 @@
+/*
+ * SPDX-FileCopyrightText: 2026 FlightGear Developers
+ * SPDX_FileComment: read-only columnar snapshot of the spatially indexed positioned items
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "config.h"
+
+#include "PositionedSnapshot.hxx"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <functional>
+
+#include <simgear/debug/logstream.hxx>
+#include <simgear/io/iostreams/sgstream.hxx>
+#include <simgear/io/sg_mmap.hxx>
+#include <simgear/misc/sg_path.hxx>
+
+namespace flightgear {
+
+namespace {
+
+const char SNAPSHOT_MAGIC[8] = {'F', 'G', 'P', 'O', 'S', 'S', 'N', 'P'};
+const uint32_t SNAPSHOT_VERSION = 1;
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t count;
+    char stamp[32];
+};
+
+static_assert(sizeof(SnapshotHeader) % 8 == 0, "columns must stay 8-byte aligned");
+
+// file layout after the header: int64 ids[count], double x[count],
+// double y[count], double z[count], int32 types[count]
+size_t fileSizeForCount(uint32_t count)
+{
+    return sizeof(SnapshotHeader) + count * (sizeof(int64_t) + 3 * sizeof(double) + sizeof(int32_t));
+}
+
+} // namespace
+
+PositionedSnapshot::~PositionedSnapshot()
+{
+    if (_file) {
+        _file->close();
+    }
+}
+
+void PositionedSnapshot::buildTree(std::vector<Item>& items, size_t begin, size_t end, unsigned int depth)
+{
+    if (end - begin < 2) {
+        return;
+    }
+
+    // the median becomes the splitting node of this range, smaller
+    // coordinates go left, larger ones right
+    const size_t mid = begin + (end - begin) / 2;
+    const unsigned int axis = depth % 3;
+    std::nth_element(items.begin() + begin, items.begin() + mid, items.begin() + end,
+                     [axis](const Item& a, const Item& b) { return a.cart[axis] < b.cart[axis]; });
+
+    buildTree(items, begin, mid, depth + 1);
+    buildTree(items, mid + 1, end, depth + 1);
+}
+
+bool PositionedSnapshot::write(const SGPath& path, const std::string& stamp, std::vector<Item> items)
+{
+    buildTree(items, 0, items.size(), 0);
+
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.count = static_cast<uint32_t>(items.size());
+    strncpy(header.stamp, stamp.c_str(), sizeof(header.stamp) - 1);
+
+    sg_ofstream out(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        SG_LOG(SG_NAVCACHE, SG_WARN, "unable to write positioned snapshot at:" << path);
+        return false;
+    }
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const auto& it : items) {
+        const int64_t id = it.id;
+        out.write(reinterpret_cast<const char*>(&id), sizeof(id));
+    }
+
+    for (unsigned int axis = 0; axis < 3; ++axis) {
+        for (const auto& it : items) {
+            const double c = it.cart[axis];
+            out.write(reinterpret_cast<const char*>(&c), sizeof(c));
+        }
+    }
+
+    for (const auto& it : items) {
+        const int32_t ty = it.type;
+        out.write(reinterpret_cast<const char*>(&ty), sizeof(ty));
+    }
+
+    out.close();
+    if (out.fail()) {
+        SG_LOG(SG_NAVCACHE, SG_WARN, "failed writing positioned snapshot at:" << path);
+        SGPath(path).remove();
+        return false;
+    }
+
+    SG_LOG(SG_NAVCACHE, SG_INFO, "wrote positioned snapshot with " << items.size() << " items");
+    return true;
+}
+
+std::unique_ptr<PositionedSnapshot> PositionedSnapshot::open(const SGPath& path, const std::string& stamp)
+{
+    if (!path.exists()) {
+        return {};
+    }
+
+    std::unique_ptr<PositionedSnapshot> result(new PositionedSnapshot);
+    result->_file.reset(new SGMMapFile(path));
+    if (!result->_file->open(SG_IO_IN)) {
+        SG_LOG(SG_NAVCACHE, SG_WARN, "unable to map positioned snapshot at:" << path);
+        return {};
+    }
+
+    const char* data = result->_file->get();
+    const size_t size = result->_file->get_size();
+    if (size < sizeof(SnapshotHeader)) {
+        return {};
+    }
+
+    SnapshotHeader header;
+    memcpy(&header, data, sizeof(header));
+    header.stamp[sizeof(header.stamp) - 1] = 0;
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) ||
+        (header.version != SNAPSHOT_VERSION) ||
+        (size != fileSizeForCount(header.count)) ||
+        (stamp != header.stamp))
+    {
+        SG_LOG(SG_NAVCACHE, SG_INFO, "positioned snapshot at:" << path << " is out of date, ignoring");
+        return {};
+    }
+
+    const uint32_t n = header.count;
+    const char* p = data + sizeof(SnapshotHeader);
+    result->_count = n;
+    result->_ids = reinterpret_cast<const int64_t*>(p);
+    p += n * sizeof(int64_t);
+    for (unsigned int axis = 0; axis < 3; ++axis) {
+        result->_coords[axis] = reinterpret_cast<const double*>(p);
+        p += n * sizeof(double);
+    }
+    result->_types = reinterpret_cast<const int32_t*>(p);
+    result->_maxId = n ? *std::max_element(result->_ids, result->_ids + n) : 0;
+
+    return result;
+}
+
+void PositionedSnapshot::add(const Item& item)
+{
+    assert(item.id > _maxId);
+    remove(item.id);
+    _additions.push_back(item);
+}
+
+void PositionedSnapshot::remove(PositionedID id)
+{
+    auto it = std::find_if(_additions.begin(), _additions.end(),
+                           [id](const Item& item) { return item.id == id; });
+    if (it != _additions.end()) {
+        _additions.erase(it);
+    }
+}
+
+void PositionedSnapshot::findWithinRange(const SGVec3d& pos, double rangeM,
+                                         FGPositioned::Type minType, FGPositioned::Type maxType,
+                                         CandidateVec& result) const
+{
+    findWithinRange(0, _count, 0, pos, rangeM, minType, maxType, result);
+
+    for (const auto& it : _additions) {
+        const double d = dist(pos, it.cart);
+        if ((it.type >= minType) && (it.type <= maxType) && (d <= rangeM)) {
+            result.push_back(Candidate(d, it.id));
+        }
+    }
+}
+
+void PositionedSnapshot::findWithinRange(uint32_t begin, uint32_t end, unsigned int depth,
+                                         const SGVec3d& pos, double rangeM,
+                                         FGPositioned::Type minType, FGPositioned::Type maxType,
+                                         CandidateVec& result) const
+{
+    while (begin < end) {
+        const uint32_t mid = begin + (end - begin) / 2;
+        if (typeMatches(mid, minType, maxType)) {
+            const double d = distance(mid, pos);
+            if (d <= rangeM) {
+                result.push_back(Candidate(d, _ids[mid]));
+            }
+        }
+
+        const double diff = pos[depth % 3] - coordinate(mid, depth % 3);
+        ++depth;
+
+        // recurse into the far side only if the range crosses the split
+        // plane, continue with the near side iteratively
+        if (diff < 0.0) {
+            if (-diff <= rangeM) {
+                findWithinRange(mid + 1, end, depth, pos, rangeM, minType, maxType, result);
+            }
+            end = mid;
+        } else {
+            if (diff <= rangeM) {
+                findWithinRange(begin, mid, depth, pos, rangeM, minType, maxType, result);
+            }
+            begin = mid + 1;
+        }
+    }
+}
+
+PositionedSnapshot::NearestIterator::NearestIterator(const PositionedSnapshot& snapshot,
+                                                     const SGVec3d& pos, double cutoffM,
+                                                     FGPositioned::Type minType,
+                                                     FGPositioned::Type maxType) : _snapshot(snapshot),
+                                                                                   _pos(pos),
+                                                                                   _cutoffM(cutoffM),
+                                                                                   _minType(minType),
+                                                                                   _maxType(maxType)
+{
+    pushSubtree(0, snapshot._count, 0, 0.0);
+
+    // additions are few, they go straight onto the heap as items
+    for (uint32_t i = 0; i < snapshot._additions.size(); ++i) {
+        const Item& it = snapshot._additions[i];
+        const double d = dist(pos, it.cart);
+        if ((it.type >= minType) && (it.type <= maxType) && (d <= cutoffM)) {
+            _heap.push_back(Entry{d, snapshot._count + i, snapshot._count + i, 0, true});
+            std::push_heap(_heap.begin(), _heap.end(), std::greater<Entry>());
+        }
+    }
+}
+
+void PositionedSnapshot::NearestIterator::pushSubtree(uint32_t begin, uint32_t end, uint32_t depth, double bound)
+{
+    if ((begin >= end) || (bound > _cutoffM)) {
+        return;
+    }
+
+    _heap.push_back(Entry{bound, begin, end, depth, false});
+    std::push_heap(_heap.begin(), _heap.end(), std::greater<Entry>());
+}
+
+bool PositionedSnapshot::NearestIterator::next(Candidate& candidate)
+{
+    while (!_heap.empty()) {
+        std::pop_heap(_heap.begin(), _heap.end(), std::greater<Entry>());
+        const Entry e = _heap.back();
+        _heap.pop_back();
+
+        if (e.isItem) {
+            candidate = Candidate(e.distance, _snapshot.idAt(e.begin));
+            return true;
+        }
+
+        const uint32_t mid = e.begin + (e.end - e.begin) / 2;
+        if (_snapshot.typeMatches(mid, _minType, _maxType)) {
+            const double d = _snapshot.distance(mid, _pos);
+            if (d <= _cutoffM) {
+                _heap.push_back(Entry{d, mid, mid, e.depth, true});
+                std::push_heap(_heap.begin(), _heap.end(), std::greater<Entry>());
+            }
+        }
+
+        // the far side can be no closer than the split plane
+        const double diff = _pos[e.depth % 3] - _snapshot.coordinate(mid, e.depth % 3);
+        const double farBound = std::max(e.distance, fabs(diff));
+        if (diff < 0.0) {
+            pushSubtree(e.begin, mid, e.depth + 1, e.distance);
+            pushSubtree(mid + 1, e.end, e.depth + 1, farBound);
+        } else {
+            pushSubtree(mid + 1, e.end, e.depth + 1, e.distance);
+            pushSubtree(e.begin, mid, e.depth + 1, farBound);
+        }
+    }
+
+    return false;
+}
+
+} // namespace flightgear
@@ -0,0 +1,149 @@
+/*
+ * SPDX-FileCopyrightText: 2026 FlightGear Developers
+ * SPDX_FileComment: read-only columnar snapshot of the spatially indexed positioned items
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Navaids/positioned.hxx>
+
+class SGMMapFile;
+
+namespace flightgear {
+
+/**
+ * Compact, memory-mapped copy of the persistent (spatially indexed)
+ * positioned items: ID, type and cartesian position, stored as columns and
+ * ordered as an implicit k-d tree. It is written once at the end of a cache
+ * rebuild and answers range and nearest queries without touching SQLite;
+ * callers only load full FGPositioned objects for candidates they keep.
+ *
+ * Transient items (negative IDs) are never part of the snapshot. Persistent
+ * items inserted after it was written (IDs above maxId()) are kept in a small
+ * in-memory list which every query scans as well.
+ */
+class PositionedSnapshot
+{
+public:
+    struct Item {
+        PositionedID id;
+        FGPositioned::Type type;
+        SGVec3d cart;
+    };
+
+    /// a candidate found by a query, and its distance in metres
+    typedef std::pair<double, PositionedID> Candidate;
+    typedef std::vector<Candidate> CandidateVec;
+
+    ~PositionedSnapshot();
+
+    /**
+     * Write a snapshot of the items to path. The stamp is stored in the
+     * file and must be passed to open() for the snapshot to be accepted.
+     */
+    static bool write(const SGPath& path, const std::string& stamp, std::vector<Item> items);
+
+    /**
+     * Map an existing snapshot. Returns nullptr if the file is missing,
+     * malformed or was written with a different stamp.
+     */
+    static std::unique_ptr<PositionedSnapshot> open(const SGPath& path, const std::string& stamp);
+
+    size_t size() const { return _count + _additions.size(); }
+
+    /// the highest ID stored in the file, later rows must be add()ed
+    PositionedID maxId() const { return _maxId; }
+
+    /// include (or move) an item newer than the file, its ID must be above maxId()
+    void add(const Item& item);
+
+    /// forget an item previously passed to add()
+    void remove(PositionedID id);
+
+    /**
+     * All items within range with a type in [minType, maxType], in no
+     * particular order.
+     */
+    void findWithinRange(const SGVec3d& pos, double rangeM,
+                         FGPositioned::Type minType, FGPositioned::Type maxType,
+                         CandidateVec& result) const;
+
+    /**
+     * Incremental nearest neighbour search: every call to next() returns
+     * the next closest item with a type in [minType, maxType], so callers
+     * can apply arbitrary filters and stop once they have enough results.
+     */
+    class NearestIterator
+    {
+    public:
+        NearestIterator(const PositionedSnapshot& snapshot, const SGVec3d& pos, double cutoffM,
+                        FGPositioned::Type minType, FGPositioned::Type maxType);
+
+        /// returns false when no further item lies within the cutoff
+        bool next(Candidate& candidate);
+
+    private:
+        struct Entry {
+            double distance; // exact for items, a lower bound for subtrees
+            uint32_t begin;  // the item index, for items (>= count for additions)
+            uint32_t end;
+            uint32_t depth;
+            bool isItem;
+            bool operator>(const Entry& other) const { return distance > other.distance; }
+        };
+
+        void pushSubtree(uint32_t begin, uint32_t end, uint32_t depth, double bound);
+
+        const PositionedSnapshot& _snapshot;
+        const SGVec3d _pos;
+        const double _cutoffM;
+        const FGPositioned::Type _minType, _maxType;
+        std::vector<Entry> _heap;
+    };
+
+private:
+    PositionedSnapshot() = default;
+
+    static void buildTree(std::vector<Item>& items, size_t begin, size_t end, unsigned int depth);
+
+    void findWithinRange(uint32_t begin, uint32_t end, unsigned int depth,
+                         const SGVec3d& pos, double rangeM,
+                         FGPositioned::Type minType, FGPositioned::Type maxType,
+                         CandidateVec& result) const;
+
+    double coordinate(uint32_t index, unsigned int axis) const
+    {
+        return _coords[axis][index];
+    }
+
+    bool typeMatches(uint32_t index, FGPositioned::Type minType, FGPositioned::Type maxType) const
+    {
+        return (_types[index] >= minType) && (_types[index] <= maxType);
+    }
+
+    double distance(uint32_t index, const SGVec3d& pos) const
+    {
+        return dist(pos, SGVec3d(_coords[0][index], _coords[1][index], _coords[2][index]));
+    }
+
+    PositionedID idAt(uint32_t index) const
+    {
+        return (index < _count) ? _ids[index] : _additions[index - _count].id;
+    }
+
+    std::unique_ptr<SGMMapFile> _file;
+    uint32_t _count = 0;
+    const int64_t* _ids = nullptr;
+    const double* _coords[3] = {nullptr, nullptr, nullptr};
+    const int32_t* _types = nullptr;
+    PositionedID _maxId = 0;
+    std::vector<Item> _additions;
+};
+
+} // namespace flightgear
@@ -11,12 +11,16 @@
 
 #include <tuple>
 #include <algorithm>
-#include <set>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <unordered_map>
 
 #include <simgear/sg_inlines.h>
 #include <simgear/structure/exception.hxx>
 #include <simgear/io/iostreams/sgstream.hxx>
 #include <simgear/misc/sg_path.hxx>
+#include <simgear/timing/timestamp.hxx>
 
 #include <Main/globals.hxx>
 #include <Navaids/positioned.hxx>
@@ -25,7 +29,6 @@
 
 using std::make_pair;
 using std::string;
-using std::set;
 using std::vector;
 
 //#define DEBUG_AWY_SEARCH 1
@@ -38,45 +41,52 @@ typedef SGSharedPtr<FGPositioned> FGPositionedRef;
 
 //////////////////////////////////////////////////////////////////////////////
 
-class AStarOpenNode : public SGReferenced
+/**
+ * Airway network in compressed sparse row form. Positioned IDs are mapped
+ * to dense indices; the edges leaving node i are [offsets[i], offsets[i+1])
+ * in the edge arrays. All edges are bidirectional.
+ */
+struct Airway::Network::Graph
 {
-public:
-    AStarOpenNode(FGPositionedRef aNode, double aLegDist,
-                  int aAirway,
-                  FGPositionedRef aDest, AStarOpenNode* aPrev) : node(aNode),
-                                                                 previous(aPrev),
-                                                                 airway(aAirway)
-    {
-        distanceFromStart = aLegDist;
-        if (previous) {
-            distanceFromStart += previous->distanceFromStart;
-        }
+    std::vector<PositionedID> ids;
+    std::vector<SGVec3d> directions; // unit vectors from the earth centre
+    std::unordered_map<PositionedID, int> indexById;
 
-        directDistanceToDestination = SGGeodesy::distanceM(node->geod(), aDest->geod());
-    }
+    std::vector<int> offsets;
+    std::vector<int> targets;
+    std::vector<int> airways;
+    std::vector<double> lengthsM;
 
-  virtual ~AStarOpenNode()
-  {
-  }
+    int index(PositionedID id) const
+    {
+        auto it = indexById.find(id);
+        return (it == indexById.end()) ? -1 : it->second;
+    }
 
-  FGPositionedRef node;
-  SGSharedPtr<AStarOpenNode> previous;
-  int airway;
-  double distanceFromStart; // aka 'g(x)'
-  double directDistanceToDestination; // aka 'h(x)'
-
-  /**
-	 * aka 'f(x)'
-	 */
-	double totalCost() const {
-		return distanceFromStart + directDistanceToDestination;
-	}
+    /**
+     * great-circle distance on a sphere of the smallest radius of curvature
+     * of the ellipsoid, the meridional one at the equator, a(1 - e^2) =
+     * b^2/a. No geodesic is shorter than that arc, so this is an admissible
+     * A* heuristic.
+     */
+    double lowerBoundDistanceM(int a, int b) const
+    {
+        // b^2/a = b * (b/a)
+        static const double minRadiusM = SGGeodesy::POLRAD * SGGeodesy::SQUASH;
+        const SGVec3d& u = directions[a];
+        const SGVec3d& v = directions[b];
+        return minRadiusM * atan2(norm(cross(u, v)), dot(u, v));
+    }
 };
 
-using AStarOpenNodeRef = SGSharedPtr<AStarOpenNode>;
-
 ////////////////////////////////////////////////////////////////////////////
 
+Airway::Network::Network() : _networkID(UnknownLevel)
+{
+}
+
+Airway::Network::~Network() = default;
+
 Airway::Network* Airway::lowLevel()
 {
   static Network* static_lowLevel = nullptr;
@@ -442,6 +452,7 @@ void Airway::Network::addEdge(int aWay, const SGGeod& aStartPos,
   }
 
   NavDataCache::instance()->insertEdge(_networkID, aWay, start->guid(), end->guid());
+  _graph.reset(); // rebuilt from the cache on next use
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -455,14 +466,79 @@ static double headingDiffDeg(double a, double b)
 
 bool Airway::Network::inNetwork(PositionedID posID) const
 {
-  NetworkMembershipDict::iterator it = _inNetworkCache.find(posID);
-  if (it != _inNetworkCache.end()) {
-    return it->second; // cached, easy
-  }
+    return graph().index(posID) >= 0;
+}
 
-  bool r =  NavDataCache::instance()->isInAirwayNetwork(_networkID, posID);
-  _inNetworkCache.insert(it, std::make_pair(posID, r));
-  return r;
+const Airway::Network::Graph& Airway::Network::graph() const
+{
+    if (_graph) {
+        return *_graph;
+    }
+
+    SGTimeStamp st;
+    st.stamp();
+
+    _graph.reset(new Graph);
+    Graph& g = *_graph;
+
+    AirwayNetworkEdgeVec edges;
+    AirwayNetworkNodeVec nodes;
+    NavDataCache::instance()->loadAirwayNetwork(_networkID, edges, nodes);
+
+    std::vector<SGGeod> geods;
+    g.ids.reserve(nodes.size());
+    g.directions.reserve(nodes.size());
+    geods.reserve(nodes.size());
+    for (const auto& n : nodes) {
+        g.indexById[n.first] = static_cast<int>(g.ids.size());
+        g.ids.push_back(n.first);
+        g.directions.push_back(normalize(n.second));
+        geods.push_back(SGGeod::fromCart(n.second));
+    }
+
+    // count the degree of each node, then fill in the edges; every edge is
+    // stored once per direction
+    g.offsets.assign(g.ids.size() + 1, 0);
+    for (const auto& e : edges) {
+        const int a = g.index(e.from), b = g.index(e.to);
+        if ((a < 0) || (b < 0)) {
+            continue;
+        }
+        ++g.offsets[a + 1];
+        ++g.offsets[b + 1];
+    }
+
+    for (size_t i = 1; i < g.offsets.size(); ++i) {
+        g.offsets[i] += g.offsets[i - 1];
+    }
+
+    const size_t numEdges = g.offsets.back();
+    g.targets.resize(numEdges);
+    g.airways.resize(numEdges);
+    g.lengthsM.resize(numEdges);
+
+    std::vector<int> fill(g.offsets.begin(), g.offsets.end() - 1);
+    for (const auto& e : edges) {
+        const int a = g.index(e.from), b = g.index(e.to);
+        if ((a < 0) || (b < 0)) {
+            continue;
+        }
+
+        const double d = SGGeodesy::distanceM(geods[a], geods[b]);
+        int i = fill[a]++;
+        g.targets[i] = b;
+        g.airways[i] = e.airway;
+        g.lengthsM[i] = d;
+
+        i = fill[b]++;
+        g.targets[i] = a;
+        g.airways[i] = e.airway;
+        g.lengthsM[i] = d;
+    }
+
+    SG_LOG(SG_NAVAID, SG_DEBUG, "built airway graph for network " << _networkID << ": "
+           << g.ids.size() << " nodes, " << numEdges << " edges in " << st.elapsedMSec() << "msec");
+    return g;
 }
 
 bool Airway::Network::route(WayptRef aFrom, WayptRef aTo,
@@ -592,126 +668,86 @@ Airway::Network::findNodeByIdent(const std::string& ident, const SGGeod& near) c
 
 /////////////////////////////////////////////////////////////////////////////
 
-typedef vector<AStarOpenNodeRef> OpenNodeHeap;
-
-static void buildWaypoints(AStarOpenNodeRef aNode, WayptVec& aRoute)
-{
-// count the route length, and hence pre-size aRoute
-  size_t count = 0;
-  AStarOpenNodeRef n = aNode;
-  for (; n != nullptr; ++count, n = n->previous) {;}
-  aRoute.resize(count);
-
-// run over the route, creating waypoints
-  for (n = aNode; n; n=n->previous) {
-      // get / create airway to be the owner for this waypoint
-      AirwayRef awy = Airway::loadByCacheId(n->airway);
-      auto wp = new NavaidWaypoint(n->node, awy);
-      if (awy) {
-          wp->setFlag(WPT_VIA);
-      }
-      wp->setFlag(WPT_GENERATED);
-      aRoute[--count] = wp;
-  }
-}
-
-/**
- * Inefficient (linear) helper to find an open node in the heap
- */
-static AStarOpenNodeRef
-findInOpen(const OpenNodeHeap& aHeap, FGPositioned* aPos)
-{
-  for (unsigned int i=0; i<aHeap.size(); ++i) {
-    if (aHeap[i]->node == aPos) {
-      return aHeap[i];
-    }
-  }
-
-  return nullptr;
-}
-
-class HeapOrder
-{
-public:
-  bool operator()(AStarOpenNode* a, AStarOpenNode* b)
-  {
-    return a->totalCost() > b->totalCost();
-  }
-};
-
 bool Airway::Network::search2(FGPositionedRef aStart, FGPositionedRef aDest,
   WayptVec& aRoute)
 {
-    typedef set<PositionedID> ClosedNodeSet;
+    const Graph& g = graph();
+    const int start = g.index(aStart->guid());
+    const int dest = g.index(aDest->guid());
+    if ((start < 0) || (dest < 0)) {
+        SG_LOG(SG_NAVAID, SG_INFO, "A* route end-point is not on the airway network");
+        return false;
+    }
+
+    const size_t count = g.ids.size();
+    std::vector<double> distanceFromStart(count, std::numeric_limits<double>::max()); // aka 'g(x)'
+    std::vector<int> previous(count, -1);
+    std::vector<int> previousAirway(count, 0);
 
-    OpenNodeHeap openNodes;
-    ClosedNodeSet closedNodes;
-    HeapOrder ordering;
+    // open nodes ordered by f(x) = g(x) + h(x). Instead of updating a node in
+    // place when a better path is found, it is pushed again and the stale
+    // entry is skipped when popped.
+    typedef std::pair<double, int> OpenNode;
+    std::priority_queue<OpenNode, std::vector<OpenNode>, std::greater<OpenNode>> openNodes;
 
-    openNodes.push_back(new AStarOpenNode(aStart, 0.0, 0, aDest, nullptr));
+    distanceFromStart[start] = 0.0;
+    openNodes.push(OpenNode(g.lowerBoundDistanceM(start, dest), start));
 
-    // A* open node iteration
     while (!openNodes.empty()) {
-        std::pop_heap(openNodes.begin(), openNodes.end(), ordering);
-        AStarOpenNodeRef x = openNodes.back();
-        FGPositioned* xp = x->node;
-        openNodes.pop_back();
-        closedNodes.insert(xp->guid());
+        const OpenNode top = openNodes.top();
+        openNodes.pop();
+
+        const int x = top.second;
+        if (top.first > distanceFromStart[x] + g.lowerBoundDistanceM(x, dest)) {
+            continue; // stale entry
+        }
 
 #ifdef DEBUG_AWY_SEARCH
-    SG_LOG(SG_NAVAID, SG_INFO, "x:" << xp->ident() << ", f(x)=" << x->totalCost());
+        SG_LOG(SG_NAVAID, SG_INFO, "x:" << g.ids[x] << ", f(x)=" << top.first);
 #endif
 
-  // check if xp is the goal; if so we're done, since there cannot be an open
-  // node with lower f(x) value.
-    if (xp == aDest) {
-      buildWaypoints(x, aRoute);
-      return true;
-    }
+        // check if x is the goal; if so we're done, since there cannot be an open
+        // node with lower f(x) value.
+        if (x == dest) {
+            std::vector<int> path;
+            for (int n = x; n >= 0; n = previous[n]) {
+                path.push_back(n);
+            }
 
-  // adjacent (neighbour) iteration
-    NavDataCache* cache = NavDataCache::instance();
-    for (auto other : cache->airwayEdgesFrom(_networkID, xp->guid())) {
-      if (closedNodes.count(other.second)) {
-        continue; // closed, ignore
-      }
-
-      FGPositioned* yp = cache->loadById(other.second);
-      double edgeDistanceM = SGGeodesy::distanceM(xp->geod(), yp->geod());
-      AStarOpenNodeRef y = findInOpen(openNodes, yp);
-      if (y) { // already open
-        double g = x->distanceFromStart + edgeDistanceM;
-        if (g > y->distanceFromStart) {
-          // worse path, ignore
-#ifdef DEBUG_AWY_SEARCH
-          SG_LOG(SG_NAVAID, SG_INFO, "\tabandoning " << yp->ident() <<
-           " path is worse: g(y)" << y->distanceFromStart << ", g'=" << g);
-#endif
-          continue;
+            NavDataCache* cache = NavDataCache::instance();
+            aRoute.clear();
+            aRoute.reserve(path.size());
+            for (auto it = path.rbegin(); it != path.rend(); ++it) {
+                // get / create airway to be the owner for this waypoint
+                AirwayRef awy = Airway::loadByCacheId(previousAirway[*it]);
+                auto wp = new NavaidWaypoint(cache->loadById(g.ids[*it]), awy);
+                if (awy) {
+                    wp->setFlag(WPT_VIA);
+                }
+                wp->setFlag(WPT_GENERATED);
+                aRoute.push_back(wp);
+            }
+
+            return true;
         }
 
-      // we need to update y. Unfortunately this means rebuilding the heap,
-      // since y's score can change arbitrarily
-#ifdef DEBUG_AWY_SEARCH
-        SG_LOG(SG_NAVAID, SG_INFO, "\tfixing up previous for new path to " << yp->ident() << ", d =" << g);
-#endif
-        y->previous = x;
-        y->distanceFromStart = g;
-        y->airway = other.first;
-        std::make_heap(openNodes.begin(), openNodes.end(), ordering);
-      } else { // not open, insert a new node for y into the heap
-        y = new AStarOpenNode(yp, edgeDistanceM, other.first, aDest, x);
-#ifdef DEBUG_AWY_SEARCH
-        SG_LOG(SG_NAVAID, SG_INFO, "\ty=" << yp->ident() << ", f(y)=" << y->totalCost());
-#endif
-        openNodes.push_back(y);
-        std::push_heap(openNodes.begin(), openNodes.end(), ordering);
-      }
-    } // of neighbour iteration
+        // adjacent (neighbour) iteration
+        for (int e = g.offsets[x]; e < g.offsets[x + 1]; ++e) {
+            const int y = g.targets[e];
+            const double d = distanceFromStart[x] + g.lengthsM[e];
+            if (d >= distanceFromStart[y]) {
+                continue; // not an improvement
+            }
+
+            distanceFromStart[y] = d;
+            previous[y] = x;
+            previousAirway[y] = g.airways[e];
+            openNodes.push(OpenNode(d + g.lowerBoundDistanceM(y, dest), y));
+        }
     } // of open node iteration
 
-  SG_LOG(SG_NAVAID, SG_INFO, "A* failed to find route");
-  return false;
+    SG_LOG(SG_NAVAID, SG_INFO, "A* failed to find route");
+    return false;
 }
 
 } // of namespace flightgear
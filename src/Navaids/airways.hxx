@@ -7,6 +7,7 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <vector>
 
 #include <Navaids/route.hxx>
@@ -94,6 +95,8 @@ public:
     friend class Airway;
     friend class InAirwayFilter;
 
+    Network();
+    ~Network();
 
     /**
      * Principal routing algorithm. Attempts to find the best route between
@@ -145,10 +148,12 @@ private:
     std::pair<FGPositionedRef, bool> findClosestNode(WayptRef aRef);
 
     /**
-     * cache which positioned items are in this network
+     * in-memory compressed adjacency representation of the network, loaded
+     * from the NavDataCache on first use
      */
-    typedef std::map<PositionedID, bool> NetworkMembershipDict;
-    mutable NetworkMembershipDict _inNetworkCache;
+    struct Graph;
+    const Graph& graph() const;
+    mutable std::unique_ptr<Graph> _graph;
 
     Level _networkID;
   };
@@ -633,6 +633,9 @@ class RoutePath::RoutePathPrivate
 public:
     WayptDataVec waypoints;
 
+    /// running sum of pathDistanceM, so distance lookups are O(1) or O(log n)
+    std::vector<double> cumulativeDistanceM;
+
     AircraftPerformance perf;
     bool constrainLegCourses;
     double maxFlyByTurnAngleDeg = 90.0;
@@ -816,6 +819,32 @@ public:
     return total;
   }
 
+  void updateCumulativeDistances(unsigned int startIndex)
+  {
+    cumulativeDistanceM.resize(waypoints.size());
+    double total = (startIndex > 0) ? cumulativeDistanceM[startIndex - 1] : 0.0;
+    for (unsigned int i = startIndex; i < waypoints.size(); ++i) {
+      total += waypoints[i].pathDistanceM;
+      cumulativeDistanceM[i] = total;
+    }
+  }
+
+  /**
+   * a waypoint whose position and inbound course depend only on itself and
+   * the preceding waypoints, so geometry before it is unaffected by any
+   * change after it.
+   */
+  bool isAnchor(unsigned int index) const
+  {
+    const WayptData& w(waypoints[index]);
+    if (w.skipped || !w.posValid || w.wpt->flag(WPT_DYNAMIC)) {
+      return false;
+    }
+
+    const std::string& ty(w.wpt->type());
+    return (ty != "discontinuity") && (ty != "vectors") && (ty != "via");
+  }
+
     WayptDataVec::iterator previousValidWaypoint(unsigned int index)
     {
         do {
@@ -870,6 +899,68 @@ RoutePath::RoutePath(const flightgear::FlightPlan* fp) :
     commonInit();
 }
 
+void RoutePath::update(const flightgear::FlightPlan* fp, int firstChangedIndex)
+{
+    WayptVec current;
+    for (int l=0; l<fp->numLegs(); ++l) {
+        WayptRef wpt = fp->legAtIndex(l)->waypoint();
+        if (!wpt) {
+            SG_LOG(SG_NAVAID, SG_DEV_ALERT, "Waypoint " << l << " of " << fp->numLegs() << "is NULL");
+            break;
+        }
+        current.push_back(wpt);
+    }
+
+    const bool constrainLegCourses = fp->followLegTrackToFixes();
+    size_t firstChanged = std::min(current.size(), d->waypoints.size());
+    if (firstChangedIndex >= 0) {
+        firstChanged = std::min(firstChanged, static_cast<size_t>(firstChangedIndex));
+    }
+
+    if (constrainLegCourses != d->constrainLegCourses) {
+        firstChanged = 0;
+    }
+
+    for (size_t i = 0; i < firstChanged; ++i) {
+        if (d->waypoints[i].wpt != current[i]) {
+            firstChanged = i;
+            break;
+        }
+    }
+
+    if ((firstChanged == current.size()) && (firstChanged == d->waypoints.size())) {
+        return; // nothing changed
+    }
+
+    // restart from the last anchor before the change: the turn into it, and
+    // everything preceding it, cannot see the changed waypoints.
+    unsigned int startIndex = 0;
+    for (auto i = static_cast<int>(firstChanged) - 1; i > 0; --i) {
+        if (d->isAnchor(i)) {
+            startIndex = i;
+            break;
+        }
+    }
+
+    // descent VNAV altitudes look forward along the route, so a dynamic
+    // waypoint computed from them may depend on the changed part
+    for (unsigned int i = 0; i < startIndex; ++i) {
+        const WayptRef& w = d->waypoints[i].wpt;
+        if (w->flag(WPT_DYNAMIC) && isDescentWaypoint(w)) {
+            startIndex = 0;
+            break;
+        }
+    }
+
+    d->waypoints.erase(d->waypoints.begin() + startIndex, d->waypoints.end());
+    for (size_t i = startIndex; i < current.size(); ++i) {
+        d->waypoints.push_back(WayptData(current[i]));
+    }
+
+    d->constrainLegCourses = constrainLegCourses;
+    commonInit(startIndex);
+}
+
 
 RoutePath::RoutePath(const RoutePath& other)
 {
@@ -886,20 +977,20 @@ RoutePath::~RoutePath()
 {
 }
 
-void RoutePath::commonInit()
+void RoutePath::commonInit(unsigned int startIndex)
 {
-  for (auto& w : d->waypoints) {
-    w.initPass0();
+  for (unsigned int i=startIndex; i<d->waypoints.size(); ++i) {
+    d->waypoints[i].initPass0();
   }
 
-  for (unsigned int i=1; i<d->waypoints.size(); ++i) {
+  for (unsigned int i=std::max(1U, startIndex); i<d->waypoints.size(); ++i) {
     WayptData* nextPtr = ((i + 1) < d->waypoints.size()) ? &d->waypoints[i+1] : nullptr;
     auto prev = d->previousValidWaypoint(i);
     WayptData* prevPtr = (prev == d->waypoints.end()) ? nullptr : &(*prev);
     d->waypoints[i].initPass1(prevPtr, nextPtr);
   }
 
-  for (unsigned int i=0; i<d->waypoints.size(); ++i) {
+  for (unsigned int i=startIndex; i<d->waypoints.size(); ++i) {
       if (d->waypoints[i].skipped) {
           continue;
       }
@@ -936,6 +1027,8 @@ void RoutePath::commonInit()
     // now turn is computed, can resolve distances
     d->waypoints[i].pathDistanceM = computeDistanceForIndex(i);
   }
+
+  d->updateCumulativeDistances(startIndex);
 }
 
 SGGeodVec RoutePath::pathForIndex(int index) const
@@ -1201,7 +1294,11 @@ double RoutePath::distanceBetweenIndices(int from, int to) const
         to = sz - 1;
     }
 
-    return d->distanceBetweenIndices(from, to);
+    if (to <= from) {
+        return 0.0;
+    }
+
+    return d->cumulativeDistanceM[to] - d->cumulativeDistanceM[from];
 }
 
 SGGeod RoutePath::positionForDistanceFrom(int index, double distanceM) const
@@ -1216,34 +1313,27 @@ SGGeod RoutePath::positionForDistanceFrom(int index, double distanceM) const
                              "RoutePath::positionForDistanceFrom");
   }
 
-  // find the actual leg we're within
+  // find the actual leg we're within. Note pathDistanceM is 0 for skipped
+  // waypoints, so they never contain the position.
+  const auto& cumulative = d->cumulativeDistanceM;
+  const double target = cumulative[index] + distanceM;
   if (distanceM < 0.0) {
-    // scan backwards
-    while ((index > 0) && (distanceM < 0.0)) {
-      // we are looking at index n, say 4, but with a negative distance.
-      // we want to look at index n-1 (so, 3), and see if this makes
-      // distance positive. We need to offset by distance from 3 -> 4,
-      // which is waypoint 4's path distance.
-
-      // note pathDistanceM is 0 for skipped waypoints, so this works out
-      distanceM += d->waypoints[index].pathDistanceM;
-      --index;
-    }
-
-    if (distanceM < 0.0) {
-      // still negative, return route start
+    // last waypoint at or before the target distance
+    auto it = std::upper_bound(cumulative.begin(), cumulative.begin() + index + 1, target);
+    if (it == cumulative.begin()) {
+      // before the route start
       return d->waypoints[0].pos;
     }
 
+    index = static_cast<int>(std::distance(cumulative.begin(), it)) - 1;
   } else {
-    // scan forwards
-    int nextIndex = index + 1;
-    while ((nextIndex < sz) && (d->waypoints[nextIndex].pathDistanceM < distanceM)) {
-      distanceM -= d->waypoints[nextIndex].pathDistanceM;
-      index = nextIndex++;
-    }
+    // the position lies on the leg into the first waypoint reaching the target
+    auto it = std::lower_bound(cumulative.begin() + index + 1, cumulative.end(), target);
+    index = static_cast<int>(std::distance(cumulative.begin(), it)) - 1;
   }
 
+  distanceM = target - cumulative[index];
+
   auto nextIt = d->nextValidWaypoint(index);
   if (nextIt == d->waypoints.end()) {
     // past route end, just return final position
@@ -29,6 +29,14 @@ public:
   RoutePath(const RoutePath& other);
   RoutePath& operator=(const RoutePath& other);
 
+  /**
+   * Bring the path up to date with the current legs of fp. Geometry for
+   * waypoints before firstChangedIndex is reused when the leading waypoints
+   * are unchanged; waypoints are compared by identity, so a conservative
+   * index only costs extra work, never a stale result.
+   */
+  void update(const flightgear::FlightPlan* fp, int firstChangedIndex);
+
   flightgear::SGGeodVec pathForIndex(int index) const;
 
   SGGeod positionForIndex(int index) const;
@@ -44,7 +52,7 @@ public:
 private:
   class RoutePathPrivate;
 
-  void commonInit();
+  void commonInit(unsigned int startIndex = 0);
 
   double computeDistanceForIndex(int index) const;
 
@@ -0,0 +1,29 @@
+// NasalProfileUriHandler.cxx -- the Nasal profile in folded stack format
+//
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "NasalProfileUriHandler.hxx"
+
+#include <Main/globals.hxx>
+#include <Scripting/NasalProfiler.hxx>
+#include <Scripting/NasalSys.hxx>
+
+namespace flightgear::http {
+
+bool NasalProfileUriHandler::handleRequest( const HTTPRequest & request, HTTPResponse & response, Connection * connection )
+{
+  response.Header["Content-Type"] = "text/plain";
+
+  auto nasalSys = globals->get_subsystem<FGNasalSys>();
+  if (!nasalSys) {
+    response.StatusCode = 503;
+    response.Content = "Nasal is not running";
+    return true;
+  }
+
+  response.Content = nasalSys->profiler().folded();
+  return true;
+}
+
+} // namespace flightgear::http
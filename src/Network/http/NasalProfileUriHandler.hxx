@@ -0,0 +1,23 @@
+// NasalProfileUriHandler.hxx -- the Nasal profile in folded stack format
+//
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "urihandler.hxx"
+
+namespace flightgear::http {
+
+/**
+ * Serves what nasal-profile-dump would write, for flame graph tools to
+ * fetch from a running sim. Profiling is started and stopped with the
+ * nasal-profile-start/-stop commands, e.g. through the run handler.
+ */
+class NasalProfileUriHandler : public URIHandler {
+public:
+  NasalProfileUriHandler( const std::string& uri = "/nasal-profile" ) : URIHandler( uri ) {}
+  bool handleRequest( const HTTPRequest & request, HTTPResponse & response, Connection * connection ) override;
+};
+
+} // namespace flightgear::http
@@ -31,6 +31,7 @@
 #include "PkgUriHandler.hxx"
 #include "RunUriHandler.hxx"
 #include "NavdbUriHandler.hxx"
+#include "NasalProfileUriHandler.hxx"
 #include "PropertyChangeObserver.hxx"
 #include <Main/fg_props.hxx>
 
@@ -479,6 +480,11 @@ void MongooseHttpd::init()
       SG_LOG(SG_NETWORK, SG_INFO, "httpd: adding navdb uri handler at " << uri);
       _uriHandler.push_back(new flightgear::http::NavdbUriHandler(uri));
     }
+
+    if (!(uri = n->getStringValue("nasal-profile")).empty()) {
+      SG_LOG(SG_NETWORK, SG_INFO, "httpd: adding nasal-profile uri handler at " << uri);
+      _uriHandler.push_back(new flightgear::http::NasalProfileUriHandler(uri));
+    }
   }
 
   _server = mg_create_server(this, MongooseHttpd::staticRequestHandler);
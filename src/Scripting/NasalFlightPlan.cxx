@@ -587,7 +587,23 @@ static void waypointGhostSetMember(naContext c, void* g, naRef field, naRef valu
 {
     const char* fieldName = naStr_data(field);
     Waypt*      wpt = (Waypt*)g;
-    waypointCommonSetMember(c, wpt, fieldName, value);
+    if (!waypointCommonSetMember(c, wpt, fieldName, value)) {
+        return;
+    }
+
+    // a waypoint of a flight plan, edited without going through its leg
+    auto fp = dynamic_cast<FlightPlan*>(wpt->owner());
+    if (!fp) {
+        return;
+    }
+
+    for (int i = 0; i < fp->numLegs(); ++i) {
+        auto leg = fp->legAtIndex(i);
+        if (leg->waypoint() == wpt) {
+            leg->markWaypointDirty();
+            break;
+        }
+    }
 }
 
 static void legGhostSetMember(naContext c, void* g, naRef field, naRef value)
@@ -2113,8 +2129,7 @@ static naRef f_leg_courseAndDistanceFrom(naContext c, naRef me, int argc, naRef*
     SGGeod pos;
     geodFromArgs(args, 0, argc, pos);
 
-    RoutePath path(leg->owner());
-    SGGeod    wpPos = path.positionForIndex(leg->index());
+    SGGeod    wpPos = leg->owner()->routePath().positionForIndex(leg->index());
     double    courseDeg, az2, distanceM;
     SGGeodesy::inverse(pos, wpPos, courseDeg, az2, distanceM);
 
@@ -2131,8 +2146,7 @@ static naRef f_leg_path(naContext c, naRef me, int argc, naRef* args)
         naRuntimeError(c, "leg.setAltitude called on non-flightplan-leg object");
     }
 
-    RoutePath path(leg->owner());
-    SGGeodVec gv(path.pathForIndex(leg->index()));
+    SGGeodVec gv(leg->owner()->routePath().pathForIndex(leg->index()));
 
     naRef result = naNewVector(c);
     for (SGGeod p : gv) {
@@ -0,0 +1,162 @@
+// NasalProfiler.cxx -- time spent in Nasal, by the callback it was entered through
+//
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <config.h>
+
+#include "NasalProfiler.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+#include <simgear/debug/logstream.hxx>
+#include <simgear/io/iostreams/sgstream.hxx>
+#include <simgear/structure/commands.hxx>
+
+#include <Main/globals.hxx>
+
+void NasalProfiler::init(SGPropertyNode* root)
+{
+    _root = root;
+    _enabled = _root->getBoolValue("enabled");
+
+    auto commands = globals->get_commands();
+    commands->addCommand("nasal-profile-start", this, &NasalProfiler::startCommand);
+    commands->addCommand("nasal-profile-stop", this, &NasalProfiler::stopCommand);
+    commands->addCommand("nasal-profile-dump", this, &NasalProfiler::dumpCommand);
+}
+
+void NasalProfiler::shutdown()
+{
+    auto commands = globals->get_commands();
+    commands->removeCommand("nasal-profile-start");
+    commands->removeCommand("nasal-profile-stop");
+    commands->removeCommand("nasal-profile-dump");
+    _enabled = false;
+    _root.clear();
+}
+
+void NasalProfiler::enter(const char* kind, const std::string& where)
+{
+    _stack.push_back({SGTimeStamp::now(), 0.0, _path.size()});
+
+    std::string label(kind);
+    if (!where.empty())
+        label += ' ' + where;
+    // ';' separates the frames of a stack
+    std::replace(label.begin(), label.end(), ';', ',');
+
+    if (!_path.empty())
+        _path += ';';
+    _path += label;
+}
+
+void NasalProfiler::leave()
+{
+    if (_stack.empty())
+        return;
+
+    const Entry entry = _stack.back();
+    _stack.pop_back();
+
+    const double sec = (SGTimeStamp::now() - entry.start).toSecs();
+    _folded[_path] += sec - entry.childSec;
+    _path.resize(entry.pathLength);
+
+    if (_stack.empty())
+        _frameSec += sec;
+    else
+        _stack.back().childSec += sec;
+}
+
+void NasalProfiler::endFrame()
+{
+    if (!_root)
+        return;
+
+    _enabled = _root->getBoolValue("enabled");
+    if (!_enabled && (_frameSec == 0.0))
+        return;
+
+    _frames++;
+    _totalSec += _frameSec;
+    _maxFrameSec = std::max(_maxFrameSec, _frameSec);
+
+    _root->setDoubleValue("frame-ms", _frameSec * 1000.0);
+    _root->setDoubleValue("average-frame-ms", _totalSec * 1000.0 / _frames);
+    _root->setDoubleValue("max-frame-ms", _maxFrameSec * 1000.0);
+    _root->setIntValue("frames", _frames);
+    _frameSec = 0.0;
+}
+
+void NasalProfiler::reset()
+{
+    // entries in progress are still timed, into the new profile
+    _folded.clear();
+    _frameSec = _totalSec = _maxFrameSec = 0.0;
+    _frames = 0;
+}
+
+std::string NasalProfiler::folded() const
+{
+    std::vector<std::pair<std::string, double>> stacks(_folded.begin(), _folded.end());
+    std::sort(stacks.begin(), stacks.end());
+
+    std::ostringstream os;
+    for (const auto& s : stacks) {
+        const auto usec = std::llround(s.second * 1e6);
+        if (usec > 0)
+            os << s.first << ' ' << usec << '\n';
+    }
+    return os.str();
+}
+
+bool NasalProfiler::write(const SGPath& path) const
+{
+    sg_ofstream out(path, std::ios::out | std::ios::trunc);
+    out << folded();
+    return !out.fail();
+}
+
+bool NasalProfiler::startCommand(const SGPropertyNode*, SGPropertyNode*)
+{
+    reset();
+    _root->setBoolValue("enabled", true);
+    _enabled = true;
+    return true;
+}
+
+bool NasalProfiler::stopCommand(const SGPropertyNode*, SGPropertyNode*)
+{
+    _root->setBoolValue("enabled", false);
+    _enabled = false;
+    return true;
+}
+
+// nasal-profile-dump [path]: write the profile, by default to
+// $FG_HOME/Export/nasal-profile.folded
+bool NasalProfiler::dumpCommand(const SGPropertyNode* arg, SGPropertyNode*)
+{
+    SGPath path = SGPath::fromUtf8(arg->getStringValue("path"));
+    if (path.isNull())
+        path = globals->get_fg_home() / "Export" / "nasal-profile.folded";
+
+    const SGPath authorizedPath = path.validate(true /* write */);
+    if (authorizedPath.isNull()) {
+        SG_LOG(SG_NASAL, SG_ALERT, "nasal-profile-dump: writing to '" << path.utf8Str()
+               << "' is not authorized. Please choose another location, for instance "
+               "in the $FG_HOME/Export folder ("
+               << (globals->get_fg_home() / "Export").utf8Str() << ").");
+        return false;
+    }
+
+    if (!write(authorizedPath)) {
+        SG_LOG(SG_NASAL, SG_ALERT, "nasal-profile-dump: failed to write " << authorizedPath);
+        return false;
+    }
+
+    SG_LOG(SG_NASAL, SG_INFO, "nasal-profile-dump: wrote " << authorizedPath);
+    return true;
+}
@@ -0,0 +1,91 @@
+// NasalProfiler.hxx -- time spent in Nasal, by the callback it was entered through
+//
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <simgear/misc/sg_path.hxx>
+#include <simgear/props/props.hxx>
+#include <simgear/timing/timestamp.hxx>
+
+/**
+ * Measures every entry from C++ into Nasal (timers, listeners, commands,
+ * bindings, module loads) while /sim/nasal-profile/enabled is set.
+ *
+ * Each entry is labelled with its kind and the file and line it was
+ * registered from. Entries made from within another one nest, so the time
+ * is kept per stack of labels. The profile can be written in the folded
+ * format flame graph tools read, with microseconds as the counts.
+ */
+class NasalProfiler
+{
+public:
+    /// one entry into Nasal, measured if profiling is on
+    class Scope
+    {
+    public:
+        Scope(NasalProfiler& profiler, const char* kind, const std::string& where) : _profiler(profiler.enabled() ? &profiler : nullptr)
+        {
+            if (_profiler)
+                _profiler->enter(kind, where);
+        }
+
+        ~Scope()
+        {
+            if (_profiler)
+                _profiler->leave();
+        }
+
+    private:
+        NasalProfiler* _profiler;
+    };
+
+    /// the properties below root, and the nasal-profile-* commands
+    void init(SGPropertyNode* root);
+    void shutdown();
+
+    bool enabled() const { return _enabled; }
+
+    /// once per frame: publish the time of the frame
+    void endFrame();
+
+    void reset();
+
+    /// the profile in folded stack format, one stack per line
+    std::string folded() const;
+
+    bool write(const SGPath& path) const;
+
+private:
+    struct Entry {
+        SGTimeStamp start;
+        double childSec;
+        size_t pathLength; // of _path before the entry
+    };
+
+    void enter(const char* kind, const std::string& where);
+    void leave();
+
+    bool startCommand(const SGPropertyNode* arg, SGPropertyNode* root);
+    bool stopCommand(const SGPropertyNode* arg, SGPropertyNode* root);
+    bool dumpCommand(const SGPropertyNode* arg, SGPropertyNode* root);
+
+    SGPropertyNode_ptr _root;
+    bool _enabled = false;
+
+    std::vector<Entry> _stack;
+    std::string _path; // labels of the stack, separated by ';'
+
+    // self time in seconds by stack
+    std::unordered_map<std::string, double> _folded;
+
+    double _frameSec = 0.0;
+    double _totalSec = 0.0;
+    double _maxFrameSec = 0.0;
+    unsigned int _frames = 0;
+};
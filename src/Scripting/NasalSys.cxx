@@ -119,7 +119,8 @@ public:
   {
     char nm[256];
     if (c) {
-        snprintf(nm, 128, "maketimer-[%p]-%s:%d", (void*)this, naStr_data(naGetSourceFile(c, 0)), naGetLine(c, 0));
+        _source = std::string(naStr_data(naGetSourceFile(c, 0))) + ":" + std::to_string(naGetLine(c, 0));
+        snprintf(nm, 128, "maketimer-[%p]-%s", (void*)this, _source.c_str());
     }
     else {
         snprintf(nm, 128, "maketimer-%p", this);
@@ -192,6 +193,7 @@ public:
       // event manager).
       _isRunning = false;
 
+    NasalProfiler::Scope scope(_sys->profiler(), "maketimer", _source);
     naRef *args = nullptr;
     _sys->callMethod(_func, _self, 0, args, naNil() /* locals */);
   }
@@ -208,6 +210,7 @@ public:
   { return _name; }
 private:
   std::string _name;
+  std::string _source;
   FGNasalSys* _sys;
   naRef _func, _self;
   int _gcRoot, _gcSelf;
@@ -801,6 +804,7 @@ public:
 
     bool operator()(const SGPropertyNode* aNode, SGPropertyNode* root) override
     {
+        NasalProfiler::Scope scope(_sys->profiler(), "command", _name);
         _sys->setCmdArg(const_cast<SGPropertyNode*>(aNode));
         naRef args[1];
         args[0] = _sys->wrappedPropsNode(const_cast<SGPropertyNode*>(aNode));
@@ -1060,6 +1064,8 @@ void FGNasalSys::init()
     int i;
 
     d->_context = naNewContext();
+    d->_listenerProfile = fgGetNode("/sim/nasal-listener-profile", true);
+    d->_profiler.init(fgGetNode("/sim/nasal-profile", true));
 
     // Start with globals.  Add it to itself as a recursive
     // sub-reference under the name "globals".  This gives client-code
@@ -1185,9 +1191,15 @@ void FGNasalSys::shutdown()
     shutdownNasalFlightPlan();
     shutdownNasalUnitTestInSim();
 
+    d->_profiler.shutdown();
+
     for (auto l : d->_listener)
         delete l.second;
     d->_listener.clear();
+    d->_frame_listener.clear();
+    for (auto l : d->_dead_listener)
+        delete l;
+    d->_dead_listener.clear();
 
     for (auto c : d->_commands) {
         globals->get_commands()->removeCommand(c.first);
@@ -1246,14 +1258,30 @@ naRef FGNasalSys::wrappedPropsNode(SGPropertyNode* aProps)
     return wrapped;
 }
 
-void FGNasalSys::update(double)
+void FGNasalSys::update(double dt)
 {
     if( NasalClipboard::getInstance() )
         NasalClipboard::getInstance()->update();
 
-    std::for_each(d->_dead_listener.begin(), d->_dead_listener.end(),
+    // PER_FRAME listeners see the value the frame ended with; those written
+    // to from these callbacks wait for the next frame
+    d->_frame_listener_calls.swap(d->_frame_listener);
+    for (auto l : d->_frame_listener_calls) {
+        l->_queued = false;
+        if (!l->_dead && l->changed(l->_node))
+            l->call(l->_node, naNum(0));
+    }
+    d->_frame_listener_calls.clear();
+
+    updateListenerProfile(dt);
+
+    // a listener removed after it was queued for the next frame goes once
+    // that frame has taken it off the queue
+    auto queued = std::partition(d->_dead_listener.begin(), d->_dead_listener.end(),
+                                 [](FGNasalListener* l) { return l->_queued; });
+    std::for_each(queued, d->_dead_listener.end(),
                   [](FGNasalListener* l) { delete l; });
-    d->_dead_listener.clear();
+    d->_dead_listener.erase(queued, d->_dead_listener.end());
 
     if (!d->_loadList.empty()) {
         if (d->_delay_load)
@@ -1281,6 +1309,8 @@ void FGNasalSys::update(double)
     // they're very fast, just trust me). -Andy
     naFreeContext(d->_context);
     d->_context = naNewContext();
+
+    d->_profiler.endFrame();
 }
 
 bool pathSortPredicate(const SGPath& p1, const SGPath& p2)
@@ -1495,6 +1525,7 @@ bool FGNasalSys::createModule(const char* moduleName, const char* fileName,
                               const SGPropertyNode* cmdarg,
                               int argc, naRef* args)
 {
+    NasalProfiler::Scope scope(d->_profiler, "module", moduleName);
     naContext ctx = naNewContext();
     std::string errors;
     naRef code = parse(ctx, fileName, src, len, errors);
@@ -1673,6 +1704,7 @@ bool FGNasalSys::handleCommand( const char* moduleName,
                                 const SGPropertyNode* arg,
                                 SGPropertyNode* root)
 {
+    NasalProfiler::Scope scope(d->_profiler, "binding", fileName);
     naContext ctx = naNewContext();
     std::string errorMessage;
     naRef code = parse(ctx, fileName, src, strlen(src), errorMessage);
@@ -1744,13 +1776,14 @@ void FGNasalSys::setTimer(naContext c, int argc, naRef* args)
     bool simtime = (argc > 2 && naTrue(args[2])) ? false : true;
 
     // A unique name for the timer based on the file name and line number of the function.
-    std::string name = "settimer-";
-    name.append(naStr_data(naGetSourceFile(c, 0)));
-    name.append(":");
-    name.append(std::to_string(naGetLine(c, 0)));
+    std::string source = naStr_data(naGetSourceFile(c, 0));
+    source.append(":");
+    source.append(std::to_string(naGetLine(c, 0)));
+    const std::string name = "settimer-" + source;
 
     // Generate and register a C++ timer handler
     NasalTimer* t = new NasalTimer(handler, this);
+    t->source = source;
     d->_nasalTimers.push_back(t);
     globals->get_event_mgr()->addEvent(name,
                                        [t](){ t->timerExpired(); },
@@ -1759,13 +1792,21 @@ void FGNasalSys::setTimer(naContext c, int argc, naRef* args)
 
 void FGNasalSys::handleTimer(NasalTimer* t)
 {
-    call(t->handler, 0, 0, naNil());
+    {
+        NasalProfiler::Scope scope(d->_profiler, "settimer", t->source);
+        call(t->handler, 0, 0, naNil());
+    }
     auto it = std::find(d->_nasalTimers.begin(), d->_nasalTimers.end(), t);
     assert(it != d->_nasalTimers.end());
     d->_nasalTimers.erase(it);
     delete t;
 }
 
+NasalProfiler& FGNasalSys::profiler()
+{
+    return d->_profiler;
+}
+
 int FGNasalSys::gcSave(naRef r)
 {
     return naGCSave(r);
@@ -1808,9 +1849,11 @@ int NasalSysPrivate::_listenerId = 0;
 // called initially. If the fourth, optional argument is set to 0, then the
 // function is only called when the property node value actually changes.
 // Otherwise it's called independent of the value whenever the node is
-// written to (default). The setlistener() function returns a unique
-// id number, which is to be used as argument to the removelistener()
-// function.
+// written to (default). 2 also reports writes to children and children
+// being added or removed. 3 calls the function at most once per frame,
+// after the frame's writes, if the value then differs from the last call.
+// The setlistener() function returns a unique id number, which is to be
+// used as argument to the removelistener() function.
 naRef FGNasalSys::setListener(naContext c, int argc, naRef* args)
 {
     SGPropertyNode_ptr node;
@@ -1838,8 +1881,18 @@ naRef FGNasalSys::setListener(naContext c, int argc, naRef* args)
 
     int init = argc > 2 && naIsNum(args[2]) ? int(args[2].num) : 0; // do not trigger when created
     int type = argc > 3 && naIsNum(args[3]) ? int(args[3].num) : 1; // trigger will always be triggered when the property is written
+
+    // skip the setlistener() wrapper in globals.nas, as printf() does
+    int frame = 0;
+    const char* file = naStr_data(naGetSourceFile(c, 0));
+    if (file && simgear::strutils::ends_with(file, "/globals.nas")) {
+        frame += 1;
+        file = naStr_data(naGetSourceFile(c, frame));
+    }
+    std::string source = std::string(file ? file : "?") + ":" + std::to_string(naGetLine(c, frame));
+
     FGNasalListener* nl = new FGNasalListener(node, code, this,
-                                              gcSave(code), d->_listenerId, init, type);
+                                              gcSave(code), d->_listenerId, init, type, source);
 
     node->addChangeListener(nl, init != 0);
 
@@ -1864,6 +1917,60 @@ naRef FGNasalSys::removeListener(naContext c, int argc, naRef* args)
     return naNum(d->_listener.size());
 }
 
+void FGNasalSys::queueListener(FGNasalListener* listener)
+{
+    d->_frame_listener.push_back(listener);
+}
+
+// With /sim/nasal-listener-profile/enabled set, the listeners that took
+// the most time in the last second are listed below it, busiest first.
+void FGNasalSys::updateListenerProfile(double dt)
+{
+    const bool enabled = d->_listenerProfile->getBoolValue("enabled");
+    if (enabled != FGNasalListener::profiling) {
+        FGNasalListener::profiling = enabled;
+        d->_listenerProfile->removeChildren("listener");
+        d->_listenerProfileAge = 0.0;
+        for (auto l : d->_listener) {
+            l.second->_calls = 0;
+            l.second->_time_sec = 0.0;
+        }
+    }
+
+    d->_listenerProfileAge += dt;
+    if (!enabled || d->_listenerProfileAge < 1.0)
+        return;
+
+    const unsigned int maxReported = d->_listenerProfile->getIntValue("max-listeners", 20);
+    std::vector<FGNasalListener*> busiest;
+    for (auto l : d->_listener) {
+        if (l.second->_calls > 0)
+            busiest.push_back(l.second);
+    }
+    const auto n = std::min<size_t>(busiest.size(), maxReported);
+    std::partial_sort(busiest.begin(), busiest.begin() + n, busiest.end(),
+                      [](const FGNasalListener* a, const FGNasalListener* b) {
+                          return a->_time_sec > b->_time_sec;
+                      });
+
+    d->_listenerProfile->removeChildren("listener");
+    for (size_t i = 0; i < n; ++i) {
+        const FGNasalListener* l = busiest[i];
+        SGPropertyNode* node = d->_listenerProfile->getChild("listener", i, true);
+        node->setIntValue("id", l->_id);
+        node->setStringValue("property", l->_node->getPath());
+        node->setStringValue("source", l->_source);
+        node->setIntValue("calls", l->_calls);
+        node->setDoubleValue("time-ms", l->_time_sec * 1000.0);
+    }
+
+    for (auto l : d->_listener) {
+        l.second->_calls = 0;
+        l.second->_time_sec = 0.0;
+    }
+    d->_listenerProfileAge = 0.0;
+}
+
 void FGNasalSys::registerToLoad(FGNasalModelData *data)
 {
     if (d->_loadList.empty())
@@ -1922,9 +2029,11 @@ SGSubsystemMgr::Registrant<FGNasalSys> registrantFGNasalSys(
 //////////////////////////////////////////////////////////////////////////
 // FGNasalListener class.
 
+bool FGNasalListener::profiling = false;
+
 FGNasalListener::FGNasalListener(SGPropertyNode *node, naRef code,
                                  FGNasalSys* nasal, int key, int id,
-                                 int init, int type) :
+                                 int init, int type, const std::string& source) :
     _node(node),
     _code(code),
     _gcKey(key),
@@ -1934,10 +2043,14 @@ FGNasalListener::FGNasalListener(SGPropertyNode *node, naRef code,
     _type(type),
     _active(0),
     _dead(false),
+    _queued(false),
+    _last_type(simgear::props::NONE),
     _last_int(0L),
-    _last_float(0.0)
+    _source(source),
+    _calls(0),
+    _time_sec(0.0)
 {
-    if(_type == 0 && !_init)
+    if((_type == ON_CHANGE || _type == PER_FRAME) && !_init)
         changed(node);
 }
 
@@ -1951,19 +2064,37 @@ void FGNasalListener::call(SGPropertyNode* which, naRef mode)
 {
     if(_active || _dead) return;
     _active++;
+    NasalProfiler::Scope scope(_nas->profiler(), "listener", _source);
+    SGTimeStamp start;
+    if(profiling) start.stamp();
     naRef arg[4];
     arg[0] = _nas->propNodeGhost(which);
     arg[1] = _nas->propNodeGhost(_node);
     arg[2] = mode;                  // value changed, child added/removed
     arg[3] = naNum(_node != which); // child event?
     _nas->call(_code, 4, arg, naNil());
+    if(profiling) {
+        _calls++;
+        _time_sec += (SGTimeStamp::now() - start).toSecs();
+    }
     _active--;
 }
 
 void FGNasalListener::valueChanged(SGPropertyNode* node)
 {
-    if(_type < 2 && node != _node) return;   // skip child events
-    if(_type > 0 || changed(_node) || _init)
+    if((_type < WITH_CHILDREN || _type == PER_FRAME) && node != _node) return;   // skip child events
+
+    if(_type == PER_FRAME && !_init) {
+        // FGNasalSys::update() calls us with the final value
+        if(!_queued && !_dead) {
+            _queued = true;
+            _nas->queueListener(this);
+        }
+        return;
+    }
+
+    const bool always = _type > ON_CHANGE && _type != PER_FRAME;
+    if(always || changed(_node) || _init)
         call(node, naNum(0));
 
     _init = 0;
@@ -1971,12 +2102,12 @@ void FGNasalListener::valueChanged(SGPropertyNode* node)
 
 void FGNasalListener::childAdded(SGPropertyNode*, SGPropertyNode* child)
 {
-    if(_type == 2) call(child, naNum(1));
+    if(_type == WITH_CHILDREN) call(child, naNum(1));
 }
 
 void FGNasalListener::childRemoved(SGPropertyNode*, SGPropertyNode* child)
 {
-    if(_type == 2) call(child, naNum(-1));
+    if(_type == WITH_CHILDREN) call(child, naNum(-1));
 }
 
 bool FGNasalListener::changed(SGPropertyNode* node)
@@ -1986,14 +2117,17 @@ bool FGNasalListener::changed(SGPropertyNode* node)
     if(type == props::NONE) return false;
     if(type == props::UNSPECIFIED) return true;
 
-    bool result;
+    // a node that changed its type has changed
+    bool result = type != _last_type;
+    _last_type = type;
+
     switch(type) {
     case props::BOOL:
     case props::INT:
     case props::LONG:
         {
             long l = node->getLongValue();
-            result = l != _last_int;
+            result = result || l != _last_int;
             _last_int = l;
             return result;
         }
@@ -2001,16 +2135,17 @@ bool FGNasalListener::changed(SGPropertyNode* node)
     case props::DOUBLE:
         {
             double d = node->getDoubleValue();
-            result = d != _last_float;
+            result = result || d != _last_float;
             _last_float = d;
             return result;
         }
     default:
         {
+            // keep the copy we have if it is still the same
             string s = node->getStringValue();
-            result = s != _last_string;
-            _last_string = s;
-            return result;
+            if(!result && s == _last_string) return false;
+            _last_string = std::move(s);
+            return true;
         }
     }
 }
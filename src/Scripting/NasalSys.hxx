@@ -24,6 +24,7 @@ class SGCondition;
 class FGNasalModelData;
 class TimerObj;
 class NasalSysPrivate;
+class NasalProfiler;
 struct NasalTimer;
 class FGNasalModuleListener;
 
@@ -161,6 +162,9 @@ public:
 
     bool reloadModuleFromFile(const std::string& moduleName);
 
+    /// time spent in Nasal callbacks, see /sim/nasal-profile
+    NasalProfiler& profiler();
+
     // private methods: the class has a lot of friends to allow particular classes
     // to do book-keeping, this is not ideal.
 private:
@@ -189,6 +193,12 @@ private:
 
     void handleTimer(NasalTimer* t);
 
+    // FGNasalListener queues its PER_FRAME instances for update()
+    friend FGNasalListener;
+
+    void queueListener(FGNasalListener* listener);
+    void updateListenerProfile(double dt);
+
     static void logNasalStack(naContext context, string_list& stack);
 
     // members: should only be the d-ptr
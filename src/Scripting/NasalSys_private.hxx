@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include <simgear/debug/BufferedLogCallback.hxx>
 #include <simgear/nasal/nasal.h>
 #include <simgear/props/props.hxx>
@@ -11,6 +13,7 @@
 #include <simgear/xml/easyxml.hxx>
 
 #include "NasalModelData.hxx"
+#include "NasalProfiler.hxx"
 
 // forward decls
 class FGNasalSys;
@@ -26,14 +29,25 @@ int nasalStructEqual(naContext ctx, naRef a, naRef b);
 
 class FGNasalListener : public SGPropertyChangeListener {
 public:
+    // the <type> argument of setlistener()
+    enum Mode {
+        ON_CHANGE = 0,     // when the value changed
+        ON_WRITE = 1,      // whenever the node is written
+        WITH_CHILDREN = 2, // ... or one of its children, or children come and go
+        PER_FRAME = 3      // at most once per frame, if the value changed
+    };
+
     FGNasalListener(SGPropertyNode* node, naRef code, FGNasalSys* nasal,
-                    int key, int id, int init, int type);
+                    int key, int id, int init, int type, const std::string& source);
 
     virtual ~FGNasalListener();
     virtual void valueChanged(SGPropertyNode* node);
     virtual void childAdded(SGPropertyNode* parent, SGPropertyNode* child);
     virtual void childRemoved(SGPropertyNode* parent, SGPropertyNode* child);
 
+    // count calls and their time, see FGNasalSys::update()
+    static bool profiling;
+
 private:
     bool changed(SGPropertyNode* node);
     void call(SGPropertyNode* which, naRef mode);
@@ -48,9 +62,20 @@ private:
     int _type;
     unsigned int _active;
     bool _dead;
-    long _last_int;
-    double _last_float;
+    bool _queued; // for the end of the frame, PER_FRAME only
+
+    // the value at the last change; only strings keep a copy
+    simgear::props::Type _last_type;
+    union {
+        long _last_int;
+        double _last_float;
+    };
     std::string _last_string;
+
+    // where setlistener() was called, and the profile since the last report
+    std::string _source;
+    unsigned int _calls;
+    double _time_sec;
 };
 
 
@@ -84,6 +109,7 @@ struct NasalTimer
     ~NasalTimer();
 
     naRef handler;
+    std::string source; ///< file:line of the settimer() call
     int gcKey = 0;
     FGNasalSys* nasal = nullptr;
 };
@@ -110,8 +136,16 @@ public:
     bool _delay_load;
 
     // Listener
-    std::map<int, FGNasalListener*> _listener;
+    std::unordered_map<int, FGNasalListener*> _listener;
     std::vector<FGNasalListener*> _dead_listener;
+    // PER_FRAME listeners written to during this frame
+    std::vector<FGNasalListener*> _frame_listener;
+    std::vector<FGNasalListener*> _frame_listener_calls;
+
+    SGPropertyNode_ptr _listenerProfile;
+    double _listenerProfileAge = 0.0;
+
+    NasalProfiler _profiler;
 
     std::vector<FGNasalModuleListener*> _moduleListeners;
 
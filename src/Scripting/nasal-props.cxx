@@ -3,7 +3,9 @@
 
 #include "config.h"
 
+#include <algorithm>
 #include <cstring>
+#include <vector>
 
 #include <simgear/nasal/nasal.h>
 #include <simgear/props/props.hxx>
@@ -873,6 +875,132 @@ static naRef f_getNode(naContext c, naRef me, int argc, naRef* args)
 }
 
 
+// Get the values of several relative nodes in one call, as a vector with
+// nil for nodes that do not exist.
+// Forms:
+//    props.Node.getValues(vector relative_paths);
+static naRef f_getValues(naContext c, naRef me, int argc, naRef* args)
+{
+    NODEARG();
+    naRef paths = naVec_get(argv, 0);
+    if(!naIsVector(paths))
+        naRuntimeError(c, "props.getValues() with non-vector argument");
+
+    const int n = naVec_size(paths);
+    naRef values = naNewVector(c);
+    naVec_setsize(c, values, n);
+    for(int i = 0; i < n; i++) {
+        naRef path = naVec_get(paths, i);
+        SGPropertyNode* target = nullptr;
+        if(naIsString(path)) {
+            try {
+                target = node->getNode(naStr_data(path), false);
+            } catch(const string& err) {
+                naRuntimeError(c, (char *)err.c_str());
+                return naNil();
+            }
+        }
+        naVec_set(values, i, FGNasalSys::getPropertyValue(c, target));
+    }
+    return values;
+}
+
+
+// A set of nodes resolved once from relative paths, so that scripts updating
+// the same properties every frame do not look them up again on each access.
+struct PropHandleSet
+{
+    std::vector<SGPropertyNode_ptr> nodes; // null where the node did not exist
+};
+
+static void propHandleSetGhostDestroy(void* ghost)
+{
+    delete static_cast<PropHandleSet*>(ghost);
+}
+
+naGhostType PropHandleSetGhostType = { propHandleSetGhostDestroy, "prophandles", nullptr, nullptr };
+
+static PropHandleSet* ghostToPropHandleSet(naContext c, naRef ref)
+{
+    if (!naIsGhost(ref) || (naGhost_type(ref) != &PropHandleSetGhostType))
+        naRuntimeError(c, "bad argument to props handle function");
+
+    return static_cast<PropHandleSet*>(naGhost_ptr(ref));
+}
+
+// Resolve relative nodes, creating them if specified, into a handle set
+// for getHandleValues() and setHandleValues().
+// Forms:
+//    props.Node.getHandles(vector relative_paths,
+//                          bool create=false);
+static naRef f_getHandles(naContext c, naRef me, int argc, naRef* args)
+{
+    NODEARG();
+    naRef paths = naVec_get(argv, 0);
+    bool create = naTrue(naVec_get(argv, 1)) != 0;
+    if(!naIsVector(paths))
+        naRuntimeError(c, "props.getHandles() with non-vector argument");
+
+    const int n = naVec_size(paths);
+    auto set = new PropHandleSet;
+    set->nodes.reserve(n);
+    for(int i = 0; i < n; i++) {
+        naRef path = naVec_get(paths, i);
+        SGPropertyNode* target = nullptr;
+        if(naIsString(path)) {
+            try {
+                target = node->getNode(naStr_data(path), create);
+            } catch(const string& err) {
+                delete set;
+                naRuntimeError(c, (char *)err.c_str());
+                return naNil();
+            }
+        }
+        set->nodes.emplace_back(target);
+    }
+    return naNewGhost(c, &PropHandleSetGhostType, set);
+}
+
+// Get the values of the nodes of a handle set, in the order of the paths
+// it was created from.
+// Forms:
+//    props._getHandleValues(handles);
+static naRef f_getHandleValues(naContext c, naRef me, int argc, naRef* args)
+{
+    PropHandleSet* set = ghostToPropHandleSet(c, argc > 0 ? args[0] : naNil());
+    const int n = static_cast<int>(set->nodes.size());
+    naRef values = naNewVector(c);
+    naVec_setsize(c, values, n);
+    for(int i = 0; i < n; i++)
+        naVec_set(values, i, FGNasalSys::getPropertyValue(c, set->nodes[i]));
+    return values;
+}
+
+// Set the nodes of a handle set from a vector of values in the order of its
+// paths, like setValue(); nil leaves a node unchanged. Returns the number
+// of nodes set.
+// Forms:
+//    props._setHandleValues(handles, vector values);
+static naRef f_setHandleValues(naContext c, naRef me, int argc, naRef* args)
+{
+    PropHandleSet* set = ghostToPropHandleSet(c, argc > 0 ? args[0] : naNil());
+    naRef values = argc > 1 ? args[1] : naNil();
+    if(!naIsVector(values))
+        naRuntimeError(c, "props._setHandleValues() with non-vector values");
+
+    const int n = std::min(static_cast<int>(set->nodes.size()), naVec_size(values));
+    int count = 0;
+    for(int i = 0; i < n; i++) {
+        naRef val = naVec_get(values, i);
+        if(!set->nodes[i] || naIsNil(val))
+            continue;
+        if(naTrue(f_setValueHelper(c, set->nodes[i], val)))
+            count++;
+    }
+    return naNum(count);
+}
+
+
 // Create a new property node.
 // Forms:
 //    props.Node.new();
@@ -922,6 +1050,10 @@ static struct {
     { f_unalias,            "_unalias"            },
     { f_getAliasTarget,     "_getAliasTarget"     },
     { f_getNode,            "_getNode"            },
+    { f_getValues,          "_getValues"          },
+    { f_getHandles,         "_getHandles"         },
+    { f_getHandleValues,    "_getHandleValues"    },
+    { f_setHandleValues,    "_setHandleValues"    },
     { f_new,                "_new"                },
     { f_globals,            "_globals"            },
     { f_isNumeric,          "_isNumeric"          },
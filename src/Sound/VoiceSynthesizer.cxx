@@ -4,12 +4,18 @@
  * SPDX-FileCopyrightText: 2014 Torsten Dreyer
  */
 
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <sstream>
 #include <utility>
 
 #include "VoiceSynthesizer.hxx"
 #include <Main/globals.hxx>
 #include <Main/fg_props.hxx>
 #include <simgear/sg_inlines.h>
+#include <simgear/math/SGMisc.hxx>
+#include <simgear/misc/strutils.hxx>
 #include <simgear/debug/logstream.hxx>
 #include <simgear/misc/sg_path.hxx>
 #include <simgear/threads/SGThread.hxx>
@@ -18,6 +24,12 @@
 
 using std::string;
 
+// length of the crossfade between two phrases
+static const double PHRASE_CROSSFADE_SEC = 0.010;
+
+// the HTS voices we ship render at 48kHz, used to size the phrase cache
+static const int NOMINAL_SAMPLE_RATE = 48000;
+
 static const char * VOICE_FILES[] = {
   "cmu_us_arctic_slt.htsvoice",
   "cstr_uk_female-1.0.htsvoice"
@@ -26,39 +38,32 @@ static const char * VOICE_FILES[] = {
 class FLITEVoiceSynthesizer::WorkerThread : public SGThread
 {
 public:
-  WorkerThread(FLITEVoiceSynthesizer * synthesizer)
-      : _synthesizer(synthesizer)
+  WorkerThread(FLITEVoiceSynthesizer * synthesizer, const std::string & voice)
+      : _synthesizer(synthesizer), _engine(new Flite_HTS_Engine)
+  {
+    Flite_HTS_Engine_initialize(_engine);
+    Flite_HTS_Engine_load(_engine, voice.c_str());
+  }
+  ~WorkerThread()
   {
+    Flite_HTS_Engine_clear(_engine);
+    delete _engine;
   }
   virtual void run();
 private:
   FLITEVoiceSynthesizer * _synthesizer;
+  Flite_HTS_Engine * _engine;
 };
 
 void FLITEVoiceSynthesizer::WorkerThread::run()
 {
-  for (;;) {
-    SynthesizeRequest request = _synthesizer->_requests.pop();
-
-    // marker value indicating termination requested
-    if ((request.speed < 0.0) && (request.volume < 0.0)) {
-      SG_LOG(SG_SOUND, SG_DEBUG, "FLITE synthesis thread exiting");
-      return;
-    }
-
-    if ( NULL != request.listener) {
-      SGSharedPtr<SGSoundSample> sample = _synthesizer->synthesize(request.text, request.volume, request.speed, request.pitch);
-      request.listener->SoundSampleReady( sample );
-    }
+  SynthesizeRequest request;
+  while (_synthesizer->nextRequest(request)) {
+    SGSharedPtr<SGSoundSample> sample = _synthesizer->render(_engine, request.text, request.volume, request.speed, request.pitch);
+    request.listener->SoundSampleReady( sample );
+    _synthesizer->requestDone(request.listener);
   }
-}
-
-SynthesizeRequest SynthesizeRequest::cancelThreadRequest()
-{
-  SynthesizeRequest marker;
-  marker.volume = -999.0;
-  marker.speed = -999.0;
-  return marker;
+  SG_LOG(SG_SOUND, SG_DEBUG, "FLITE synthesis thread exiting");
 }
 
 string FLITEVoiceSynthesizer::getVoicePath( voice_t voice )
@@ -78,47 +83,278 @@ string FLITEVoiceSynthesizer::getVoicePath( const string & voice )
 
 void FLITEVoiceSynthesizer::synthesize( SynthesizeRequest & request)
 {
-  _requests.push(request);
+  if (NULL == request.listener) return;
+
+  {
+    std::lock_guard<std::mutex> g(_requestLock);
+    // a new request supersedes anything the listener still has queued
+    _requests.erase(std::remove_if(_requests.begin(), _requests.end(),
+        [&request](const SynthesizeRequest & r) { return r.listener == request.listener; }),
+        _requests.end());
+    _requests.push_back(request);
+    _requests.back().queued.stamp();
+  }
+  _requestCondition.notify_one();
+}
+
+void FLITEVoiceSynthesizer::cancel( SoundSampleReadyListener * listener, bool wait )
+{
+  std::unique_lock<std::mutex> g(_requestLock);
+  _requests.erase(std::remove_if(_requests.begin(), _requests.end(),
+      [listener](const SynthesizeRequest & r) { return r.listener == listener; }),
+      _requests.end());
+  if (!wait) return;
+
+  _requestCondition.wait(g, [this, listener]() {
+    return std::find(_inFlight.begin(), _inFlight.end(), listener) == _inFlight.end();
+  });
+}
+
+bool FLITEVoiceSynthesizer::nextRequest( SynthesizeRequest & request )
+{
+  std::unique_lock<std::mutex> g(_requestLock);
+  _requestCondition.wait(g, [this]() { return _shutdown || !_requests.empty(); });
+  if (_shutdown) return false;
+
+  // highest priority first, oldest first within the same priority
+  auto best = _requests.begin();
+  for (auto it = _requests.begin(); it != _requests.end(); ++it) {
+    if (it->priority > best->priority) best = it;
+  }
+
+  request = *best;
+  _requests.erase(best);
+  _inFlight.push_back(request.listener);
+
+  _lastLatencyMs = request.queued.elapsedMSec();
+  _maxLatencyMs = std::max(_maxLatencyMs, _lastLatencyMs);
+  return true;
+}
+
+void FLITEVoiceSynthesizer::requestDone( SoundSampleReadyListener * listener )
+{
+  {
+    std::lock_guard<std::mutex> g(_requestLock);
+    _inFlight.erase(std::find(_inFlight.begin(), _inFlight.end(), listener));
+  }
+  // wake up cancel() waiting for this listener
+  _requestCondition.notify_all();
+}
+
+VoiceSynthesizer::QueueStats FLITEVoiceSynthesizer::getQueueStats() const
+{
+  std::lock_guard<std::mutex> g(_requestLock);
+  QueueStats stats;
+  stats.queued = _requests.size();
+  stats.lastLatencyMs = _lastLatencyMs;
+  stats.maxLatencyMs = _maxLatencyMs;
+  return stats;
+}
+
+VoicePhraseCache::VoicePhraseCache( size_t maxSamples )
+    : _maxSamples(maxSamples)
+{
+}
+
+string VoicePhraseCache::makeKey( const string & phrase, double speed, double pitch )
+{
+  std::ostringstream os;
+  os << speed << '|' << pitch << '|' << phrase;
+  return os.str();
+}
+
+bool VoicePhraseCache::get( const string & key, Entry & entry )
+{
+  std::lock_guard<std::mutex> g(_lock);
+  auto it = _index.find(key);
+  if (it == _index.end()) {
+    ++_misses;
+    return false;
+  }
+
+  // move to the front of the LRU list
+  _entries.splice(_entries.begin(), _entries, it->second);
+  entry = it->second->second;
+  ++_hits;
+  return true;
+}
+
+void VoicePhraseCache::put( const string & key, const Entry & entry )
+{
+  if (entry.pcm.size() > _maxSamples) return;
+
+  std::lock_guard<std::mutex> g(_lock);
+  auto it = _index.find(key);
+  if (it != _index.end()) {
+    _numSamples -= it->second->second.pcm.size();
+    _entries.erase(it->second);
+    _index.erase(it);
+  }
+
+  _entries.emplace_front(key, entry);
+  _index[key] = _entries.begin();
+  _numSamples += entry.pcm.size();
+  evict();
+}
+
+void VoicePhraseCache::clear()
+{
+  std::lock_guard<std::mutex> g(_lock);
+  _entries.clear();
+  _index.clear();
+  _numSamples = 0;
+}
+
+void VoicePhraseCache::evict()
+{
+  while (_numSamples > _maxSamples && !_entries.empty()) {
+    const auto & last = _entries.back();
+    _numSamples -= last.second.pcm.size();
+    _index.erase(last.first);
+    _entries.pop_back();
+  }
+}
+
+std::vector<string> FLITEVoiceSynthesizer::splitPhrases( const string & text )
+{
+  std::vector<string> phrases;
+  string current;
+
+  auto flush = [&phrases, &current]() {
+    string p = simgear::strutils::strip(current);
+    if (!p.empty()) phrases.push_back(p);
+    current.clear();
+  };
+
+  for (size_t i = 0; i < text.size(); ++i) {
+    const char c = text[i];
+    current.push_back(c);
+    if (strchr(".,;:!?", c) == NULL) continue;
+    // don't split decimal numbers and abbreviations like "1.5" or "I.L.S"
+    if (i + 1 < text.size() && !isspace(static_cast<unsigned char>(text[i + 1]))) continue;
+    flush();
+  }
+  flush();
+  return phrases;
+}
+
+void FLITEVoiceSynthesizer::appendWithCrossfade( std::vector<short> & buffer, const std::vector<short> & segment, size_t crossfadeSamples )
+{
+  const size_t n = std::min(crossfadeSamples, std::min(buffer.size(), segment.size()));
+  const size_t start = buffer.size() - n;
+
+  for (size_t i = 0; i < n; ++i) {
+    // linear crossfade, fading the buffer tail out and the segment in
+    const double w = (i + 0.5) / n;
+    const double v = (1.0 - w) * buffer[start + i] + w * segment[i];
+    buffer[start + i] = static_cast<short>(SGMiscd::clip(v, -32768.0, 32767.0));
+  }
+  buffer.insert(buffer.end(), segment.begin() + n, segment.end());
 }
 
 FLITEVoiceSynthesizer::FLITEVoiceSynthesizer(const std::string & voice)
     // REVIEW: Memory Leak - 1,696 bytes in 4 blocks are definitely lost in loss record 6,145 of 6,440
-    : _engine(new Flite_HTS_Engine), _worker(new FLITEVoiceSynthesizer::WorkerThread(this)), _volume(6.0)
+    : _engine(new Flite_HTS_Engine),
+      _phraseCache(static_cast<size_t>(NOMINAL_SAMPLE_RATE *
+          fgGetDouble("/sim/sound/voice-synthesizer/phrase-cache-seconds", 120.0))),
+      _usePhraseCache(fgGetBool("/sim/sound/voice-synthesizer/phrase-cache", true)),
+      _volume(6.0)
 {
   _volume = fgGetDouble("/sim/sound/voice-synthesizer/volume", _volume );
   Flite_HTS_Engine_initialize(_engine);
   Flite_HTS_Engine_load(_engine, voice.c_str());
-  _worker->start();
+
+  // every worker loads its own copy of the voice, keep the pool small
+  int numWorkers = fgGetInt("/sim/sound/voice-synthesizer/worker-threads", 2);
+  SG_CLAMP_RANGE( numWorkers, 1, 8 );
+  for (int i = 0; i < numWorkers; ++i) {
+    _workers.push_back(new FLITEVoiceSynthesizer::WorkerThread(this, voice));
+    _workers.back()->start();
+  }
 }
 
 FLITEVoiceSynthesizer::~FLITEVoiceSynthesizer()
 {
-  // push the special marker value
-  _requests.push(SynthesizeRequest::cancelThreadRequest());
-  _worker->join();
+  {
+    std::lock_guard<std::mutex> g(_requestLock);
+    _shutdown = true;
+  }
+  _requestCondition.notify_all();
+
+  for (auto worker : _workers) {
+    worker->join();
+    delete worker;
+  }
   Flite_HTS_Engine_clear(_engine);
+
+  SG_LOG(SG_SOUND, SG_DEBUG, "FLITE phrase cache: " << _phraseCache.getHits() << " hits, "
+      << _phraseCache.getMisses() << " misses");
+}
+
+bool FLITEVoiceSynthesizer::synthesizePhrase( Flite_HTS_Engine * engine, const std::string & phrase, double speed, double pitch, VoicePhraseCache::Entry & entry )
+{
+  HTS_Engine_set_volume( &engine->engine, _volume );
+  HTS_Engine_set_speed( &engine->engine, 0.8 + 0.4 * speed );
+  HTS_Engine_add_half_tone(&engine->engine, -4.0 + 8.0 * pitch );
+
+  void* data;
+  int rate, count;
+  if ( FALSE == Flite_HTS_Engine_synthesize_samples_mono16(engine, phrase.c_str(), &data, &count, &rate)) return false;
+
+  auto buf = std::unique_ptr<short, decltype(free)*>{
+    reinterpret_cast<short*>( data ),
+    free
+  };
+  entry.pcm.assign(buf.get(), buf.get() + count);
+  entry.rate = rate;
+  return true;
 }
 
 SGSoundSample * FLITEVoiceSynthesizer::synthesize(const std::string & text, double volume, double speed, double pitch )
+{
+  std::lock_guard<std::mutex> g(_engineLock);
+  return render(_engine, text, volume, speed, pitch);
+}
+
+SGSoundSample * FLITEVoiceSynthesizer::render( Flite_HTS_Engine * engine, const std::string & text, double volume, double speed, double pitch )
 {
   SG_CLAMP_RANGE( volume, 0.0, 1.0 );
   SG_CLAMP_RANGE( speed, 0.0, 10.0 );
   SG_CLAMP_RANGE( pitch, 0.0, 10.0 );
-  HTS_Engine_set_volume( &_engine->engine, _volume );
-  HTS_Engine_set_speed( &_engine->engine, 0.8 + 0.4 * speed );
-  HTS_Engine_add_half_tone(&_engine->engine, -4.0 + 8.0 * pitch );
 
+  std::vector<string> phrases;
+  if (_usePhraseCache) {
+    phrases = splitPhrases(text);
+  } else {
+    phrases.push_back(text);
+  }
 
-  void* data;
-  int rate, count;
-  if ( FALSE == Flite_HTS_Engine_synthesize_samples_mono16(_engine, text.c_str(), &data, &count, &rate)) return NULL;
+  std::vector<short> pcm;
+  int rate = 0;
+  for (const auto & phrase : phrases) {
+    VoicePhraseCache::Entry entry;
+    const string key = VoicePhraseCache::makeKey(phrase, speed, pitch);
+    if (!_usePhraseCache || !_phraseCache.get(key, entry)) {
+      if (!synthesizePhrase(engine, phrase, speed, pitch, entry)) continue;
+      if (_usePhraseCache) _phraseCache.put(key, entry);
+    }
+
+    if (rate == 0) rate = entry.rate;
+    appendWithCrossfade(pcm, entry.pcm, static_cast<size_t>(PHRASE_CROSSFADE_SEC * rate));
+  }
+
+  if (pcm.empty()) return NULL;
 
+  const size_t size = pcm.size() * sizeof(short);
   auto buf = std::unique_ptr<unsigned char, decltype(free)*>{
-    reinterpret_cast<unsigned char*>( data ),
+    reinterpret_cast<unsigned char*>( malloc(size) ),
     free
   };
+  if (!buf) return NULL;
+  memcpy(buf.get(), pcm.data(), size);
+
   return new SGSoundSample(std::move(buf),
-                           count * sizeof(short),
+                           size,
                            rate,
                            SG_SAMPLE_MONO16);
 }
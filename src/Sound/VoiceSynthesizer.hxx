@@ -9,8 +9,16 @@
 
 #include <simgear/sound/sample.hxx>
 #include <simgear/threads/SGQueue.hxx>
+#include <simgear/timing/timestamp.hxx>
 
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
+
 struct _Flite_HTS_Engine;
 
 /**
@@ -18,8 +26,15 @@ struct _Flite_HTS_Engine;
  */
 class VoiceSynthesizer {
 public:
+  struct QueueStats {
+    size_t queued = 0;          // requests waiting for a worker
+    double lastLatencyMs = 0.0; // queue wait of the last started request
+    double maxLatencyMs = 0.0;  // worst queue wait seen so far
+  };
+
   virtual ~VoiceSynthesizer() {};
   virtual SGSoundSample * synthesize( const std::string & text, double volume, double speed, double pitch ) = 0;
+  virtual QueueStats getQueueStats() const { return QueueStats(); }
 };
 
 class SoundSampleReadyListener {
@@ -29,10 +44,16 @@ public:
 };
 
 struct SynthesizeRequest {
+  enum {
+    PRIORITY_BACKGROUND = 0,
+    PRIORITY_TUNED = 10 // the station is currently heard on a tuned radio
+  };
+
   SynthesizeRequest() {
     speed = 0.5;
     volume = 1.0;
     pitch = 0.5;
+    priority = PRIORITY_BACKGROUND;
     listener = NULL;
   }
   SynthesizeRequest( const SynthesizeRequest & other ) {
@@ -40,7 +61,9 @@ struct SynthesizeRequest {
     speed = other.speed;
     volume = other.volume;
     pitch = other.pitch;
+    priority = other.priority;
     listener = other.listener;
+    queued = other.queued;
   }
 
   SynthesizeRequest & operator = ( const SynthesizeRequest & other ) {
@@ -48,23 +71,69 @@ struct SynthesizeRequest {
     speed = other.speed;
     volume = other.volume;
     pitch = other.pitch;
+    priority = other.priority;
     listener = other.listener;
+    queued = other.queued;
     return *this;
   }
 
-  // return a special marker request used to indicate the synthesis thread
-  // should be exited.
-  static SynthesizeRequest cancelThreadRequest();
-
   std::string text;
   double speed;
   double volume;
   double pitch;
+  int priority;
   SoundSampleReadyListener * listener;
+  SGTimeStamp queued; // set when the request enters the queue
+};
+
+/**
+ * A bounded, least-recently-used cache of synthesized 16 bit mono PCM,
+ * keyed by phrase and synthesis parameters. Thread safe.
+ */
+class VoicePhraseCache {
+public:
+  struct Entry {
+    std::vector<short> pcm;
+    int rate = 0;
+  };
+
+  explicit VoicePhraseCache( size_t maxSamples );
+
+  static std::string makeKey( const std::string & phrase, double speed, double pitch );
+
+  bool get( const std::string & key, Entry & entry );
+  void put( const std::string & key, const Entry & entry );
+  void clear();
+
+  size_t getHits() const { return _hits; }
+  size_t getMisses() const { return _misses; }
+  size_t getNumSamples() const { return _numSamples; }
+
+private:
+  typedef std::list<std::pair<std::string, Entry> > EntryList;
+
+  void evict();
+
+  mutable std::mutex _lock;
+  EntryList _entries; // most recently used first
+  std::unordered_map<std::string, EntryList::iterator> _index;
+  size_t _maxSamples;
+  size_t _numSamples = 0;
+  size_t _hits = 0;
+  size_t _misses = 0;
 };
 
 /**
  * A Voice Synthesizer using FLITE+HTS
+ *
+ * Asynchronous requests are served by a small pool of worker threads, each
+ * owning its own engine. Higher priority requests are served first and a
+ * new request from a listener supersedes the ones it still has queued.
+ *
+ * Text is split into phrases at punctuation, every phrase is rendered
+ * (or taken from the phrase cache) on its own and the segments are joined
+ * with a short crossfade. Re-announcing a slightly changed text, like an
+ * ATIS after a METAR update, only renders the phrases that changed.
  */
 class FLITEVoiceSynthesizer : public VoiceSynthesizer {
 public:
@@ -82,16 +151,57 @@ public:
   FLITEVoiceSynthesizer( const std::string & voice );
   ~FLITEVoiceSynthesizer();
   virtual SGSoundSample * synthesize( const std::string & text, double volume, double speed, double pitch  );
+  virtual QueueStats getQueueStats() const;
 
+  /**
+   * Queue a request for asynchronous synthesis. Requests of the same
+   * listener still waiting in the queue are dropped.
+   */
   virtual void synthesize( SynthesizeRequest & request );
+
+  /**
+   * Drop all queued requests of the listener. With wait set, also block
+   * until a request of it currently being synthesized has been delivered;
+   * this must be done before a listener is destroyed.
+   */
+  void cancel( SoundSampleReadyListener * listener, bool wait = true );
+
+  /**
+   * Split text into the phrases used as cache keys. Splits after
+   * sentence and clause punctuation followed by whitespace.
+   */
+  static std::vector<std::string> splitPhrases( const std::string & text );
+
+  /**
+   * Append a segment to a sample buffer, blending the first
+   * crossfadeSamples of the segment into the tail of the buffer.
+   */
+  static void appendWithCrossfade( std::vector<short> & buffer, const std::vector<short> & segment, size_t crossfadeSamples );
+
 private:
-  struct _Flite_HTS_Engine * _engine;
+  SGSoundSample * render( struct _Flite_HTS_Engine * engine, const std::string & text, double volume, double speed, double pitch );
+  bool synthesizePhrase( struct _Flite_HTS_Engine * engine, const std::string & phrase, double speed, double pitch, VoicePhraseCache::Entry & entry );
+
+  /// blocks until a request is available, returns false on shutdown
+  bool nextRequest( SynthesizeRequest & request );
+  void requestDone( SoundSampleReadyListener * listener );
+
+  struct _Flite_HTS_Engine * _engine; // used by the synchronous interface
+  std::mutex _engineLock;
+  VoicePhraseCache _phraseCache;
+  bool _usePhraseCache;
 
   class WorkerThread;
-  WorkerThread * _worker;
+  std::vector<WorkerThread *> _workers;
+
+  mutable std::mutex _requestLock;
+  std::condition_variable _requestCondition;
+  std::deque<SynthesizeRequest> _requests;
+  std::vector<SoundSampleReadyListener *> _inFlight;
+  bool _shutdown = false;
 
-  typedef SGBlockingQueue<SynthesizeRequest> SynthesizeRequestList;
-  SynthesizeRequestList _requests;
+  double _lastLatencyMs = 0.0; // guarded by _requestLock
+  double _maxLatencyMs = 0.0;
 
   double _volume;
 };
@@ -19,6 +19,7 @@
 
 #include <stdio.h>
 
+#include <algorithm>
 #include <vector>
 #include <string>
 
@@ -66,6 +67,10 @@ void FGSoundManager::init()
 
     _frozen = fgGetNode("sim/freeze/master");
 
+    _synthQueueLength     = fgGetNode("/sim/sound/voice-synthesizer/queue-length", true);
+    _synthQueueLatency    = fgGetNode("/sim/sound/voice-synthesizer/queue-latency-ms", true);
+    _synthMaxQueueLatency = fgGetNode("/sim/sound/voice-synthesizer/max-queue-latency-ms", true);
+
     SGPropertyNode_ptr scenery_loaded = fgGetNode("sim/sceneryloaded", true);
     scenery_loaded->addChangeListener(_listener.get());
 
@@ -185,6 +190,29 @@ void FGSoundManager::update(double dt)
             SGSoundMgr::update(dt);
         }
     }
+
+    updateSynthesizerStats();
+}
+
+// Publish the request queue state of all voice synthesizers, summed
+// (queue length) or worst case (latency) over all voices.
+void FGSoundManager::updateSynthesizerStats()
+{
+    if (_synthesizers.empty() || !_synthQueueLength)
+        return;
+
+    size_t queued = 0;
+    double latency = 0.0, maxLatency = 0.0;
+    for (const auto& it : _synthesizers) {
+        const VoiceSynthesizer::QueueStats stats = it.second->getQueueStats();
+        queued += stats.queued;
+        latency = std::max(latency, stats.lastLatencyMs);
+        maxLatency = std::max(maxLatency, stats.maxLatencyMs);
+    }
+
+    _synthQueueLength->setIntValue(static_cast<int>(queued));
+    _synthQueueLatency->setDoubleValue(latency);
+    _synthMaxQueueLatency->setDoubleValue(maxLatency);
 }
 
 /**
@@ -42,6 +42,7 @@ private:
     bool stationaryView() const;
 
     bool playAudioSampleCommand(const SGPropertyNode * arg, SGPropertyNode * root);
+    void updateSynthesizerStats();
 
     std::map<std::string,SGSharedPtr<FGSampleQueue>> _queue;
 
@@ -51,6 +52,7 @@ private:
     SGPropertyNode_ptr _velocityNorthFPS, _velocityEastFPS, _velocityDownFPS;
     SGPropertyNode_ptr _frozen;
     std::unique_ptr<Listener> _listener;
+    SGPropertyNode_ptr _synthQueueLength, _synthQueueLatency, _synthMaxQueueLatency;
 
     std::map<std::string,VoiceSynthesizer*> _synthesizers;
 };
@@ -26,7 +26,8 @@ FGElectricalComponent::FGElectricalComponent() :
     kind(-1),
     name(""),
     volts(0.0),
-    load_amps(0.0)
+    load_amps(0.0),
+    available_amps(0.0)
 {
 }
 
@@ -36,9 +37,8 @@ void FGElectricalComponent::add_prop(const std::string &s)
     props.push_back(n);
 }
 
-void FGElectricalComponent::publishVoltageToProps() const
+void FGElectricalComponent::publishVoltageToProps(float v) const
 {
-    const auto v = get_volts();
     for (const auto& n : props) {
         n->setFloatValue(v);
     }
@@ -437,6 +437,9 @@ void FGElectricalSystem::shutdown()
     deleteComponents(buses);
     deleteComponents(outputs);
     deleteComponents(connectors);
+
+    _byName.clear();
+    compile();
 }
 
 void FGElectricalSystem::update (double dt)
@@ -448,81 +451,28 @@ void FGElectricalSystem::update (double dt)
     // cout << "Updating electrical system, dt = " << dt << endl;
     _serviceable = _serviceable_node->getBoolValue();
 
-    unsigned int i;
-
     // zero out the voltage before we start, but don't clear the
     // requested load values.
-    for ( i = 0; i < suppliers.size(); ++i ) {
-        suppliers[i]->set_volts( 0.0 );
-    }
-    for ( i = 0; i < buses.size(); ++i ) {
-        buses[i]->set_volts( 0.0 );
-    }
-    for ( i = 0; i < outputs.size(); ++i ) {
-        outputs[i]->set_volts( 0.0 );
-    }
-    for ( i = 0; i < connectors.size(); ++i ) {
-        connectors[i]->set_volts( 0.0 );
-    }
-
-    // for each "external" supplier, propagate the electrical current
-    for ( i = 0; i < suppliers.size(); ++i ) {
-        FGElectricalSupplier *node = (FGElectricalSupplier *)suppliers[i];
-        if ( node->get_model() == FGElectricalSupplier::FG_EXTERNAL ) {
-            float load;
-            // cout << "Starting propagation: " << suppliers[i]->get_name()
-            //      << endl;
-            load = propagate( suppliers[i], dt,
-                              node->get_output_volts(),
-                              node->get_output_amps(),
-                              " " );
-
-            if ( node->apply_load( load, dt ) < 0.0 ) {
-                SG_LOG(SG_SYSTEMS, SG_ALERT,
-                       "Error drawing more current than available!");
-            }
-        }
-    }
-
-    // for each "alternator" supplier, propagate the electrical
-    // current
-    for ( i = 0; i < suppliers.size(); ++i ) {
-        FGElectricalSupplier *node = (FGElectricalSupplier *)suppliers[i];
-        if ( node->get_model() == FGElectricalSupplier::FG_ALTERNATOR) {
-            float load;
-            // cout << "Starting propagation: " << suppliers[i]->get_name()
-            //      << endl;
-            load = propagate( suppliers[i], dt,
-                              node->get_output_volts(),
-                              node->get_output_amps(),
-                              " " );
-
-            if ( node->apply_load( load, dt ) < 0.0 ) {
-                SG_LOG(SG_SYSTEMS, SG_ALERT,
-                       "Error drawing more current than available!");
-            }
+    std::fill(_volts.begin(), _volts.end(), 0.0f);
+
+    // propagate the electrical current from each supplier: first the
+    // "external" ones, then the alternators, then the batteries
+    for (unsigned int r : _roots) {
+        FGElectricalSupplier *node = (FGElectricalSupplier *)_comps[r];
+        float load = propagate( r, dt,
+                                node->get_output_volts(),
+                                node->get_output_amps() );
+
+        if ( node->apply_load( load, dt ) < 0.0 ) {
+            SG_LOG(SG_SYSTEMS, SG_ALERT,
+                   "Error drawing more current than available!");
         }
     }
 
-    // for each "battery" supplier, propagate the electrical
-    // current
-    for ( i = 0; i < suppliers.size(); ++i ) {
-        FGElectricalSupplier *node = (FGElectricalSupplier *)suppliers[i];
-        if ( node->get_model() == FGElectricalSupplier::FG_BATTERY ) {
-            float load;
-            // cout << "Starting propagation: " << suppliers[i]->get_name()
-            //      << endl;
-            load = propagate( suppliers[i], dt,
-                              node->get_output_volts(),
-                              node->get_output_amps(),
-                              " " );
-            // cout << "battery load = " << load << endl;
-
-            if ( node->apply_load( load, dt ) < 0.0 ) {
-                SG_LOG(SG_SYSTEMS, SG_ALERT,
-                       "Error drawing more current than available!");
-            }
-        }
+    for (unsigned int i = 0; i < _comps.size(); ++i) {
+        _comps[i]->set_volts( _volts[i] );
+        _comps[i]->set_load_amps( _loadAmps[i] );
+        _comps[i]->set_available_amps( _availableAmps[i] );
     }
 
     float alt_norm
@@ -588,19 +538,19 @@ bool FGElectricalSystem::build (SGPropertyNode* config_props) {
         if ( name == "supplier" ) {
             FGElectricalSupplier *s =
                 new FGElectricalSupplier( node );
-            suppliers.push_back( s );
+            addComponent( suppliers, s );
         } else if ( name == "bus" ) {
             FGElectricalBus *b =
                 new FGElectricalBus( node );
-            buses.push_back( b );
+            addComponent( buses, b );
         } else if ( name == "output" ) {
             FGElectricalOutput *o =
                 new FGElectricalOutput( node );
-            outputs.push_back( o );
+            addComponent( outputs, o );
         } else if ( name == "connector" ) {
             FGElectricalConnector *c =
                 new FGElectricalConnector( node, this );
-            connectors.push_back( c );
+            addComponent( connectors, c );
         } else {
             SG_LOG( SG_SYSTEMS, SG_ALERT, "Unknown component type specified: "
                     << name );
@@ -608,139 +558,183 @@ bool FGElectricalSystem::build (SGPropertyNode* config_props) {
         }
     }
 
+    compile();
     return true;
 }
 
 
-// propagate the electrical current through the network, returns the
-// total current drawn by the children of this node.
-float FGElectricalSystem::propagate( FGElectricalComponent *node, double dt,
-                                     float input_volts, float input_amps,
-                                     std::string s ) {
-    s += " ";
+void FGElectricalSystem::addComponent( comp_list& comps,
+                                       FGElectricalComponent *c )
+{
+    comps.push_back( c );
+    if ( c->get_kind() == FGElectricalComponent::FG_CONNECTOR ) {
+        return;
+    }
 
-    float total_load = 0.0;
+    // if a name is used twice, find() returns the first supplier, then
+    // the first bus, then the first output of that name
+    auto it = _byName.find( c->get_name() );
+    if ( it == _byName.end() || c->get_kind() < it->second->get_kind() ) {
+        _byName[c->get_name()] = c;
+    }
+}
 
-    // determine the current to carry forward
-    float volts = 0.0;
-    if ( !_serviceable) {
-        volts = 0;
-    } else if ( node->get_kind() == FGElectricalComponent::FG_SUPPLIER ) {
-        // cout << s << "is a supplier (" << node->get_name() << ")" << endl;
-        FGElectricalSupplier *supplier = (FGElectricalSupplier *)node;
-        if ( supplier->get_model() == FGElectricalSupplier::FG_BATTERY ) {
-            // cout << s << " (and is a battery)" << endl;
-            float battery_volts = supplier->get_output_volts();
-            if ( battery_volts < (input_volts - 0.1) ) {
-                // special handling of a battery charge condition
-                // cout << s << "  (and is being charged) in v = "
-                //      << input_volts << " current v = " << battery_volts
-                //      << endl;
-                supplier->apply_load( -supplier->get_charge_amps(), dt );
-                return supplier->get_charge_amps();
+
+// Flatten the component graph into index arrays, so that the per frame
+// propagation doesn't chase pointers through the component objects.
+void FGElectricalSystem::compile()
+{
+    _comps.clear();
+    for (const comp_list* l : {&suppliers, &buses, &outputs, &connectors}) {
+        _comps.insert(_comps.end(), l->begin(), l->end());
+    }
+
+    const unsigned int n = _comps.size();
+    std::unordered_map<const FGElectricalComponent*, unsigned int> index;
+    for (unsigned int i = 0; i < n; ++i) {
+        index[_comps[i]] = i;
+    }
+
+    _kind.resize(n);
+    _firstEdge.clear();
+    _edges.clear();
+    for (unsigned int i = 0; i < n; ++i) {
+        FGElectricalComponent *c = _comps[i];
+        _kind[i] = c->get_kind();
+        _firstEdge.push_back(_edges.size());
+        for (int j = 0; j < c->get_num_outputs(); ++j) {
+            auto it = index.find(c->get_output(j));
+            if (it != index.end()) {
+                _edges.push_back(it->second);
             }
         }
-        volts = input_volts;
-    } else if ( node->get_kind() == FGElectricalComponent::FG_BUS ) {
-        // cout << s << "is a bus (" << node->get_name() << ")" << endl;
-        volts = input_volts;
-    } else if ( node->get_kind() == FGElectricalComponent::FG_OUTPUT ) {
-        // cout << s << "is an output (" << node->get_name() << ")" << endl;
-        volts = input_volts;
-        if ( volts > 1.0 ) {
-            // draw current if we have voltage
-            total_load = node->get_load_amps();
-        }
-    } else if ( node->get_kind() == FGElectricalComponent::FG_CONNECTOR ) {
-        // cout << s << "is a connector (" << node->get_name() << ")" << endl;
-        if ( ((FGElectricalConnector *)node)->get_state() ) {
-            volts = input_volts;
-        } else {
-            volts = 0.0;
-        }
-        // cout << s << "  input_volts = " << volts << endl;
-    } else {
-        SG_LOG( SG_SYSTEMS, SG_ALERT, "unknown node type" );
     }
+    _firstEdge.push_back(_edges.size());
 
-    int i;
+    _volts.assign(n, 0.0f);
+    _loadAmps.resize(n);
+    for (unsigned int i = 0; i < n; ++i) {
+        _loadAmps[i] = _comps[i]->get_load_amps();
+    }
+    _availableAmps.assign(n, 0.0f);
 
-    // if this node has found a stronger power source, update the
-    // value and propagate to all children
-    if ( volts > node->get_volts() ) {
-        node->set_volts( volts );
-        for ( i = 0; i < node->get_num_outputs(); ++i ) {
-            FGElectricalComponent *child = node->get_output(i);
-            // send current equal to load
-            total_load += propagate( child, dt,
-                                     volts, child->get_load_amps(),
-                                     s );
+    _roots.clear();
+    for (auto model : {FGElectricalSupplier::FG_EXTERNAL,
+                       FGElectricalSupplier::FG_ALTERNATOR,
+                       FGElectricalSupplier::FG_BATTERY}) {
+        for (unsigned int i = 0; i < suppliers.size(); ++i) {
+            if (((FGElectricalSupplier *)suppliers[i])->get_model() == model) {
+                _roots.push_back(i);
+            }
         }
+    }
 
-        // if not an output node, register the downstream current draw
-        // (sum of all children) with this node.  If volts are zero,
-        // current draw should be zero.
-        if ( node->get_kind() != FGElectricalComponent::FG_OUTPUT ) {
-            node->set_load_amps( total_load );
-        }
+    // a component is only entered again with a higher voltage than it
+    // has, which its own subtree can't provide, so the stack never holds
+    // more than one frame per component
+    _stack.clear();
+    _stack.reserve(n + 1);
+}
 
-        node->set_available_amps( input_amps - total_load );
 
-        node->publishVoltageToProps();
+// propagate the electrical current through the network, returns the
+// total current drawn by the children of the root node.  This is a
+// depth first walk over the compiled network with an explicit stack,
+// in the same order the components were visited recursively before.
+float FGElectricalSystem::propagate( unsigned int root, double dt,
+                                     float input_volts, float input_amps ) {
+    // Enter component n: returns true if it found a stronger power
+    // source and its frame was pushed, otherwise load is what it draws.
+    auto enter = [&]( unsigned int n, float in_volts, float in_amps,
+                      float& load ) {
+        load = 0.0;
+
+        // determine the current to carry forward
+        float volts = 0.0;
+        float total_load = 0.0;
+        if ( !_serviceable ) {
+            volts = 0;
+        } else if ( _kind[n] == FGElectricalComponent::FG_SUPPLIER ) {
+            FGElectricalSupplier *supplier = (FGElectricalSupplier *)_comps[n];
+            if ( supplier->get_model() == FGElectricalSupplier::FG_BATTERY ) {
+                float battery_volts = supplier->get_output_volts();
+                if ( battery_volts < (in_volts - 0.1) ) {
+                    // special handling of a battery charge condition
+                    supplier->apply_load( -supplier->get_charge_amps(), dt );
+                    load = supplier->get_charge_amps();
+                    return false;
+                }
+            }
+            volts = in_volts;
+        } else if ( _kind[n] == FGElectricalComponent::FG_BUS ) {
+            volts = in_volts;
+        } else if ( _kind[n] == FGElectricalComponent::FG_OUTPUT ) {
+            volts = in_volts;
+            if ( volts > 1.0 ) {
+                // draw current if we have voltage
+                total_load = _loadAmps[n];
+            }
+        } else if ( _kind[n] == FGElectricalComponent::FG_CONNECTOR ) {
+            if ( ((FGElectricalConnector *)_comps[n])->get_state() ) {
+                volts = in_volts;
+            } else {
+                volts = 0.0;
+            }
+        } else {
+            SG_LOG( SG_SYSTEMS, SG_ALERT, "unknown node type" );
+        }
 
-        /*
-        cout << s << node->get_name() << " -> (volts) " << node->get_volts()
-             << endl;
-        cout << s << node->get_name() << " -> (load amps) " << total_load
-             << endl;
-        cout << s << node->get_name() << " -> (input amps) " << input_amps
-             << endl;
-        cout << s << node->get_name() << " -> (extra amps) "
-             << node->get_available_amps() << endl;
-        */
+        // if this node has found a stronger power source, update the
+        // value and propagate to all children
+        if ( !(volts > _volts[n]) ) {
+            return false;
+        }
 
-        return total_load;
-    } else {
-        // cout << s << "no further propagation" << endl;
-        return 0.0;
-    }
-}
+        _volts[n] = volts;
+        _stack.push_back( {n, _firstEdge[n], volts, in_amps, total_load} );
+        return true;
+    };
 
+    float load;
+    if ( !enter( root, input_volts, input_amps, load ) ) {
+        return load;
+    }
 
-// search for the named component and return a pointer to it, NULL otherwise
-FGElectricalComponent *FGElectricalSystem::find ( const std::string &name ) {
-    unsigned int i;
-    std::string s;
-
-    // search suppliers
-    for ( i = 0; i < suppliers.size(); ++i ) {
-        s = suppliers[i]->get_name();
-        // cout <<  "    " << s << endl;
-        if ( s == name ) {
-            return suppliers[i];
+    while ( true ) {
+        Frame& f = _stack.back();
+        if ( f.edge < _firstEdge[f.node + 1] ) {
+            const unsigned int child = _edges[f.edge++];
+            // send current equal to load
+            if ( !enter( child, f.volts, _loadAmps[child], load ) ) {
+                f.total_load += load;
+            }
+            continue;
         }
-    }
 
-    // then search buses
-    for ( i = 0; i < buses.size(); ++i ) {
-        s = buses[i]->get_name();
-        // cout <<  "    " << s << endl;
-        if ( s == name ) {
-            return buses[i];
+        // all children done: if not an output node, register the
+        // downstream current draw (sum of all children) with this node.
+        const unsigned int n = f.node;
+        if ( _kind[n] != FGElectricalComponent::FG_OUTPUT ) {
+            _loadAmps[n] = f.total_load;
         }
-    }
+        _availableAmps[n] = f.input_amps - f.total_load;
 
-    // then search outputs
-    for ( i = 0; i < outputs.size(); ++i ) {
-        s = outputs[i]->get_name();
-        // cout <<  "    " << s << endl;
-        if ( s == name ) {
-            return outputs[i];
+        _comps[n]->publishVoltageToProps( _volts[n] );
+
+        load = f.total_load;
+        _stack.pop_back();
+        if ( _stack.empty() ) {
+            return load;
         }
+        _stack.back().total_load += load;
     }
+}
 
-    // nothing found
-    return NULL;
+
+// search for the named component and return a pointer to it, NULL otherwise
+FGElectricalComponent *FGElectricalSystem::find ( const std::string &name ) {
+    auto it = _byName.find( name );
+    return it == _byName.end() ? nullptr : it->second;
 }
 
 
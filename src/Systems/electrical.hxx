@@ -8,6 +8,7 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <simgear/props/props.hxx>
@@ -85,7 +86,7 @@ public:
 
     void add_prop(const std::string& s);
 
-    void publishVoltageToProps() const;
+    void publishVoltageToProps(float v) const;
 };
 
 
@@ -216,9 +217,6 @@ public:
     static const char* staticSubsystemClassId() { return "electrical"; }
 
     bool build(SGPropertyNode* config_props);
-    float propagate(FGElectricalComponent* node, double dt,
-                    float input_volts, float input_amps,
-                    std::string s = "");
     FGElectricalComponent* find(const std::string& name);
 
 protected:
@@ -226,6 +224,12 @@ protected:
 
 private:
     void deleteComponents(comp_list& comps);
+    void addComponent(comp_list& comps, FGElectricalComponent* c);
+
+    // flatten the component graph into the arrays below
+    void compile();
+    float propagate(unsigned int root, double dt,
+                    float input_volts, float input_amps);
 
     std::string name;
     int num;
@@ -238,6 +242,32 @@ private:
     comp_list outputs;
     comp_list connectors;
 
+    // suppliers, buses and outputs by name, for find()
+    std::unordered_map<std::string, FGElectricalComponent*> _byName;
+
+    // The compiled network: components are numbered in the order suppliers,
+    // buses, outputs, connectors, and the outputs of component i are
+    // _edges[_firstEdge[i]] .. _edges[_firstEdge[i + 1] - 1].
+    std::vector<FGElectricalComponent*> _comps;
+    std::vector<int> _kind;
+    std::vector<unsigned int> _firstEdge;
+    std::vector<unsigned int> _edges;
+    std::vector<float> _volts;
+    std::vector<float> _loadAmps;
+    std::vector<float> _availableAmps;
+    // suppliers in propagation order: external, alternators, batteries
+    std::vector<unsigned int> _roots;
+
+    // explicit stack of the depth first propagation
+    struct Frame {
+        unsigned int node;
+        unsigned int edge;
+        float volts;
+        float input_amps;
+        float total_load;
+    };
+    std::vector<Frame> _stack;
+
     SGPropertyNode_ptr _volts_out;
     SGPropertyNode_ptr _amps_out;
     SGPropertyNode_ptr _serviceable_node;
@@ -289,10 +289,25 @@ bool FGAISchedule::update(time_t now, const SGVec3d& userCart)
     if (remainingWaitTime < 600) {
         SG_LOG(SG_AI, SG_BULK, "Traffic manager: " << registration << " is scheduled for a flight from " << dep->getId() << " to " << arr->getId() << ". Current distance to user: " << distanceToUser);
     }
-    if (distanceToUser >= TRAFFIC_TO_AI_DIST_TO_START) {
+    if (distanceToUser >= TRAFFIC_TO_AI_DIST_TO_DIE) {
         return true; // out of visual range, for the moment.
     }
 
+    // Load the ground networks the new aircraft's first legs will use in the
+    // background while the flight closes in, and defer creating the aircraft
+    // until they are ready, rather than parsing them on the main thread in
+    // createAIAircraft(). The legs are picked as in
+    // FGAIFlightPlan::createWaypoints(): still on the ground at the departure
+    // airport, or already on the approach to the arrival airport. An aircraft
+    // created in between prefetches its arrival network on the way.
+    const bool depNeeded = (now - deptime) < 600;
+    const bool arrNeeded = remainingTimeEnroute <= 2000;
+    const bool depReady = !depNeeded || dep->prefetchGroundNetwork();
+    const bool arrReady = !arrNeeded || arr->prefetchGroundNetwork();
+    if ((distanceToUser >= TRAFFIC_TO_AI_DIST_TO_START) || !depReady || !arrReady) {
+        return true;
+    }
+
     if (!createAIAircraft(flight, speed, deptime, remainingTimeEnroute)) {
         valid = false;
     }
@@ -39,6 +39,7 @@
 #include "WindowBuilder.hxx"
 #include "WindowSystemAdapter.hxx"
 #include "renderer.hxx"
+#include <FDM/fdm_shell.hxx>
 #include <Main/fg_os.hxx>
 #include <Main/fg_props.hxx>
 #include <Main/globals.hxx>
@@ -300,6 +301,8 @@ int fgOSMainLoop()
         }
     }
 
+    // frame() does some setup on the first frame
+    bool firstFrame = true;
     while (!viewer_base->done()) {
         fgIdleHandler idleFunc = globals->get_renderer()->getEventHandler()->getIdleHandler();
         if (idleFunc) {
@@ -328,8 +331,24 @@ int fgOSMainLoop()
                 }
             }
         }
-        globals->get_renderer()->update();
-        viewer_base->frame(globals->get_sim_time_sec());
+        // With the FDM on its own thread, keep it off while the scene graph
+        // is modified and animations read properties, and let it iterate
+        // while we cull and draw.
+        auto fdm = globals->get_subsystem<FDMShell>();
+        if (fdm && fdm->threadRunning() && !firstFrame) {
+            auto fdmLock = fdm->lockThread();
+            globals->get_renderer()->update();
+            viewer_base->advance(globals->get_sim_time_sec());
+            viewer_base->eventTraversal();
+            viewer_base->updateTraversal();
+            fdmLock.unlock();
+
+            viewer_base->renderingTraversals();
+        } else {
+            globals->get_renderer()->update();
+            viewer_base->frame(globals->get_sim_time_sec());
+            firstFrame = false;
+        }
     }
 
     flightgear::addSentryBreadcrumb("main loop exited", "info");
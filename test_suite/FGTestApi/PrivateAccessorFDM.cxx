@@ -4,6 +4,7 @@
 #include <FDM/AIWake/AircraftMesh.hxx>
 #include <FDM/AIWake/WakeMesh.hxx>
 #include <FDM/YASim/Atmosphere.hpp>
+#include <FDM/groundcache.hxx>
 
 
 
@@ -49,6 +50,22 @@ FGTestApi::PrivateAccessor::FDM::Accessor::read_FDM_AIWake_WakeMesh_Gamma(WakeMe
 }
 
 
+// Access variables from src/FDM/groundcache.hxx.
+void
+FGTestApi::PrivateAccessor::FDM::Accessor::set_FDM_groundcache_localBvhTree(FGGroundCache* instance, simgear::BVHNode* tree, const SGVec3d& pt, double rad) const
+{
+    // what prepare_ground_cache sets up, without walking the scene graph
+    const SGGeod geod = SGGeod::fromCart(pt);
+    instance->_localBvhTree = tree;
+    instance->reference_wgs84_point = pt;
+    instance->reference_vehicle_radius = rad;
+    instance->down = SGQuatd::fromLonLat(geod).rotate(SGVec3d(0, 0, 1));
+    instance->_altitude = geod.getElevationM();
+    instance->_material = nullptr;
+    instance->found_ground = true;
+}
+
+
 // Access variables from src/FDM/YASim/Atmosphere.hxx.
 float
 FGTestApi::PrivateAccessor::FDM::Accessor::read_FDM_YASim_Atmosphere_numColumns(std::unique_ptr<yasim::Atmosphere> &instance) const
@@ -7,6 +7,12 @@
 #include <simgear/math/SGMath.hxx>
 #include <simgear/structure/SGSharedPtr.hxx>
 
+// Forward declaration for src/FDM/groundcache.hxx.
+class FGGroundCache;
+namespace simgear {
+class BVHNode;
+}
+
 // Forward declarations for src/FDM/AIWake.
 class AIWakeData;
 class AIWakeGroup;
@@ -40,6 +46,11 @@ public:
     int read_FDM_AIWake_WakeMesh_nelm(WakeMesh* instance) const;
     double **read_FDM_AIWake_WakeMesh_Gamma(WakeMesh* instance) const;
 
+    // Access variables from src/FDM/groundcache.hxx.
+    // Install tree as the cache collected around pt with radius rad.
+    void set_FDM_groundcache_localBvhTree(FGGroundCache* instance, simgear::BVHNode* tree,
+                                          const SGVec3d& pt, double rad) const;
+
     // Access variables from src/FDM/YASim/Atmosphere.hxx.
     float read_FDM_YASim_Atmosphere_numColumns(std::unique_ptr<yasim::Atmosphere> &instance) const;
     float read_FDM_YASim_Atmosphere_data(std::unique_ptr<yasim::Atmosphere> &instance, int i, int j) const;
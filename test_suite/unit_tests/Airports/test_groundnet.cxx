@@ -12,7 +12,9 @@
 #include <cstring>
 #include <iostream>
 #include <memory>
+#include <vector>
 
+#include <simgear/misc/sg_dir.hxx>
 
 #include "test_suite/FGTestApi/NavDataCache.hxx"
 #include "test_suite/FGTestApi/TestDataLogger.hxx"
@@ -24,8 +26,10 @@
 #include <AIModel/performancedb.hxx>
 #include <Airports/airport.hxx>
 #include <Airports/airportdynamicsmanager.hxx>
+#include <Airports/groundnetloader.hxx>
 #include <Airports/groundnetwork.hxx>
 #include <Airports/parking.hxx>
+#include <Airports/xmlloader.hxx>
 #include <Traffic/TrafficMgr.hxx>
 
 #include <ATC/atc_mgr.hxx>
@@ -235,3 +239,87 @@ void GroundnetTests::testFindNearestNodeOnRunwayEntry()
     CPPUNIT_ASSERT_EQUAL(1014, node3->getIndex());
     CPPUNIT_ASSERT(node3->getIsOnRunway());
 }
+
+// The route from testShortestRoute, on a network loaded some other way
+static void checkEGPHNetwork(FGGroundNetwork* network, FGAirport* egph)
+{
+    CPPUNIT_ASSERT(network);
+    CPPUNIT_ASSERT_EQUAL(true, network->exists());
+
+    FGGroundNetwork* reference = egph->groundNetwork();
+    CPPUNIT_ASSERT_EQUAL(reference->allParkings().size(), network->allParkings().size());
+    CPPUNIT_ASSERT_EQUAL(reference->getVersion(), network->getVersion());
+    CPPUNIT_ASSERT(reference->getTowerFrequencies() == network->getTowerFrequencies());
+
+    FGParkingRef startParking = network->findParkingByName("main-apron10");
+    CPPUNIT_ASSERT(startParking);
+    FGParkingRef referenceParking = reference->findParkingByName("main-apron10");
+    CPPUNIT_ASSERT_EQUAL(referenceParking->getIndex(), startParking->getIndex());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(referenceParking->getHeading(), startParking->getHeading(), 1e-9);
+    CPPUNIT_ASSERT_EQUAL(referenceParking->getType(), startParking->getType());
+    CPPUNIT_ASSERT(startParking->getPushBackPoint());
+    CPPUNIT_ASSERT_EQUAL(referenceParking->getPushBackPoint()->getIndex(),
+                         startParking->getPushBackPoint()->getIndex());
+
+    FGRunwayRef runway = egph->getRunwayByIndex(0);
+    FGTaxiNodeRef end = network->findNearestNodeOnRunwayEntry(runway->threshold(), runway);
+    CPPUNIT_ASSERT(end);
+    FGTaxiRoute route = network->findShortestRoute(startParking, end);
+    CPPUNIT_ASSERT_EQUAL(29, route.size());
+}
+
+void GroundnetTests::testCacheRoundTrip()
+{
+    FGAirportRef egph = FGAirport::getByIdent("EGPH");
+    const SGPath xml = SGPath::fromUtf8(FG_TEST_SUITE_DATA) / "EGPH.groundnet.xml";
+    const SGPath cacheDir = globals->get_fg_home() / "groundnet-cache-test";
+    simgear::Dir(cacheDir).remove(true);
+
+    const std::string key = flightgear::GroundNetCache::key(xml);
+    CPPUNIT_ASSERT(!key.empty());
+
+    // parsing the XML fills the cache
+    bool hasErrors = true;
+    std::unique_ptr<FGGroundNetwork> parsed(new FGGroundNetwork(egph));
+    CPPUNIT_ASSERT(XMLLoader::parseGroundNetwork(parsed.get(), xml, cacheDir, hasErrors));
+    CPPUNIT_ASSERT(!hasErrors);
+    CPPUNIT_ASSERT((cacheDir / (key + ".bin")).exists());
+
+    std::unique_ptr<FGGroundNetwork> cached(new FGGroundNetwork(egph));
+    hasErrors = true;
+    CPPUNIT_ASSERT(flightgear::GroundNetCache::read(cached.get(), cacheDir, key, hasErrors));
+    CPPUNIT_ASSERT(!hasErrors);
+    cached->init();
+    checkEGPHNetwork(cached.get(), egph);
+
+    // a different key, as for an edited file, is not served
+    std::unique_ptr<FGGroundNetwork> stale(new FGGroundNetwork(egph));
+    CPPUNIT_ASSERT(!flightgear::GroundNetCache::read(stale.get(), cacheDir, "0123456789abcdef", hasErrors));
+
+    simgear::Dir(cacheDir).remove(true);
+}
+
+void GroundnetTests::testBackgroundLoad()
+{
+    FGAirportRef egph = FGAirport::getByIdent("EGPH");
+    const SGPath xml = SGPath::fromUtf8(FG_TEST_SUITE_DATA) / "EGPH.groundnet.xml";
+
+    // several loads queue on the one worker; each is handed over complete,
+    // whether the worker got to it or take() did the load itself
+    std::vector<std::unique_ptr<flightgear::GroundNetLoader>> loaders;
+    for (int i = 0; i < 4; ++i) {
+        loaders.emplace_back(new flightgear::GroundNetLoader(egph, xml));
+    }
+
+    for (auto& loader : loaders) {
+        std::unique_ptr<FGGroundNetwork> network = loader->take();
+        checkEGPHNetwork(network.get(), egph);
+        CPPUNIT_ASSERT(loader->isReady());
+        CPPUNIT_ASSERT(!loader->take());
+    }
+
+    // dropping loads which are queued or in progress is safe
+    for (int i = 0; i < 4; ++i) {
+        flightgear::GroundNetLoader discarded(egph, xml);
+    }
+}
@@ -29,6 +29,8 @@ class GroundnetTests : public CppUnit::TestFixture
     CPPUNIT_TEST(testShortestRouteNotCrossingRunway);
     CPPUNIT_TEST(testFind);
     CPPUNIT_TEST(testFindNearestNodeOnRunwayEntry);
+    CPPUNIT_TEST(testCacheRoundTrip);
+    CPPUNIT_TEST(testBackgroundLoad);
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -49,4 +51,6 @@ public:
     void testShortestRouteNotCrossingRunway();
     void testFind();
     void testFindNearestNodeOnRunwayEntry();
+    void testCacheRoundTrip();
+    void testBackgroundLoad();
 };
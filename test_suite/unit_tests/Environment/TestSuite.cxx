@@ -0,0 +1,9 @@
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_metarField.hxx"
+#include "test_ridgeLiftModel.hxx"
+
+// Set up the unit tests.
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(MetarFieldTests, "Unit tests");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(RidgeLiftModelTests, "Unit tests");
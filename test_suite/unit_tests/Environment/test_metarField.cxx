@@ -0,0 +1,157 @@
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "config.h"
+
+#include "test_metarField.hxx"
+
+#include <cmath>
+
+#include <simgear/props/props.hxx>
+
+#include <Environment/metarfield.hxx>
+
+using Environment::MetarField;
+using Environment::MetarProperties;
+using Environment::MetarValues;
+
+namespace {
+
+const double TAPER_RADIUS_M = 100000.0;
+
+// stations along the x axis, x in metres
+SGVec3d at(double x)
+{
+    return SGVec3d(6378137.0, x, 0.0);
+}
+
+MetarField::Station station(SGPropertyNode* root, double x, double temperature,
+                            double visibility, bool valid = true)
+{
+    SGPropertyNode_ptr node = root->addChild("station");
+    SGSharedPtr<MetarProperties> metar = new MetarProperties(node);
+    node->setDoubleValue("base-wind-from-north-fps", temperature);
+    node->setDoubleValue("base-wind-from-east-fps", 0.0);
+    node->setDoubleValue("temperature-sea-level-degc", temperature);
+    node->setDoubleValue("dewpoint-sea-level-degc", temperature - 5.0);
+    node->setDoubleValue("pressure-sea-level-inhg", 29.0 + temperature / 100.0);
+    node->setDoubleValue("min-visibility-m", visibility);
+    node->setDoubleValue("max-visibility-m", visibility);
+    node->setBoolValue("valid", valid);
+    return {metar, at(x)};
+}
+
+} // namespace
+
+void MetarFieldTests::testInterpolate()
+{
+    SGPropertyNode_ptr root = new SGPropertyNode;
+    MetarField field;
+    field.setStations({station(root, 0.0, 10.0, 1000.0),
+                       station(root, 20000.0, 20.0, 9000.0),
+                       // beyond the taper radius of both points below
+                       station(root, -150000.0, 40.0, 50000.0)},
+                      TAPER_RADIUS_M);
+
+    // half way, the two stations weigh the same
+    MetarValues v;
+    CPPUNIT_ASSERT(field.interpolate(at(10000.0), v));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(15.0, v.temperatureSeaLevelDegc, 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0, v.dewpointSeaLevelDegc, 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(29.15, v.pressureSeaLevelInhg, 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(15.0, v.windFromNorthFps, 1e-9);
+    // visibilities are blended geometrically
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3000.0, v.minVisibilityM, 1e-6);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3000.0, v.maxVisibilityM, 1e-6);
+
+    // over a station, it dominates
+    CPPUNIT_ASSERT(field.interpolate(at(0.0), v));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0, v.temperatureSeaLevelDegc, 0.02);
+
+    // the third station enters with no weight: the field is continuous
+    // across the point where it comes within the taper radius
+    MetarValues outside, inside;
+    CPPUNIT_ASSERT(field.interpolate(at(-49990.0), outside));
+    CPPUNIT_ASSERT(field.interpolate(at(-50010.0), inside));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(outside.temperatureSeaLevelDegc,
+                                 inside.temperatureSeaLevelDegc, 0.01);
+
+    // no station within the radius
+    CPPUNIT_ASSERT(!field.interpolate(at(500000.0), v));
+}
+
+void MetarFieldTests::testSkipInvalid()
+{
+    SGPropertyNode_ptr root = new SGPropertyNode;
+    MetarField field;
+    field.setStations({station(root, 0.0, 10.0, 1000.0),
+                       station(root, 20000.0, 20.0, 9000.0, false)},
+                      TAPER_RADIUS_M);
+
+    MetarValues v;
+    CPPUNIT_ASSERT(field.interpolate(at(10000.0), v));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0, v.temperatureSeaLevelDegc, 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1000.0, v.minVisibilityM, 1e-6);
+
+    root->getChild("station", 0)->setBoolValue("valid", false);
+    CPPUNIT_ASSERT(!field.interpolate(at(10000.0), v));
+
+    root->getChild("station", 1)->setBoolValue("valid", true);
+    CPPUNIT_ASSERT(field.interpolate(at(10000.0), v));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(20.0, v.temperatureSeaLevelDegc, 1e-9);
+}
+
+void MetarFieldTests::testHysteresis()
+{
+    MetarValues a;
+    CPPUNIT_ASSERT(!MetarField::differs(a, a));
+
+    MetarValues b = a;
+    b.temperatureSeaLevelDegc += 0.4;
+    CPPUNIT_ASSERT(!MetarField::differs(a, b));
+    b.temperatureSeaLevelDegc += 0.2;
+    CPPUNIT_ASSERT(MetarField::differs(a, b));
+
+    b = a;
+    b.windFromEastFps += 0.5; // about 0.3 kt
+    CPPUNIT_ASSERT(!MetarField::differs(a, b));
+    b.windFromEastFps += 2.0;
+    CPPUNIT_ASSERT(MetarField::differs(a, b));
+
+    b = a;
+    b.pressureSeaLevelInhg += 0.005;
+    CPPUNIT_ASSERT(!MetarField::differs(a, b));
+    b.pressureSeaLevelInhg += 0.01;
+    CPPUNIT_ASSERT(MetarField::differs(a, b));
+
+    b = a;
+    b.minVisibilityM *= 1.05;
+    CPPUNIT_ASSERT(!MetarField::differs(a, b));
+    b.minVisibilityM *= 1.1;
+    CPPUNIT_ASSERT(MetarField::differs(a, b));
+
+    // update() passes on only the changes noticeable since the values it
+    // last returned, including those that build up in small steps
+    SGPropertyNode_ptr root = new SGPropertyNode;
+    MetarField field;
+    field.setStations({station(root, 0.0, 10.0, 1000.0)}, TAPER_RADIUS_M);
+    SGPropertyNode* node = root->getChild("station", 0);
+
+    MetarValues v;
+    CPPUNIT_ASSERT(field.update(at(1000.0), v));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0, v.temperatureSeaLevelDegc, 1e-9);
+    CPPUNIT_ASSERT(!field.update(at(1000.0), v));
+
+    node->setDoubleValue("temperature-sea-level-degc", 10.3);
+    CPPUNIT_ASSERT(!field.update(at(1000.0), v));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0, v.temperatureSeaLevelDegc, 1e-9);
+    node->setDoubleValue("temperature-sea-level-degc", 10.6);
+    CPPUNIT_ASSERT(field.update(at(1000.0), v));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(10.6, v.temperatureSeaLevelDegc, 1e-9);
+
+    // clear() forgets the values last returned
+    field.clear();
+    CPPUNIT_ASSERT(!field.update(at(1000.0), v));
+    field.setStations({station(root, 0.0, 10.6, 1000.0)}, TAPER_RADIUS_M);
+    CPPUNIT_ASSERT(field.update(at(1000.0), v));
+}
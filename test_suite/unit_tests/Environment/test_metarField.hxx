@@ -0,0 +1,25 @@
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+
+// Tests for the weather interpolated between METAR stations
+class MetarFieldTests : public CppUnit::TestFixture
+{
+    // Set up the test suite.
+    CPPUNIT_TEST_SUITE(MetarFieldTests);
+    CPPUNIT_TEST(testInterpolate);
+    CPPUNIT_TEST(testSkipInvalid);
+    CPPUNIT_TEST(testHysteresis);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    // The tests.
+    void testInterpolate();
+    void testSkipInvalid();
+    void testHysteresis();
+};
@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "config.h"
+
+#include "test_ridgeLiftModel.hxx"
+
+#include <algorithm>
+#include <cmath>
+
+#include <simgear/sg_inlines.h>
+
+#include <Environment/ridgeliftmodel.hxx>
+
+using Environment::RidgeLiftModel;
+
+namespace {
+
+// FGRidgeLift::update() before the formulas moved into RidgeLiftModel
+double referenceLiftFactor(const double probe_elev_m[5], double slope[4])
+{
+    const double dist_probe_m[5] = {0.0, 250.0, 750.0, 2000.0, -100.0};
+    double adj_slope[4];
+    slope[0] = (probe_elev_m[0] - probe_elev_m[1]) / dist_probe_m[1];
+    slope[1] = (probe_elev_m[1] - probe_elev_m[2]) / dist_probe_m[2];
+    slope[2] = (probe_elev_m[2] - probe_elev_m[3]) / dist_probe_m[3];
+    slope[3] = (probe_elev_m[4] - probe_elev_m[0]) / -dist_probe_m[4];
+
+    for (unsigned i = 0; i < 4; i++)
+        adj_slope[i] = sin(atan(5.0 * pow((fabs(slope[i])), 1.7))) * SG_SIGN<double>(slope[i]);
+
+    adj_slope[0] *= 0.2;
+    adj_slope[1] *= 0.2;
+    if (adj_slope[2] < 0.0) {
+        adj_slope[2] *= 0.5;
+    } else {
+        adj_slope[2] = 0.0;
+    }
+
+    if ((adj_slope[0] >= 0.0) && (adj_slope[3] < 0.0)) {
+        adj_slope[3] = 0.0;
+    } else {
+        adj_slope[3] *= 0.2;
+    }
+    return adj_slope[0] + adj_slope[1] + adj_slope[2] + adj_slope[3];
+}
+
+double referenceAglFactor(const double probe_elev_m[5], double lift_factor, double agl_m)
+{
+    const double BOUNDARY1_m = 40.0;
+    double boundary2_m = 130.0;
+    if (lift_factor < 0.0) {
+        double highest_probe_temp = std::max(probe_elev_m[1], probe_elev_m[2]);
+        double highest_probe_downwind_m = std::max(highest_probe_temp, probe_elev_m[3]);
+        boundary2_m = highest_probe_downwind_m - probe_elev_m[0];
+    }
+
+    if (agl_m < BOUNDARY1_m) {
+        return 0.5 + 0.5 * agl_m / BOUNDARY1_m;
+    } else if (agl_m < boundary2_m) {
+        return 1.0;
+    }
+    return exp(-(2 + probe_elev_m[0] / 2000) *
+               (agl_m - boundary2_m) / std::max(probe_elev_m[0], 200.0));
+}
+
+} // namespace
+
+void RidgeLiftModelTests::testLiftFormulas()
+{
+    const double cases[][5] = {
+        {500.0, 500.0, 500.0, 500.0, 500.0},  // flat
+        {600.0, 450.0, 300.0, 200.0, 650.0},  // upwind face of a slope
+        {300.0, 500.0, 700.0, 900.0, 290.0},  // lee side
+        {800.0, 700.0, 900.0, 400.0, 780.0},  // ridge upwind
+        {150.0, 140.0, 100.0, 120.0, 400.0},  // cliff downwind
+        {1200.0, 1000.0, 600.0, 300.0, 1150.0}, // high ground
+    };
+
+    for (const auto& elevation_m : cases) {
+        double slope[4], referenceSlope[4];
+        const double factor = RidgeLiftModel::liftFactor(elevation_m, slope);
+        const double reference = referenceLiftFactor(elevation_m, referenceSlope);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(reference, factor, 1e-12);
+        for (int i = 0; i < 4; ++i) {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(referenceSlope[i], slope[i], 1e-12);
+        }
+
+        const double boundary_m = RidgeLiftModel::boundary(elevation_m, factor);
+        for (double agl_m : {0.0, 20.0, 40.0, 100.0, 200.0, 1000.0}) {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(referenceAglFactor(elevation_m, factor, agl_m),
+                                         RidgeLiftModel::aglFactor(agl_m, elevation_m[0], boundary_m),
+                                         1e-12);
+        }
+    }
+}
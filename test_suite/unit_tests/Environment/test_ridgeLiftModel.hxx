@@ -0,0 +1,21 @@
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+
+// Tests for the lift formulas of the ridge lift
+class RidgeLiftModelTests : public CppUnit::TestFixture
+{
+    // Set up the test suite.
+    CPPUNIT_TEST_SUITE(RidgeLiftModelTests);
+    CPPUNIT_TEST(testLiftFormulas);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    // The tests.
+    void testLiftFormulas();
+};
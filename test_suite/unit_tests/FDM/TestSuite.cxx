@@ -3,6 +3,8 @@
 
 #include "testAeroElement.hxx"
 #include "testFGInterface.hxx"
+#include "testGroundCache.hxx"
+#include "testJSBSimFunction.hxx"
 #include "testYASimAtmosphere.hxx"
 #include "testYASimGear.hxx"
 
@@ -11,3 +13,5 @@ CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(AeroElementTests, "Unit tests");
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(YASimAtmosphereTests, "Unit tests");
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(YASimGearTests, "Unit tests");
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(FGInterfaceTests, "Unit tests");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(GroundCacheTests, "Unit tests");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(JSBSimFunctionTests, "Unit tests");
@@ -3,6 +3,7 @@
 #include <simgear/math/SGVec3.hxx>
 
 #include "FDM/AIWake/AeroElement.hxx"
+#include "FDM/AIWake/HorseshoeVortices.hxx"
 
 #include "testAeroElement.hxx"
 
@@ -132,3 +133,37 @@ void AeroElementTests::testInducedVelocityUpstream()
     CPPUNIT_ASSERT_DOUBLES_EQUAL(v[1], 0.0, 1e-9);
     CPPUNIT_ASSERT_DOUBLES_EQUAL(v[2], (1.0-sqrt(2.0))/M_PI, 1e-9);
 }
+
+void AeroElementTests::testHorseshoeKernelMatchesElements()
+{
+    std::vector<AeroElement_ptr> elements;
+    HorseshoeVortices vortices;
+    double gamma[4];
+
+    for (int i=0; i<4; ++i) {
+        double y = i - 2.0;
+        elements.push_back(new AeroElement(SGVec3d(-1., y, 0.),
+                                           SGVec3d(0., y, 0.),
+                                           SGVec3d(0., y+1., 0.),
+                                           SGVec3d(-1., y+1., 0.)));
+        vortices.add(*elements.back());
+        gamma[i] = 1.0 + 0.5*i;
+    }
+
+    // includes points on a bound vortex and on a trailing vortex, where the
+    // singular contributions must be dropped as AeroElement does
+    const SGVec3d points[] = {SGVec3d(-0.25, -1.5, 0.), SGVec3d(0.5, 0.3, -0.5),
+                              SGVec3d(-10., 3., 2.), SGVec3d(0., 0.5, 0.),
+                              SGVec3d(-3., 1., 0.)};
+
+    for (const SGVec3d& p : points) {
+        SGVec3d expected(0., 0., 0.);
+        for (int i=0; i<4; ++i)
+            expected += gamma[i] * elements[i]->getInducedVelocity(p);
+
+        SGVec3d v = vortices.getInducedVelocity(p, gamma);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(expected[0], v[0], 1e-9);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(expected[1], v[1], 1e-9);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(expected[2], v[2], 1e-9);
+    }
+}
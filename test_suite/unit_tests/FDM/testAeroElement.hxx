@@ -38,6 +38,7 @@ class AeroElementTests : public CppUnit::TestFixture
     //CPPUNIT_TEST(testInducedVelocityOnCollocationPoint);    // Not run in the original ctest.
     CPPUNIT_TEST(testInducedVelocityUpstream);
     CPPUNIT_TEST(testNormal);
+    CPPUNIT_TEST(testHorseshoeKernelMatchesElements);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -58,4 +59,5 @@ public:
     void testInducedVelocityOnCollocationPoint();
     void testInducedVelocityUpstream();
     void testNormal();
+    void testHorseshoeKernelMatchesElements();
 };
@@ -0,0 +1,183 @@
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "config.h"
+
+#include "testGroundCache.hxx"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "test_suite/FGTestApi/PrivateAccessorFDM.hxx"
+
+#include <simgear/bvh/BVHGroup.hxx>
+#include <simgear/bvh/BVHMaterial.hxx>
+#include <simgear/bvh/BVHMotionTransform.hxx>
+#include <simgear/bvh/BVHStaticGeometryBuilder.hxx>
+#include <simgear/bvh/BVHTransform.hxx>
+#include <simgear/math/SGMath.hxx>
+
+#include <FDM/groundcache.hxx>
+
+using namespace simgear;
+
+namespace {
+
+// The local horizontal frame at the cache centre: a north, b east and h up,
+// in metres.
+class LocalFrame
+{
+public:
+    explicit LocalFrame(const SGGeod& geod) :
+        center(SGVec3d::fromGeod(geod))
+    {
+        const SGQuatd hlToEc = SGQuatd::fromLonLat(geod);
+        _north = hlToEc.rotate(SGVec3d(1, 0, 0));
+        _east = hlToEc.rotate(SGVec3d(0, 1, 0));
+        _up = -hlToEc.rotate(SGVec3d(0, 0, 1));
+    }
+
+    // relative to the centre, as stored in the tree
+    SGVec3d offset(double a, double b, double h) const
+    {
+        return a * _north + b * _east + h * _up;
+    }
+
+    SGVec3d world(double a, double b, double h) const
+    {
+        return center + offset(a, b, h);
+    }
+
+    void addQuad(BVHStaticGeometryBuilder& builder, double a0, double b0,
+                 double a1, double b1, double h) const
+    {
+        const SGVec3f p00(offset(a0, b0, h)), p10(offset(a1, b0, h));
+        const SGVec3f p11(offset(a1, b1, h)), p01(offset(a0, b1, h));
+        builder.addTriangle(p00, p10, p11);
+        builder.addTriangle(p00, p11, p01);
+    }
+
+    const SGVec3d center;
+
+private:
+    SGVec3d _north, _east, _up;
+};
+
+void checkSame(const std::string& where, const SGVec3d& expected, const SGVec3d& actual,
+               double tolerance)
+{
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(where, expected[0], actual[0], tolerance);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(where, expected[1], actual[1], tolerance);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(where, expected[2], actual[2], tolerance);
+}
+
+} // namespace
+
+
+// The batched query finds, for every point, the same ground as the single
+// point query, over overlapping surfaces, a moving deck and points where
+// the tree has nothing below.
+void GroundCacheTests::testBatchedAgl()
+{
+    const LocalFrame frame(SGGeod::fromDegM(10.0, 50.0, 0.0));
+
+    SGSharedPtr<BVHMaterial> ground = new BVHMaterial;
+    SGSharedPtr<BVHMaterial> platform = new BVHMaterial;
+    SGSharedPtr<BVHMaterial> ramp = new BVHMaterial;
+    SGSharedPtr<BVHMaterial> deck = new BVHMaterial;
+
+    // the ground, with a platform and a ramp over it
+    SGSharedPtr<BVHStaticGeometryBuilder> terrain = new BVHStaticGeometryBuilder;
+    terrain->setCurrentMaterial(ground.get());
+    frame.addQuad(*terrain, -60, -60, 60, 60, 0);
+    terrain->setCurrentMaterial(platform.get());
+    frame.addQuad(*terrain, -10, -10, 10, 10, 5);
+    terrain->setCurrentMaterial(ramp.get());
+    terrain->addTriangle(SGVec3f(frame.offset(-50, -50, 1)),
+                         SGVec3f(frame.offset(-20, -50, 6)),
+                         SGVec3f(frame.offset(-35, -20, 3)));
+
+    SGSharedPtr<BVHTransform> terrainTransform = new BVHTransform;
+    terrainTransform->setToWorldTransform(SGMatrixd(frame.center));
+    terrainTransform->addChild(terrain->buildTree());
+
+    // a moving and turning deck above the ground
+    SGSharedPtr<BVHStaticGeometryBuilder> carrier = new BVHStaticGeometryBuilder;
+    carrier->setCurrentMaterial(deck.get());
+    frame.addQuad(*carrier, 20, -10, 40, 10, 12);
+
+    SGSharedPtr<BVHMotionTransform> carrierTransform = new BVHMotionTransform;
+    carrierTransform->setToWorldTransform(SGMatrixd(frame.center));
+    carrierTransform->setLinearVelocity(frame.offset(5, 0, 0));
+    carrierTransform->setAngularVelocity(frame.offset(0, 0, 0.05));
+    carrierTransform->setReferenceTime(0);
+    carrierTransform->setStartTime(0);
+    carrierTransform->setEndTime(10);
+    const BVHNode::Id carrierId = BVHNode::getNewId();
+    carrierTransform->setId(carrierId);
+    carrierTransform->addChild(carrier->buildTree());
+
+    SGSharedPtr<BVHGroup> root = new BVHGroup;
+    root->addChild(terrainTransform.get());
+    root->addChild(carrierTransform.get());
+
+    FGGroundCache cache;
+    FGTestApi::PrivateAccessor::FDM::Accessor accessor;
+    accessor.set_FDM_groundcache_localBvhTree(&cache, root.get(), frame.center, 100);
+
+    // above and between the surfaces, and beyond the ground's edges
+    std::vector<FGGroundCache::AglQuery> queries;
+    for (double h : {50.0, 8.0}) {
+        for (double a = -70; a <= 70; a += 7.5) {
+            for (double b : {-75.0, -45.0, -12.0, -3.0, 0.0, 4.0, 25.0, 70.0}) {
+                FGGroundCache::AglQuery q;
+                q.pt = frame.world(a, b, h);
+                queries.push_back(q);
+            }
+        }
+    }
+
+    for (double t : {0.0, 1.5}) {
+        cache.get_agl(t, queries.data(), queries.size());
+
+        for (size_t i = 0; i < queries.size(); ++i) {
+            const FGGroundCache::AglQuery& q = queries[i];
+            SGVec3d contact, normal, linearVel, angularVel;
+            BVHNode::Id id = 0;
+            const BVHMaterial* material = nullptr;
+            const bool found = cache.get_agl(t, q.pt, contact, normal, linearVel,
+                                             angularVel, id, material);
+
+            std::ostringstream where;
+            where << "t=" << t << " point " << i;
+            CPPUNIT_ASSERT_EQUAL_MESSAGE(where.str(), found, q.found);
+            CPPUNIT_ASSERT_MESSAGE(where.str(), material == q.material);
+            CPPUNIT_ASSERT_MESSAGE(where.str(), id == q.id);
+            // the segments are intersected in float, locally
+            checkSame(where.str(), contact, q.contact, 1e-3);
+            checkSame(where.str(), normal, q.normal, 1e-6);
+            checkSame(where.str(), linearVel, q.linearVel, 1e-6);
+            checkSame(where.str(), angularVel, q.angularVel, 1e-6);
+        }
+    }
+
+    // the nearest surface below each point wins
+    FGGroundCache::AglQuery probes[6];
+    probes[0].pt = frame.world(0, 0, 50);
+    probes[1].pt = frame.world(-30, -40, 50);
+    probes[2].pt = frame.world(30, 0, 50);
+    probes[3].pt = frame.world(30, 0, 8);
+    probes[4].pt = frame.world(0, 40, 50);
+    probes[5].pt = frame.world(0, 80, 50);
+    CPPUNIT_ASSERT_EQUAL(6u, cache.get_agl(0, probes, 6));
+    CPPUNIT_ASSERT(probes[0].material == platform.get());
+    CPPUNIT_ASSERT(probes[1].material == ramp.get());
+    CPPUNIT_ASSERT(probes[2].material == deck.get());
+    CPPUNIT_ASSERT(carrierId == probes[2].id);
+    CPPUNIT_ASSERT(probes[3].material == ground.get());
+    CPPUNIT_ASSERT(probes[4].material == ground.get());
+    checkSame("ground", frame.world(0, 40, 0), probes[4].contact, 1e-3);
+    // nothing in the tree: the cache's coarse ground level
+    CPPUNIT_ASSERT(probes[5].material == nullptr);
+}
@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "config.h"
+
+#include "testJSBSimFunction.hxx"
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "test_suite/FGTestApi/testGlobals.hxx"
+
+#include <FDM/JSBSim/FGFDMExec.h>
+#include <FDM/JSBSim/input_output/FGXMLParse.h>
+#include <FDM/JSBSim/math/FGFunction.h>
+
+using namespace JSBSim;
+
+namespace {
+
+const double X[] = {-2.0, 0.0, 0.5, 3.0};
+const double Y[] = {-1.0, 0.0, 4.0};
+const double Z[] = {0.0, -0.5, 2.0};
+
+/**
+ * The same function loaded twice from XML, once evaluated by walking the
+ * tree and once compiled, with the properties test/x, test/y and test/z as
+ * inputs.
+ */
+class FunctionPair
+{
+public:
+    explicit FunctionPair(const std::string& xml)
+    {
+        auto pm = fdmex.GetPropertyManager();
+        for (const char* name : {"test/x", "test/y", "test/z"}) {
+            pm->GetNode(name, true)->setDoubleValue(0.0);
+        }
+
+        std::istringstream in(xml);
+        readXML(in, parser);
+        Element* el = parser.GetDocument();
+        CPPUNIT_ASSERT(el);
+
+        tree.reset(new FGFunction(&fdmex, el));
+        compiled.reset(new FGFunction(&fdmex, el));
+        compiled->Compile();
+    }
+
+    void setInputs(double x, double y, double z)
+    {
+        auto pm = fdmex.GetPropertyManager();
+        pm->GetNode("test/x")->setDoubleValue(x);
+        pm->GetNode("test/y")->setDoubleValue(y);
+        pm->GetNode("test/z")->setDoubleValue(z);
+    }
+
+    // evaluate both over every combination of the inputs above
+    void checkSame()
+    {
+        for (double x : X) {
+            for (double y : Y) {
+                for (double z : Z) {
+                    setInputs(x, y, z);
+                    std::ostringstream where;
+                    where << "x=" << x << " y=" << y << " z=" << z;
+                    CPPUNIT_ASSERT_EQUAL_MESSAGE(where.str(), tree->GetValue(),
+                                                 compiled->GetValue());
+                }
+            }
+        }
+    }
+
+    FGFDMExec fdmex;
+    FGXMLParse parser;
+    std::unique_ptr<FGFunction> tree;
+    std::unique_ptr<FGFunction> compiled;
+};
+
+} // namespace
+
+
+// Set up function for each test.
+void JSBSimFunctionTests::setUp()
+{
+    FGTestApi::setUp::initTestGlobals("JSBSimFunction");
+}
+
+
+// Clean up after each test.
+void JSBSimFunctionTests::tearDown()
+{
+    FGTestApi::tearDown::shutdownTestGlobals();
+}
+
+
+void JSBSimFunctionTests::testArithmetic()
+{
+    FunctionPair f(R"(
+      <function>
+        <sum>
+          <product>
+            <property>test/x</property>
+            <value>2.5</value>
+            <property>-test/y</property>
+          </product>
+          <difference>
+            <property>test/y</property>
+            <value>1</value>
+            <sin><property>test/x</property></sin>
+          </difference>
+          <quotient>
+            <property>test/x</property>
+            <property>test/z</property>
+          </quotient>
+        </sum>
+      </function>)");
+    f.checkSame();
+}
+
+
+// A quotient skipped over must leave the stack as the tree would, also
+// inside another quotient and in front of further operands.
+void JSBSimFunctionTests::testNestedQuotients()
+{
+    FunctionPair f(R"(
+      <function>
+        <product>
+          <value>3</value>
+          <quotient>
+            <property>test/y</property>
+            <quotient>
+              <property>test/x</property>
+              <property>test/z</property>
+            </quotient>
+          </quotient>
+          <quotient>
+            <difference>
+              <property>test/x</property>
+              <property>test/y</property>
+            </difference>
+            <property>test/y</property>
+          </quotient>
+          <value>2</value>
+        </product>
+      </function>)");
+    f.checkSame();
+}
+
+
+// <quotient> does not evaluate its numerator when the denominator is zero.
+// A random number drawn by the numerator of only one of the two functions
+// would make their sequences differ from then on.
+void JSBSimFunctionTests::testQuotientSkipsNumerator()
+{
+    FunctionPair f(R"(
+      <function>
+        <quotient>
+          <sum>
+            <property>test/x</property>
+            <urandom seed="7"/>
+          </sum>
+          <property>test/z</property>
+        </quotient>
+      </function>)");
+
+    for (int i = 0; i < 20; ++i) {
+        f.setInputs(i, 0.0, (i % 3) ? 0.5 * i : 0.0);
+        CPPUNIT_ASSERT_EQUAL(f.tree->GetValue(), f.compiled->GetValue());
+    }
+}
@@ -0,0 +1,31 @@
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+
+// The unit tests of JSBSim functions flattened into FGFunctionProgram.
+class JSBSimFunctionTests : public CppUnit::TestFixture
+{
+    // Set up the test suite.
+    CPPUNIT_TEST_SUITE(JSBSimFunctionTests);
+    CPPUNIT_TEST(testArithmetic);
+    CPPUNIT_TEST(testNestedQuotients);
+    CPPUNIT_TEST(testQuotientSkipsNumerator);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    // Set up function for each test.
+    void setUp();
+
+    // Clean up after each test.
+    void tearDown();
+
+    // The tests.
+    void testArithmetic();
+    void testNestedQuotients();
+    void testQuotientSkipsNumerator();
+};
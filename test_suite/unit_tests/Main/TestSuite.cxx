@@ -20,12 +20,14 @@
 #include "test_autosaveMigration.hxx"
 #include "test_commands.hxx"
 #include "test_FGLocale.hxx"
+#include "test_logger.hxx"
 #include "test_posinit.hxx"
 #include "test_timeManager.hxx"
 
 // Set up the unit tests.
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(AutosaveMigrationTests, "Unit tests");
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(FGLocaleTests, "Unit tests");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(LoggerTests, "Unit tests");
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(PosInitTests, "Unit tests");
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(TimeManagerTests, "Unit tests");
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(CommandsTests, "Unit tests");
@@ -0,0 +1,202 @@
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "config.h"
+
+#include "test_logger.hxx"
+
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "test_suite/FGTestApi/testGlobals.hxx"
+
+#include <simgear/io/iostreams/sgstream.hxx>
+#include <simgear/misc/sg_path.hxx>
+
+#include <Main/fg_props.hxx>
+#include <Main/globals.hxx>
+#include <Main/logger.hxx>
+#include <Main/loggerformat.hxx>
+#include <Main/util.hxx>
+
+namespace {
+
+// rows per block, and rows logged: two full blocks and a partial one
+const int BLOCK_ROWS = 4;
+const int ROWS = 10;
+
+// sampling interval, exact in binary
+const double INTERVAL_SEC = 0.125;
+
+SGPath logPath()
+{
+    return globals->get_fg_home() / "Export" / "test_logger.fglog";
+}
+
+void setValues(int row)
+{
+    fgSetBool("/test/bool", (row % 2) == 0);
+    fgSetInt("/test/int", -1000 * row);
+    fgSetLong("/test/long", 100000L * row);
+    fgSetFloat("/test/float", 0.5f * row);
+    fgSetDouble("/test/double", row / 3.0);
+    // row 3 has an empty string
+    fgSetString("/test/string", (row == 3) ? "" : "row " + std::to_string(row));
+}
+
+// log ROWS rows of every column type to logPath()
+void writeLog()
+{
+    SGPropertyNode* log = fgGetNode("/logging/log", true);
+    log->setBoolValue("enabled", true);
+    log->setStringValue("filename", logPath().utf8Str());
+    log->setStringValue("format", "binary");
+    log->setIntValue("interval-ms", static_cast<int>(INTERVAL_SEC * 1000));
+    log->setIntValue("block-rows", BLOCK_ROWS);
+    for (const char* name : {"bool", "int", "long", "float", "double", "string"}) {
+        SGPropertyNode* entry = log->addChild("entry");
+        entry->setBoolValue("enabled", true);
+        entry->setStringValue("title", name);
+        entry->setStringValue("property", std::string("/test/") + name);
+    }
+
+    // the column types are those of the properties when logging starts
+    setValues(0);
+    globals->set_sim_time_sec(0.0);
+
+    FGLogger logger;
+    logger.bind();
+    logger.init();
+    for (int row = 1; row <= ROWS; ++row) {
+        setValues(row);
+        globals->set_sim_time_sec(row * INTERVAL_SEC);
+        logger.update(INTERVAL_SEC);
+    }
+    logger.unbind();
+    // the logger writes the partial block and closes the file when destroyed
+}
+
+std::string readLog()
+{
+    sg_ifstream in(logPath(), std::ios::in | std::ios::binary);
+    CPPUNIT_ASSERT(in.good());
+    return std::string(std::istreambuf_iterator<char>(in),
+                       std::istreambuf_iterator<char>());
+}
+
+std::vector<std::string> split(const std::string& line)
+{
+    std::vector<std::string> fields(1);
+    for (char c : line) {
+        if (c == ',') {
+            fields.emplace_back();
+        } else {
+            fields.back() += c;
+        }
+    }
+    return fields;
+}
+
+std::vector<std::string> lines(const std::string& text)
+{
+    std::vector<std::string> result;
+    std::istringstream in(text);
+    for (std::string line; std::getline(in, line);) {
+        result.push_back(line);
+    }
+    return result;
+}
+
+// check the CSV row against the values setValues(row) logged
+void checkRow(const std::string& line, int row)
+{
+    const std::vector<std::string> f = split(line);
+    CPPUNIT_ASSERT_EQUAL(size_t(7), f.size());
+    // the conversion writes numbers which read back exactly
+    CPPUNIT_ASSERT_EQUAL(row * INTERVAL_SEC, std::stod(f[0]));
+    CPPUNIT_ASSERT_EQUAL(std::string((row % 2) == 0 ? "true" : "false"), f[1]);
+    CPPUNIT_ASSERT_EQUAL(-1000 * row, std::stoi(f[2]));
+    CPPUNIT_ASSERT_EQUAL(100000LL * row, std::stoll(f[3]));
+    CPPUNIT_ASSERT_EQUAL(0.5f * row, std::stof(f[4]));
+    CPPUNIT_ASSERT_EQUAL(row / 3.0, std::stod(f[5]));
+    CPPUNIT_ASSERT_EQUAL((row == 3) ? std::string() : "row " + std::to_string(row), f[6]);
+}
+
+} // namespace
+
+
+// Set up function for each test.
+void LoggerTests::setUp()
+{
+    FGTestApi::setUp::initTestGlobals("logger");
+    // the logger may only write where SGPath::validate() allows it to
+    fgInitAllowedPaths();
+
+    (logPath().dir() / "dummy").create_dir(0755);
+    if (logPath().exists()) {
+        logPath().remove();
+    }
+}
+
+
+// Clean up after each test.
+void LoggerTests::tearDown()
+{
+    logPath().remove();
+    FGTestApi::tearDown::shutdownTestGlobals();
+}
+
+
+void LoggerTests::testBinaryRoundTrip()
+{
+    writeLog();
+
+    std::istringstream in(readLog());
+    std::ostringstream out;
+    CPPUNIT_ASSERT_EQUAL(0, flightgear::logformat::convertToCsv(in, out, ','));
+
+    const std::vector<std::string> csv = lines(out.str());
+    CPPUNIT_ASSERT_EQUAL(size_t(ROWS + 1), csv.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("Time,bool,int,long,float,double,string"), csv[0]);
+    for (int row = 1; row <= ROWS; ++row) {
+        checkRow(csv[row], row);
+    }
+}
+
+
+void LoggerTests::testBinaryTruncated()
+{
+    writeLog();
+    const std::string log = readLog();
+
+    // a log cut short in the last block keeps the complete blocks
+    {
+        std::istringstream in(log.substr(0, log.size() - 3));
+        std::ostringstream out;
+        CPPUNIT_ASSERT_EQUAL(1, flightgear::logformat::convertToCsv(in, out, ','));
+
+        const std::vector<std::string> csv = lines(out.str());
+        CPPUNIT_ASSERT_EQUAL(size_t(2 * BLOCK_ROWS + 1), csv.size());
+        for (int row = 1; row <= 2 * BLOCK_ROWS; ++row) {
+            checkRow(csv[row], row);
+        }
+    }
+
+    // a log cut short in the header has no rows
+    {
+        std::istringstream in(log.substr(0, 20));
+        std::ostringstream out;
+        CPPUNIT_ASSERT_EQUAL(1, flightgear::logformat::convertToCsv(in, out, ','));
+        CPPUNIT_ASSERT_EQUAL(size_t(1), lines(out.str()).size());
+    }
+
+    // not a binary log at all
+    {
+        std::istringstream in("Time,bool\n0.125,true\n");
+        std::ostringstream out;
+        CPPUNIT_ASSERT_EQUAL(1, flightgear::logformat::convertToCsv(in, out, ','));
+        CPPUNIT_ASSERT(out.str().empty());
+    }
+}
@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "config.h"
+
+#include "benchmarkAirwayRouting.hxx"
+
+#include "test_suite/FGTestApi/NavDataCache.hxx"
+#include "test_suite/FGTestApi/testGlobals.hxx"
+
+#include <simgear/timing/timestamp.hxx>
+
+#include <Airports/airport.hxx>
+#include <Main/globals.hxx>
+#include <Navaids/FlightPlan.hxx>
+#include <Navaids/airways.hxx>
+
+using namespace std::string_literals;
+using namespace flightgear;
+
+namespace {
+
+struct RoutePair {
+    const char* airport; // used to anchor the waypoint lookup
+    const char* from;
+    const char* to;
+};
+
+void benchRoutes(Airway::Network* net, const std::vector<RoutePair>& pairs)
+{
+    for (const auto& p : pairs) {
+        FlightPlanRef f = FlightPlan::create();
+        f->setDeparture(FGAirport::findByIdent(p.airport));
+
+        auto from = f->waypointFromString(p.from);
+        auto to = f->waypointFromString(p.to);
+        CPPUNIT_ASSERT(from);
+        CPPUNIT_ASSERT(to);
+
+        // the first query includes building the in-memory network graph
+        WayptVec route;
+        SGTimeStamp st;
+        st.stamp();
+        bool ok = net->route(from, to, route);
+        const auto firstUSec = st.elapsedUSec();
+        CPPUNIT_ASSERT(ok);
+
+        const int iterations = 20;
+        st.stamp();
+        for (int i = 0; i < iterations; ++i) {
+            route.clear();
+            net->route(from, to, route);
+        }
+
+        SG_LOG(SG_NAVAID, SG_INFO, "route " << p.from << "->" << p.to << ": " << route.size()
+                                            << " legs, first:" << firstUSec << "usec, average:"
+                                            << (st.elapsedUSec() / iterations) << "usec");
+    }
+}
+
+} // namespace
+
+// Set up function for each test.
+void BenchmarkAirwayRouting::setUp()
+{
+    FGTestApi::setUp::initTestGlobals("BenchmarkAirwayRouting"s);
+    FGTestApi::setUp::initNavDataCache();
+}
+
+
+// Clean up after each test.
+void BenchmarkAirwayRouting::tearDown()
+{
+    FGTestApi::tearDown::shutdownTestGlobals();
+}
+
+
+void BenchmarkAirwayRouting::benchHighLevelRoutes()
+{
+    benchRoutes(Airway::highLevel(), {
+        {"EGPH", "TLA", "CNA"},
+        {"KORD", "JOT", "PKE"},
+        {"EDDF", "CHA", "GVA"},
+    });
+}
+
+void BenchmarkAirwayRouting::benchLowLevelRoutes()
+{
+    benchRoutes(Airway::lowLevel(), {
+        {"KORD", "DPA", "PKE"},
+        {"KORD", "IOW", "ALS"},
+    });
+}
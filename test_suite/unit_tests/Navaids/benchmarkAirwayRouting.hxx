@@ -0,0 +1,28 @@
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class BenchmarkAirwayRouting : public CppUnit::TestFixture
+{
+    // Set up the test suite.
+    CPPUNIT_TEST_SUITE(BenchmarkAirwayRouting);
+    CPPUNIT_TEST(benchHighLevelRoutes);
+    CPPUNIT_TEST(benchLowLevelRoutes);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    // Set up function for each test.
+    void setUp();
+
+    // Clean up after each test.
+    void tearDown();
+
+    // The tests.
+    void benchHighLevelRoutes();
+    void benchLowLevelRoutes();
+};
@@ -391,6 +391,53 @@ void FlightplanTests::testRoutePathVec()
     //CPPUNIT_ASSERT(vec.front()
 }
 
+void FlightplanTests::testRoutePathIncremental()
+{
+    FlightPlanRef fp1 = makeTestFP("EGHI"s, "20"s, "EDDM"s, "08L"s,
+                                   "SFD LYD BNE CIV ELLX LUX SAA KRH WLD"s);
+
+    auto checkMatchesFreshPath = [fp1]() {
+        const RoutePath& cached = fp1->routePath();
+        RoutePath fresh(fp1);
+        for (int leg = 0; leg < fp1->numLegs(); ++leg) {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(fresh.trackForIndex(leg), cached.trackForIndex(leg), 1e-6);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(fresh.distanceForIndex(leg), cached.distanceForIndex(leg), 1e-3);
+        }
+
+        const int last = fp1->numLegs() - 1;
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(fresh.distanceBetweenIndices(0, last),
+                                     cached.distanceBetweenIndices(0, last), 1e-3);
+
+        for (double offsetM : {-250000.0, -1000.0, 0.0, 5000.0, 400000.0}) {
+            const SGGeod a = fresh.positionForDistanceFrom(4, offsetM);
+            const SGGeod b = cached.positionForDistanceFrom(4, offsetM);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, SGGeodesy::distanceM(a, b), 1.0);
+        }
+    };
+
+    checkMatchesFreshPath();
+
+    // change the middle of the route, so the prefix is re-used
+    FGAirportRef eddf = FGAirport::findByIdent("EDDF"s);
+    WayptRef ffm = fp1->waypointFromString("FFM"s, eddf->geod());
+    CPPUNIT_ASSERT(ffm);
+    fp1->insertWayptAtIndex(ffm, 6);
+    checkMatchesFreshPath();
+
+    fp1->deleteIndex(3);
+    checkMatchesFreshPath();
+
+    fp1->legAtIndex(5)->setHoldCount(2);
+    checkMatchesFreshPath();
+
+    fp1->deleteIndex(-1);
+    checkMatchesFreshPath();
+
+    // the cached path agrees with the per-leg data rebuilt on change
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(fp1->routePath().distanceForIndex(3) * SG_METER_TO_NM,
+                                 fp1->legAtIndex(3)->distanceNm(), 1e-6);
+}
+
 void FlightplanTests::testRoutePathFinalLegVQPR15()
 {
     // test behaviour of RoutePath when the last leg prior to the arrival runway
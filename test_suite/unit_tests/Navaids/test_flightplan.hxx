@@ -37,6 +37,7 @@ class FlightplanTests : public CppUnit::TestFixture
     CPPUNIT_TEST(testBug1814);
     CPPUNIT_TEST(testRoutPathWpt0Midflight);
     CPPUNIT_TEST(testRoutePathVec);
+    CPPUNIT_TEST(testRoutePathIncremental);
     CPPUNIT_TEST(testRoutePathFinalLegVQPR15);
     CPPUNIT_TEST(testLoadSaveMachRestriction);
     CPPUNIT_TEST(testOnlyDiscontinuityRoute);
@@ -81,6 +82,7 @@ public:
     void testBug1814();
     void testRoutPathWpt0Midflight();
     void testRoutePathVec();
+    void testRoutePathIncremental();
     void testRoutePathFinalLegVQPR15();
     void testLoadSaveMachRestriction();
     void testBasicDiscontinuity();
@@ -1,14 +1,21 @@
 #include "test_navaids2.hxx"
 
+#include <algorithm>
+
 #include "test_suite/FGTestApi/testGlobals.hxx"
 #include "test_suite/FGTestApi/NavDataCache.hxx"
 
 #include <Airports/airport.hxx>
+#include <Environment/metarairportfilter.hxx>
+#include <Environment/metarstationindex.hxx>
 
 #include <Navaids/NavDataCache.hxx>
+#include <Navaids/PositionedSnapshot.hxx>
 #include <Navaids/navrecord.hxx>
 #include <Navaids/navlist.hxx>
 
+#include <Main/fg_props.hxx>
+
 
 // Set up function for each test.
 void NavaidsTests::setUp()
@@ -146,3 +153,143 @@ void NavaidsTests::testTemporaryWaypoint()
     closest = FGPositioned::findClosestN(vhhh->geod(), 1, 50.0, &filt);
     CPPUNIT_ASSERT_EQUAL(closest.size(), static_cast<size_t>(0));
 }
+
+void NavaidsTests::testMetarStationIndex()
+{
+    using namespace Environment;
+    auto index = MetarStationIndex::instance();
+
+    for (auto ident : {"EGPH", "KORD", "YSSY", "NZCH", "FAOR"}) {
+        const SGGeod pos = FGAirport::findByIdent(ident)->geod();
+        FGAirportRef expected = FGAirport::findClosest(pos, 10000.0, MetarAirportFilter::instance());
+        CPPUNIT_ASSERT(expected);
+        CPPUNIT_ASSERT_EQUAL(expected->ident(), index->findClosest(pos, 10000.0)->ident());
+    }
+
+    // the middle of the Pacific, far from any station
+    const SGGeod pacific = SGGeod::fromDeg(-140.0, 0.0);
+    CPPUNIT_ASSERT(!index->findClosest(pacific, 10.0));
+
+    // track a flight from Edinburgh to Heathrow, the answer must always
+    // be the same as a fresh search
+    NearestMetarStation tracker;
+    const SGGeod from = FGAirport::findByIdent("EGPH")->geod();
+    const SGGeod to = FGAirport::findByIdent("EGLL")->geod();
+    for (int i = 0; i <= 200; ++i) {
+        const double f = i / 200.0;
+        const SGGeod pos = SGGeod::fromDeg(from.getLongitudeDeg() * (1.0 - f) + to.getLongitudeDeg() * f,
+                                           from.getLatitudeDeg() * (1.0 - f) + to.getLatitudeDeg() * f);
+        FGAirportRef expected = FGAirport::findClosest(pos, 10000.0, MetarAirportFilter::instance());
+        CPPUNIT_ASSERT_EQUAL(expected->ident(), tracker.find(pos, 10000.0)->ident());
+    }
+
+    // the stations around Heathrow, closest first
+    const SGGeod egll = FGAirport::findByIdent("EGLL")->geod();
+    FGPositionedList expectedN = FGPositioned::findClosestN(egll, 6, 100.0, MetarAirportFilter::instance());
+    auto nearest = index->findNearest(SGVec3d::fromGeod(egll), 6, 100.0 * SG_NM_TO_METER);
+    CPPUNIT_ASSERT_EQUAL(expectedN.size(), nearest.size());
+    for (size_t i = 0; i < nearest.size(); ++i) {
+        CPPUNIT_ASSERT_EQUAL(expectedN[i]->guid(), nearest[i].first);
+    }
+    CPPUNIT_ASSERT(index->findNearest(SGVec3d::fromGeod(pacific), 3, 10.0 * SG_NM_TO_METER).empty());
+}
+
+namespace {
+
+// guids of a range query and of a nearest query, with or without the snapshot
+std::vector<PositionedID> spatialQuery(const SGGeod& pos, bool useSnapshot)
+{
+    fgSetBool("/sim/navdb/spatial-snapshot", useSnapshot);
+    CPPUNIT_ASSERT_EQUAL(useSnapshot, flightgear::NavDataCache::instance()->spatialSnapshot() != nullptr);
+
+    std::vector<PositionedID> result;
+    auto inRange = FGPositioned::findWithinRange(pos, 30.0, nullptr);
+    for (const auto& p : inRange) {
+        result.push_back(p->guid());
+    }
+    std::sort(result.begin(), result.end());
+
+    // the nearest ones keep their order
+    FGPositioned::TypeFilter filter({FGPositioned::VOR, FGPositioned::FIX, FGPositioned::WAYPOINT});
+    for (const auto& p : FGPositioned::findClosestN(pos, 20, 80.0, &filter)) {
+        result.push_back(p->guid());
+    }
+
+    fgSetBool("/sim/navdb/spatial-snapshot", true);
+    return result;
+}
+
+} // namespace
+
+void NavaidsTests::testSpatialSnapshotMatchesOctree()
+{
+    auto cache = flightgear::NavDataCache::instance();
+    auto snapshot = cache->spatialSnapshot();
+    CPPUNIT_ASSERT(snapshot);
+    const size_t snapshotSize = snapshot->size();
+
+    // away from the insert below, the octree does not update loaded leaves
+    SGGeod lfpgPos = SGGeod::fromDeg(2.55, 49.01);
+    const auto before = spatialQuery(lfpgPos, true);
+    CPPUNIT_ASSERT(!before.empty());
+    CPPUNIT_ASSERT(before == spatialQuery(lfpgPos, false));
+
+    // create a transaction, which we don't commit, to avoid making permanent DB changes
+    flightgear::NavDataCache::Transaction txn(cache);
+
+    SGGeod egccPos = SGGeod::fromDeg(-2.27, 53.35);
+    SGGeod offsetPos = SGGeodesy::direct(egccPos, 90.0, 3.0 * SG_NM_TO_METER);
+    auto poi = FGPositioned::createWaypoint(FGPositioned::WAYPOINT,
+                                            "TEST_WP_SNAP", offsetPos, false, "Snapshot Waypoint");
+    CPPUNIT_ASSERT(poi->guid() > snapshot->maxId());
+
+    // the new row is added to the snapshot instead of dropping it
+    CPPUNIT_ASSERT(cache->spatialSnapshot() == snapshot);
+    CPPUNIT_ASSERT_EQUAL(snapshotSize + 1, snapshot->size());
+
+    const auto after = spatialQuery(offsetPos, true);
+    CPPUNIT_ASSERT(after == spatialQuery(offsetPos, false));
+    CPPUNIT_ASSERT(std::count(after.begin(), after.end(), poi->guid()) == 2);
+
+    // moving or removing it only touches the additions
+    SGGeod movedPos = SGGeodesy::direct(egccPos, 270.0, 3.0 * SG_NM_TO_METER);
+    cache->updatePosition(poi->guid(), movedPos);
+    CPPUNIT_ASSERT(cache->spatialSnapshot() == snapshot);
+    const auto moved = spatialQuery(movedPos, true);
+    CPPUNIT_ASSERT(std::count(moved.begin(), moved.end(), poi->guid()) == 2);
+
+    FGPositioned::deleteWaypoint(poi);
+    CPPUNIT_ASSERT(cache->spatialSnapshot() == snapshot);
+    CPPUNIT_ASSERT_EQUAL(snapshotSize, snapshot->size());
+}
+
+void NavaidsTests::testSpatialSnapshotInvalidated()
+{
+    auto cache = flightgear::NavDataCache::instance();
+    const SGPath snapshotPath(cache->path().utf8Str() + ".spatial");
+    CPPUNIT_ASSERT(cache->spatialSnapshot());
+
+    SGGeod egccPos = SGGeod::fromDeg(-2.27, 53.35);
+    {
+        // create a transaction, which we don't commit, to avoid making permanent DB changes
+        flightgear::NavDataCache::Transaction txn(cache);
+
+        // moving an item stored in the snapshot drops it
+        FGNavRecordRef tnt = FGNavList::findByFreq(115.7, egccPos);
+        CPPUNIT_ASSERT(tnt);
+        cache->updatePosition(tnt->guid(), SGGeodesy::direct(tnt->geod(), 0.0, 100.0));
+
+        CPPUNIT_ASSERT(!cache->spatialSnapshot());
+        CPPUNIT_ASSERT(cache->readStringProperty("spatial-snapshot-stamp").empty());
+        CPPUNIT_ASSERT(!snapshotPath.exists());
+        CPPUNIT_ASSERT(!flightgear::PositionedSnapshot::open(snapshotPath, ""));
+    }
+
+    // it is written again when the cache is closed
+    flightgear::NavDataCache::shutdown();
+    FGTestApi::setUp::initNavDataCache();
+    cache = flightgear::NavDataCache::instance();
+    CPPUNIT_ASSERT(snapshotPath.exists());
+    CPPUNIT_ASSERT(cache->spatialSnapshot());
+    CPPUNIT_ASSERT(spatialQuery(egccPos, true) == spatialQuery(egccPos, false));
+}
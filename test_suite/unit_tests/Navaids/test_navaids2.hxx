@@ -31,6 +31,9 @@ class NavaidsTests : public CppUnit::TestFixture
     CPPUNIT_TEST(testBasic);
     CPPUNIT_TEST(testCustomWaypoint);
     CPPUNIT_TEST(testTemporaryWaypoint);
+    CPPUNIT_TEST(testMetarStationIndex);
+    CPPUNIT_TEST(testSpatialSnapshotMatchesOctree);
+    CPPUNIT_TEST(testSpatialSnapshotInvalidated);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -44,4 +47,7 @@ public:
     void testBasic();
     void testCustomWaypoint();
     void testTemporaryWaypoint();
+    void testMetarStationIndex();
+    void testSpatialSnapshotMatchesOctree();
+    void testSpatialSnapshotInvalidated();
 };
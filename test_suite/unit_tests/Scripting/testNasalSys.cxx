@@ -15,6 +15,7 @@
 #include <Airports/airport.hxx>
 
 #include <Scripting/NasalSys.hxx>
+#include <Scripting/NasalProfiler.hxx>
 
 #include <Main/FGInterpolator.hxx>
 
@@ -488,3 +489,143 @@ void NasalSysTests::testHashDeclarationError()
     CPPUNIT_ASSERT(perror.find("bad hash/object initializer") != std::string::npos);
     CPPUNIT_ASSERT(perror.find(", line 5") != std::string::npos);
 }
+
+void NasalSysTests::testListeners()
+{
+    auto nasalSys = globals->get_subsystem<FGNasalSys>();
+    fgSetInt("/test/listen/value", 1);
+    fgSetString("/test/listen/name", "a");
+
+    bool ok = FGTestApi::executeNasal(R"(
+        var count = func(p) { setprop(p, getprop(p) + 1); };
+        setprop('/test/listen/on-change', 0);
+        setprop('/test/listen/per-frame', 0);
+        setprop('/test/listen/string', 0);
+        _setlistener('/test/listen/value', func { count('/test/listen/on-change'); }, 0, 0);
+        _setlistener('/test/listen/value', func { count('/test/listen/per-frame'); }, 0, 3);
+        _setlistener('/test/listen/name', func { count('/test/listen/string'); }, 0, 0);
+    )");
+    CPPUNIT_ASSERT(ok);
+
+    // unchanged values are not reported
+    fgSetInt("/test/listen/value", 1);
+    fgSetString("/test/listen/name", "a");
+    CPPUNIT_ASSERT_EQUAL(0, fgGetInt("/test/listen/on-change"));
+    CPPUNIT_ASSERT_EQUAL(0, fgGetInt("/test/listen/string"));
+
+    fgSetInt("/test/listen/value", 2);
+    fgSetInt("/test/listen/value", 3);
+    fgSetString("/test/listen/name", "b");
+    fgSetString("/test/listen/name", "b");
+    CPPUNIT_ASSERT_EQUAL(2, fgGetInt("/test/listen/on-change"));
+    CPPUNIT_ASSERT_EQUAL(1, fgGetInt("/test/listen/string"));
+
+    // per-frame listeners are called once, from update()
+    CPPUNIT_ASSERT_EQUAL(0, fgGetInt("/test/listen/per-frame"));
+    nasalSys->update(0.1);
+    CPPUNIT_ASSERT_EQUAL(1, fgGetInt("/test/listen/per-frame"));
+
+    // and not at all if the frame ends with the value they saw last
+    fgSetInt("/test/listen/value", 4);
+    fgSetInt("/test/listen/value", 3);
+    nasalSys->update(0.1);
+    CPPUNIT_ASSERT_EQUAL(1, fgGetInt("/test/listen/per-frame"));
+    CPPUNIT_ASSERT_EQUAL(4, fgGetInt("/test/listen/on-change"));
+
+    // profiling lists the listeners that were called
+    fgSetBool("/sim/nasal-listener-profile/enabled", true);
+    nasalSys->update(0.0);
+    fgSetInt("/test/listen/value", 5);
+    nasalSys->update(1.0);
+    SGPropertyNode_ptr profile = fgGetNode("/sim/nasal-listener-profile");
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), profile->getChildren("listener").size());
+    CPPUNIT_ASSERT_EQUAL(std::string("/test/listen/value"),
+                         profile->getStringValue("listener[0]/property"));
+    CPPUNIT_ASSERT_EQUAL(1, profile->getIntValue("listener[0]/calls"));
+    fgSetBool("/sim/nasal-listener-profile/enabled", false);
+
+    // a per-frame listener which queues another one for the next frame,
+    // then removes it
+    ok = FGTestApi::executeNasal(R"(
+        var count = func(p) { setprop(p, getprop(p) + 1); };
+        setprop('/test/listen/first', 0);
+        setprop('/test/listen/second', 0);
+        setprop('/test/listen/second-calls', 0);
+        var second = _setlistener('/test/listen/second', func { count('/test/listen/second-calls'); }, 0, 3);
+        _setlistener('/test/listen/first', func {
+            if (second == nil) return;
+            count('/test/listen/second');
+            removelistener(second);
+            second = nil;
+        }, 0, 3);
+    )");
+    CPPUNIT_ASSERT(ok);
+
+    fgSetInt("/test/listen/first", 1);
+    nasalSys->update(0.1);
+    CPPUNIT_ASSERT_EQUAL(1, fgGetInt("/test/listen/second"));
+
+    // the removed listener is still queued here, and must be neither
+    // called nor freed before it is taken off the queue
+    nasalSys->update(0.1);
+    nasalSys->update(0.1);
+    CPPUNIT_ASSERT_EQUAL(0, fgGetInt("/test/listen/second-calls"));
+}
+
+void NasalSysTests::testProfiler()
+{
+    auto nasalSys = globals->get_subsystem<FGNasalSys>();
+    bool ok = FGTestApi::executeNasal(R"(
+        setprop('/test/profile/value', 0);
+        _setlistener('/test/profile/value', func { var x = 0; for (var i = 0; i < 1000; i += 1) x += i; }, 0, 0);
+        addcommand('profile-foo', func { setprop('/test/profile/value', getprop('/test/profile/value') + 1); });
+    )");
+    CPPUNIT_ASSERT(ok);
+
+    // nothing is recorded until profiling is started
+    SGPropertyNode_ptr args(new SGPropertyNode);
+    CPPUNIT_ASSERT(globals->get_commands()->execute("profile-foo", args));
+    CPPUNIT_ASSERT(nasalSys->profiler().folded().empty());
+
+    CPPUNIT_ASSERT(globals->get_commands()->execute("nasal-profile-start", args));
+    CPPUNIT_ASSERT(globals->get_commands()->execute("profile-foo", args));
+    nasalSys->update(0.1);
+    CPPUNIT_ASSERT(globals->get_commands()->execute("nasal-profile-stop", args));
+    CPPUNIT_ASSERT(globals->get_commands()->execute("profile-foo", args));
+
+    // the listener was called from within the command
+    const std::string folded = nasalSys->profiler().folded();
+    CPPUNIT_ASSERT(folded.find("command profile-foo;listener") != std::string::npos);
+    CPPUNIT_ASSERT_EQUAL(1, fgGetInt("/sim/nasal-profile/frames"));
+    CPPUNIT_ASSERT(fgGetDouble("/sim/nasal-profile/frame-ms") > 0.0);
+
+    CPPUNIT_ASSERT(FGTestApi::executeNasal("removecommand('profile-foo');"));
+}
+
+void NasalSysTests::testBulkProps()
+{
+    fgSetDouble("/test/bulk/a", 1.5);
+    fgSetString("/test/bulk/b", "apples");
+    fgSetInt("/test/bulk/c[2]/d", 7);
+
+    bool ok = FGTestApi::executeNasal(R"(
+        var root = props._getNode(props._globals(), ['/test/bulk']);
+
+        var values = props._getValues(root, [['a', 'b', 'c[2]/d', 'missing']]);
+        unitTest.assert_equal(values, [1.5, 'apples', 7, nil]);
+
+        var handles = props._getHandles(root, [['a', 'b', 'e', 'missing']]);
+        unitTest.assert_equal(props._getHandleValues(handles), [1.5, 'apples', nil, nil]);
+
+        # nil leaves a node unchanged, nodes that did not exist are skipped
+        unitTest.assert_equal(props._setHandleValues(handles, [2.5, nil, 1, 1]), 1);
+        unitTest.assert_equal(props._getHandleValues(handles), [2.5, 'apples', nil, nil]);
+
+        handles = props._getHandles(root, [['a', 'e'], 1]);
+        unitTest.assert_equal(props._setHandleValues(handles, [3.5, 'pears']), 2);
+    )");
+    CPPUNIT_ASSERT(ok);
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.5, fgGetDouble("/test/bulk/a"), 1e-9);
+    CPPUNIT_ASSERT_EQUAL(std::string("pears"), fgGetString("/test/bulk/e"));
+}
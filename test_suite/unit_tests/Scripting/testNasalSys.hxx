@@ -27,6 +27,9 @@ class NasalSysTests : public CppUnit::TestFixture
     CPPUNIT_TEST(testNullishChain);
     CPPUNIT_TEST(testFindComm);
     CPPUNIT_TEST(testHashDeclarationError);
+    CPPUNIT_TEST(testListeners);
+    CPPUNIT_TEST(testProfiler);
+    CPPUNIT_TEST(testBulkProps);
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -54,4 +57,7 @@ public:
     void testNullishChain();
     void testFindComm();
     void testHashDeclarationError();
+    void testListeners();
+    void testProfiler();
+    void testBulkProps();
 };
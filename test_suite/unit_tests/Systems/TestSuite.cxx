@@ -0,0 +1,9 @@
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "benchmarkElectrical.hxx"
+#include "test_electrical.hxx"
+
+// Set up the unit tests.
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(BenchmarkElectrical, "Unit tests");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ElectricalTests, "Unit tests");
@@ -0,0 +1,166 @@
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "config.h"
+
+#include "benchmarkElectrical.hxx"
+
+#include <memory>
+#include <string>
+
+#include "test_suite/FGTestApi/testGlobals.hxx"
+
+#include <simgear/props/props_io.hxx>
+#include <simgear/timing/timestamp.hxx>
+
+#include <Main/fg_props.hxx>
+#include <Main/globals.hxx>
+#include <Systems/electrical.hxx>
+
+using namespace std::string_literals;
+
+namespace {
+
+SGPropertyNode* addComponent(SGPropertyNode* config, const std::string& type,
+                             const std::string& name)
+{
+    auto n = config->addChild(type);
+    n->setStringValue("name", name);
+    n->addChild("prop")->setStringValue("/systems/electrical/bench/" + name);
+    return n;
+}
+
+void addConnector(SGPropertyNode* config, const std::string& from,
+                  const std::string& to, const std::string& switchProp)
+{
+    auto n = config->addChild("connector");
+    n->addChild("input")->setStringValue(from);
+    n->addChild("output")->setStringValue(to);
+    if (!switchProp.empty()) {
+        n->addChild("switch")->setStringValue("prop", switchProp);
+    }
+}
+
+// An airliner-like network: a battery, two alternators and a ground power
+// supplier feeding a tree of buses with many outputs, cross-ties between
+// the buses and a charge connector back to the battery.
+std::unique_ptr<FGElectricalSystem> createNetwork(int numBuses, int outputsPerBus)
+{
+    SGPropertyNode_ptr config = new SGPropertyNode;
+
+    auto bat = addComponent(config, "supplier", "battery");
+    bat->setStringValue("kind", "battery");
+    bat->setDoubleValue("volts", 24.0);
+    for (int e = 0; e < 2; ++e) {
+        auto alt = addComponent(config, "supplier", "alternator" + std::to_string(e));
+        alt->setStringValue("kind", "alternator");
+        alt->setDoubleValue("volts", 28.0);
+        alt->setStringValue("rpm-source", "/engines/engine[" + std::to_string(e) + "]/rpm");
+    }
+    auto ext = addComponent(config, "supplier", "external");
+    ext->setStringValue("kind", "external");
+    ext->setDoubleValue("volts", 28.0);
+
+    addComponent(config, "bus", "main-bus");
+    for (int b = 0; b < numBuses; ++b) {
+        const auto bus = "bus" + std::to_string(b);
+        addComponent(config, "bus", bus);
+        for (int o = 0; o < outputsPerBus; ++o) {
+            auto out = addComponent(config, "output", bus + "-output" + std::to_string(o));
+            out->setDoubleValue("rated-draw", 0.5 + (o % 4));
+        }
+    }
+
+    addConnector(config, "battery", "main-bus", "/controls/electric/battery-switch");
+    addConnector(config, "alternator0", "main-bus", "/controls/electric/engine[0]/generator");
+    addConnector(config, "alternator1", "main-bus", "/controls/electric/engine[1]/generator");
+    addConnector(config, "external", "main-bus", "/controls/electric/external-power");
+    addConnector(config, "main-bus", "battery", "");
+    for (int b = 0; b < numBuses; ++b) {
+        const auto bus = "bus" + std::to_string(b);
+        // each bus hangs off the main bus or the one before it
+        addConnector(config, (b % 3) ? "bus" + std::to_string(b - 1) : "main-bus"s, bus,
+                     "/controls/electric/bus-tie[" + std::to_string(b) + "]");
+        for (int o = 0; o < outputsPerBus; ++o) {
+            const auto out = bus + "-output" + std::to_string(o);
+            addConnector(config, bus, out, "/controls/circuit-breakers/" + out);
+        }
+    }
+
+    const SGPath path = globals->get_fg_home() / "electrical-bench.xml";
+    writeProperties(path, config);
+    fgSetString("/sim/systems/electrical/path", path.utf8Str());
+
+    SGPropertyNode_ptr node = new SGPropertyNode;
+    std::unique_ptr<FGElectricalSystem> es(new FGElectricalSystem(node));
+    es->bind();
+    es->init();
+    return es;
+}
+
+} // namespace
+
+// Set up function for each test.
+void BenchmarkElectrical::setUp()
+{
+    FGTestApi::setUp::initTestGlobals("BenchmarkElectrical"s);
+    fgSetBool("/systems/electrical/serviceable", true);
+}
+
+
+// Clean up after each test.
+void BenchmarkElectrical::tearDown()
+{
+    FGTestApi::tearDown::shutdownTestGlobals();
+}
+
+
+void BenchmarkElectrical::testPropagation()
+{
+    auto es = createNetwork(6, 4);
+    CPPUNIT_ASSERT(es->find("bus5-output3"));
+    CPPUNIT_ASSERT(!es->find("no-such-component"));
+
+    fgSetDouble("/engines/engine[0]/rpm", 2000.0);
+    es->update(0.1);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(28.0, fgGetDouble("/systems/electrical/bench/main-bus"), 1e-6);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(28.0, fgGetDouble("/systems/electrical/bench/bus5-output3"), 1e-6);
+    // rated draw of 3.5 A
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.5, es->find("bus5-output3")->get_load_amps(), 1e-6);
+
+    // opening a breaker keeps the output's property at its last value, as
+    // before, but no current is drawn through the bus any more
+    const float busLoad = es->find("bus5")->get_load_amps();
+    fgSetBool("/controls/circuit-breakers/bus5-output3", false);
+    es->update(0.1);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(busLoad - 3.5, es->find("bus5")->get_load_amps(), 1e-5);
+
+    es->shutdown();
+    es->unbind();
+}
+
+
+void BenchmarkElectrical::benchLargeNetwork()
+{
+    auto es = createNetwork(60, 12);
+    fgSetDouble("/engines/engine[0]/rpm", 2000.0);
+    fgSetDouble("/engines/engine[1]/rpm", 2000.0);
+
+    const int iterations = 2000;
+    SGTimeStamp st;
+    st.stamp();
+    for (int i = 0; i < iterations; ++i) {
+        // toggle a bus tie now and then, so that part of the network
+        // changes state
+        if ((i % 100) == 0) {
+            fgSetBool("/controls/electric/bus-tie[7]", (i / 100) % 2);
+        }
+        es->update(1.0 / 120.0);
+    }
+
+    SG_LOG(SG_SYSTEMS, SG_INFO, "electrical network of 60 buses, 720 outputs: "
+                                    << (st.elapsedUSec() / iterations) << "usec per update");
+
+    es->shutdown();
+    es->unbind();
+}
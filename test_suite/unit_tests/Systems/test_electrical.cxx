@@ -0,0 +1,347 @@
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "config.h"
+
+#include "test_electrical.hxx"
+
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "test_suite/FGTestApi/testGlobals.hxx"
+
+#include <simgear/props/props_io.hxx>
+
+#include <Main/fg_props.hxx>
+#include <Main/globals.hxx>
+#include <Systems/electrical.hxx>
+
+using namespace std::string_literals;
+
+namespace {
+
+const std::string ROOT = "/systems/electrical/random/";
+
+// value of the component properties which were not published
+const float NOT_PUBLISHED = -1.0f;
+
+/**
+ * The recursive solver of FGElectricalSystem before the network was
+ * compiled into index arrays, run on the components of a second system
+ * built from the same configuration. It records the voltages it would
+ * publish instead of writing them to the properties.
+ */
+class ReferenceSolver
+{
+public:
+    ReferenceSolver(FGElectricalSystem& es, const std::vector<std::string>& names)
+    {
+        for (const auto& name : names) {
+            FGElectricalComponent* c = es.find(name);
+            if (c->get_kind() == FGElectricalComponent::FG_SUPPLIER) {
+                _suppliers.push_back(static_cast<FGElectricalSupplier*>(c));
+            }
+            addReachable(c);
+        }
+    }
+
+    void update(double dt)
+    {
+        _serviceable = fgGetBool("/systems/electrical/serviceable");
+        published.clear();
+
+        for (auto c : _components) {
+            c->set_volts(0.0);
+        }
+
+        for (auto model : {FGElectricalSupplier::FG_EXTERNAL,
+                           FGElectricalSupplier::FG_ALTERNATOR,
+                           FGElectricalSupplier::FG_BATTERY}) {
+            for (auto s : _suppliers) {
+                if (s->get_model() == model) {
+                    const float load = propagate(s, dt, s->get_output_volts(),
+                                                 s->get_output_amps());
+                    s->apply_load(load, dt);
+                }
+            }
+        }
+    }
+
+    // the voltage last published by each component during update()
+    std::map<const FGElectricalComponent*, float> published;
+
+private:
+    void addReachable(FGElectricalComponent* c)
+    {
+        if (!_components.insert(c).second) {
+            return;
+        }
+        for (int i = 0; i < c->get_num_outputs(); ++i) {
+            addReachable(c->get_output(i));
+        }
+    }
+
+    float propagate(FGElectricalComponent* node, double dt,
+                    float input_volts, float input_amps)
+    {
+        float total_load = 0.0;
+
+        float volts = 0.0;
+        if (!_serviceable) {
+            volts = 0;
+        } else if (node->get_kind() == FGElectricalComponent::FG_SUPPLIER) {
+            auto supplier = static_cast<FGElectricalSupplier*>(node);
+            if (supplier->get_model() == FGElectricalSupplier::FG_BATTERY) {
+                float battery_volts = supplier->get_output_volts();
+                if (battery_volts < (input_volts - 0.1)) {
+                    supplier->apply_load(-supplier->get_charge_amps(), dt);
+                    return supplier->get_charge_amps();
+                }
+            }
+            volts = input_volts;
+        } else if (node->get_kind() == FGElectricalComponent::FG_BUS) {
+            volts = input_volts;
+        } else if (node->get_kind() == FGElectricalComponent::FG_OUTPUT) {
+            volts = input_volts;
+            if (volts > 1.0) {
+                total_load = node->get_load_amps();
+            }
+        } else if (node->get_kind() == FGElectricalComponent::FG_CONNECTOR) {
+            if (static_cast<FGElectricalConnector*>(node)->get_state()) {
+                volts = input_volts;
+            } else {
+                volts = 0.0;
+            }
+        }
+
+        if (!(volts > node->get_volts())) {
+            return 0.0;
+        }
+
+        node->set_volts(volts);
+        for (int i = 0; i < node->get_num_outputs(); ++i) {
+            FGElectricalComponent* child = node->get_output(i);
+            total_load += propagate(child, dt, volts, child->get_load_amps());
+        }
+
+        if (node->get_kind() != FGElectricalComponent::FG_OUTPUT) {
+            node->set_load_amps(total_load);
+        }
+        node->set_available_amps(input_amps - total_load);
+        published[node] = volts;
+        return total_load;
+    }
+
+    std::vector<FGElectricalSupplier*> _suppliers;
+    std::set<FGElectricalComponent*> _components;
+    bool _serviceable = true;
+};
+
+// A random network of suppliers, buses and outputs, with switched cross
+// ties between the buses and charge connectors back to the batteries.
+class RandomNetwork
+{
+public:
+    explicit RandomNetwork(std::mt19937& rng) : _rng(rng)
+    {
+        _config = new SGPropertyNode;
+
+        const int batteries = uniform(1, 2);
+        for (int i = 0; i < batteries; ++i) {
+            auto n = addComponent("supplier", "battery" + std::to_string(i));
+            n->setStringValue("kind", "battery");
+            n->setDoubleValue("volts", uniform(0, 1) ? 24.0 : 28.0);
+            n->setDoubleValue("amp-hours", uniform(10, 40));
+            n->setDoubleValue("percent-remaining", uniform(20, 100) / 100.0);
+        }
+        const int alternators = uniform(0, 2);
+        for (int i = 0; i < alternators; ++i) {
+            auto n = addComponent("supplier", "alternator" + std::to_string(i));
+            n->setStringValue("kind", "alternator");
+            n->setDoubleValue("volts", 28.0);
+            n->setStringValue("rpm-source", ROOT + "rpm[" + std::to_string(i) + "]");
+        }
+        if (uniform(0, 1)) {
+            auto n = addComponent("supplier", "external");
+            n->setStringValue("kind", "external");
+            n->setDoubleValue("volts", 28.0);
+        }
+        const std::vector<std::string> suppliers = names;
+
+        const int numBuses = uniform(1, 8);
+        std::vector<std::string> buses;
+        for (int b = 0; b < numBuses; ++b) {
+            buses.push_back("bus" + std::to_string(b));
+            addComponent("bus", buses.back());
+        }
+
+        for (const auto& s : suppliers) {
+            addConnector(s, pick(buses));
+        }
+        for (int b = 1; b < numBuses; ++b) {
+            addConnector(buses[uniform(0, b - 1)], buses[b]);
+        }
+        // cross ties, which may close loops between the buses
+        for (int i = 0; i < numBuses / 2; ++i) {
+            addConnector(pick(buses), pick(buses));
+        }
+        for (const auto& s : suppliers) {
+            if (s.compare(0, 7, "battery") == 0) {
+                addConnector(pick(buses), s);
+            }
+        }
+
+        for (const auto& bus : buses) {
+            const int outputs = uniform(0, 4);
+            for (int o = 0; o < outputs; ++o) {
+                const auto name = bus + "-output" + std::to_string(o);
+                auto n = addComponent("output", name);
+                n->setDoubleValue("rated-draw", uniform(1, 40) / 4.0);
+                addConnector(bus, name);
+            }
+        }
+    }
+
+    std::unique_ptr<FGElectricalSystem> createSystem() const
+    {
+        const SGPath path = globals->get_fg_home() / "electrical-random.xml";
+        writeProperties(path, _config);
+        fgSetString("/sim/systems/electrical/path", path.utf8Str());
+
+        SGPropertyNode_ptr node = new SGPropertyNode;
+        std::unique_ptr<FGElectricalSystem> es(new FGElectricalSystem(node));
+        es->bind();
+        es->init();
+        return es;
+    }
+
+    // flip the switches, and change the engine speeds
+    void randomizeInputs()
+    {
+        for (int i = 0; i < _switches; ++i) {
+            fgSetBool(switchProp(i), uniform(0, 9) < 7);
+        }
+        for (int e = 0; e < 2; ++e) {
+            fgSetDouble(ROOT + "rpm[" + std::to_string(e) + "]", uniform(0, 1200));
+        }
+        fgSetBool("/systems/electrical/serviceable", uniform(0, 19) > 0);
+    }
+
+    static std::string prop(const std::string& name) { return ROOT + name; }
+
+    std::vector<std::string> names;
+
+private:
+    int uniform(int lo, int hi)
+    {
+        return std::uniform_int_distribution<int>(lo, hi)(_rng);
+    }
+
+    const std::string& pick(const std::vector<std::string>& v)
+    {
+        return v[uniform(0, static_cast<int>(v.size()) - 1)];
+    }
+
+    static std::string switchProp(int i)
+    {
+        return ROOT + "switch[" + std::to_string(i) + "]";
+    }
+
+    SGPropertyNode* addComponent(const std::string& type, const std::string& name)
+    {
+        auto n = _config->addChild(type);
+        n->setStringValue("name", name);
+        n->addChild("prop")->setStringValue(prop(name));
+        names.push_back(name);
+        return n;
+    }
+
+    // most connectors are switched
+    void addConnector(const std::string& from, const std::string& to)
+    {
+        auto n = _config->addChild("connector");
+        n->addChild("input")->setStringValue(from);
+        n->addChild("output")->setStringValue(to);
+        if (uniform(0, 4) > 0) {
+            n->addChild("switch")->setStringValue("prop", switchProp(_switches++));
+        }
+    }
+
+    std::mt19937& _rng;
+    SGPropertyNode_ptr _config;
+    int _switches = 0;
+};
+
+} // namespace
+
+// Set up function for each test.
+void ElectricalTests::setUp()
+{
+    FGTestApi::setUp::initTestGlobals("Electrical"s);
+    fgSetBool("/systems/electrical/serviceable", true);
+}
+
+
+// Clean up after each test.
+void ElectricalTests::tearDown()
+{
+    FGTestApi::tearDown::shutdownTestGlobals();
+}
+
+
+// The compiled solver publishes the same voltages, loads and battery
+// charges as the recursive one it replaced, on random networks.
+void ElectricalTests::testRandomNetworks()
+{
+    std::mt19937 rng(20261018);
+    for (int network = 0; network < 50; ++network) {
+        RandomNetwork net(rng);
+        auto es = net.createSystem();
+        auto reference = net.createSystem();
+        ReferenceSolver solver(*reference, net.names);
+
+        for (int step = 0; step < 20; ++step) {
+            net.randomizeInputs();
+            for (const auto& name : net.names) {
+                fgSetFloat(RandomNetwork::prop(name), NOT_PUBLISHED);
+            }
+
+            es->update(1.0);
+            solver.update(1.0);
+
+            for (const auto& name : net.names) {
+                FGElectricalComponent* a = es->find(name);
+                FGElectricalComponent* b = reference->find(name);
+                const std::string where = "network " + std::to_string(network) +
+                                          ", step " + std::to_string(step) + ", " + name;
+                CPPUNIT_ASSERT_EQUAL_MESSAGE(where, b->get_volts(), a->get_volts());
+                CPPUNIT_ASSERT_EQUAL_MESSAGE(where, b->get_load_amps(), a->get_load_amps());
+                CPPUNIT_ASSERT_EQUAL_MESSAGE(where, b->get_available_amps(),
+                                             a->get_available_amps());
+
+                // every component reached is published, changed or not
+                const auto it = solver.published.find(b);
+                const float expected = (it == solver.published.end()) ? NOT_PUBLISHED : it->second;
+                CPPUNIT_ASSERT_EQUAL_MESSAGE(where, expected,
+                                             fgGetFloat(RandomNetwork::prop(name)));
+
+                if (a->get_kind() == FGElectricalComponent::FG_SUPPLIER) {
+                    // the battery charge
+                    CPPUNIT_ASSERT_EQUAL_MESSAGE(
+                        where,
+                        static_cast<FGElectricalSupplier*>(b)->get_output_volts(),
+                        static_cast<FGElectricalSupplier*>(a)->get_output_volts());
+                }
+            }
+        }
+
+        es->shutdown();
+        es->unbind();
+        reference->shutdown();
+        reference->unbind();
+    }
+}
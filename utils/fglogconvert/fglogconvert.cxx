@@ -0,0 +1,64 @@
+// fglogconvert.cxx - convert binary FGLogger output to CSV.
+//
+// SPDX-FileCopyrightText: 2026 FlightGear Developers
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <Main/loggerformat.hxx>
+
+using flightgear::logformat::convertToCsv;
+
+namespace {
+
+void usage()
+{
+    std::cerr << "Usage: fglogconvert [--delimiter=<char>] <binary log> [<csv file>]\n"
+              << "Converts a log written by the FlightGear logger with\n"
+              << "<format>binary</format> to CSV, on stdout if no csv file is given."
+              << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    char delimiter = ',';
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.compare(0, 12, "--delimiter=") == 0 && (arg.size() > 12)) {
+            delimiter = arg[12];
+        } else if ((arg == "--help") || (arg == "-h")) {
+            usage();
+            return 0;
+        } else {
+            files.push_back(arg);
+        }
+    }
+
+    if (files.empty() || (files.size() > 2)) {
+        usage();
+        return 1;
+    }
+
+    std::ifstream in(files[0], std::ios::in | std::ios::binary);
+    if (!in) {
+        std::cerr << "cannot read " << files[0] << std::endl;
+        return 1;
+    }
+
+    if (files.size() == 1) {
+        return convertToCsv(in, std::cout, delimiter);
+    }
+
+    std::ofstream out(files[1]);
+    if (!out) {
+        std::cerr << "cannot write " << files[1] << std::endl;
+        return 1;
+    }
+    return convertToCsv(in, out, delimiter);
+}